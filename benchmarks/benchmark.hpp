@@ -0,0 +1,244 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      A small benchmark harness shared by the programs in this directory.   *
+ *  Notes:                                                                    *
+ *      Each benchmark makes one pass over a fixed set of inputs, called a    *
+ *      run. A few warm-up runs are made first and thrown away, so the caches *
+ *      and branch predictors are in a steady state. The remaining runs are   *
+ *      timed separately, and the median, 10th, and 90th percentile time per  *
+ *      call are reported. The median is not thrown off by the odd run that an*
+ *      interrupt lands in, and the spread between the percentiles says how   *
+ *      much to trust it. No third-party library is needed.                   *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/23                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_BENCHMARK_HPP
+#define MITX_BENCHMARK_HPP
+
+/*  cstdio provides the "printf" function, used for printing text.            */
+#include <cstdio>
+
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  std::uint64_t, used by the random number generator, is found here.        */
+#include <cstdint>
+
+/*  std::exp and std::log, used for log-uniform inputs, are provided here.    */
+#include <cmath>
+
+/*  std::vector, used for the run times, is found here.                       */
+#include <vector>
+
+/*  std::sort, used for the percentiles, is provided here.                    */
+#include <algorithm>
+
+/*  Timing routines, used for timing the runs.                                */
+#include <chrono>
+
+/*  A linear congruential generator for the inputs. It is not a good source   *
+ *  of randomness, but it is fast, identical on every platform, and always    *
+ *  starts from the same seed, so every run of a benchmark sees the same      *
+ *  inputs and the numbers can be compared from one machine to the next.      */
+class Random {
+
+    /*  The current state of the generator.                                   */
+    std::uint64_t state;
+
+    /*  We want the functions visible outside the class. Declare them public. */
+    public:
+
+        /*  Starts the generator at the given seed.                           */
+        explicit Random(std::uint64_t seed = 1U) : state(seed)
+        {
+            return;
+        }
+
+        /*  Returns a number in [0, 1), using the top 53 bits of the state.   */
+        double uniform(void)
+        {
+            state = state * 6364136223846793005U + 1442695040888963407U;
+            return static_cast<double>(state >> 11) * 1.1102230246251565E-16;
+        }
+        /*  End of uniform.                                                   */
+
+        /*  Returns a number in [a, b), every value equally likely.           */
+        double uniform(double a, double b)
+        {
+            return a + (b - a) * uniform();
+        }
+        /*  End of uniform.                                                   */
+
+        /*  Returns a number in [a, b) for 0 < a < b, with every power of ten *
+         *  in the range equally likely. This is how the inputs of a square   *
+         *  root or a root finder are usually spread in practice. The range   *
+         *  is split in log space, so b / a may be larger than any double.    */
+        double log_uniform(double a, double b)
+        {
+            const double log_a = std::log(a);
+            return std::exp(log_a + (std::log(b) - log_a) * uniform());
+        }
+        /*  End of log_uniform.                                               */
+
+        /*  Returns 64 random bits, the top halves of two steps, since the    *
+         *  low bits of a linear congruential generator are not very random.  */
+        std::uint64_t bits(void)
+        {
+            state = state * 6364136223846793005U + 1442695040888963407U;
+            const std::uint64_t high = state >> 32;
+
+            state = state * 6364136223846793005U + 1442695040888963407U;
+            return (high << 32) | (state >> 32);
+        }
+        /*  End of bits.                                                      */
+
+        /*  Returns an integer in [a, b], every value equally likely.         */
+        int integer(int a, int b)
+        {
+            const double width = static_cast<double>(b - a) + 1.0;
+            return a + static_cast<int>(width * uniform());
+        }
+        /*  End of integer.                                                   */
+};
+/*  End of Random definition.                                                 */
+
+/*  Times passes over a set of inputs and prints one line per benchmark.      */
+class Benchmark {
+
+    /*  The number of calls made by one pass, and the number of passes.       */
+    std::size_t calls_per_run;
+    unsigned int warm_up_runs;
+    unsigned int timed_runs;
+
+    /*  The results of every pass are added here. The compiler can not prove  *
+     *  that a volatile variable is never read, so the work is never removed. */
+    volatile double sink;
+
+    /*  Returns the p-th percentile, 0 <= p <= 1, of sorted times, using      *
+     *  linear interpolation between the two nearest runs.                    */
+    static double percentile(const std::vector<double> &sorted, double p)
+    {
+        const double position = p * static_cast<double>(sorted.size() - 1);
+        const std::size_t below = static_cast<std::size_t>(position);
+        const double fraction = position - static_cast<double>(below);
+
+        if (below + 1 >= sorted.size())
+            return sorted[below];
+
+        return sorted[below] + fraction * (sorted[below + 1] - sorted[below]);
+    }
+    /*  End of percentile.                                                    */
+
+    /*  We want the functions visible outside the class. Declare them public. */
+    public:
+
+        /*  Creates a benchmark whose passes make the given number of calls,  *
+         *  and prints the title and the column headings.                     */
+        Benchmark(const char * const title,
+                  std::size_t calls,
+                  unsigned int runs = 31U,
+                  unsigned int warm_up = 3U)
+            : calls_per_run(calls),
+              warm_up_runs(warm_up),
+              timed_runs(runs),
+              sink(0.0)
+        {
+            std::printf("%s (ns/call, %lu calls per run, %u runs):\n",
+                        title,
+                        static_cast<unsigned long int>(calls_per_run),
+                        timed_runs);
+
+            std::printf("    %-32s %8s %8s %8s %10s %10s\n",
+                        "", "median", "p10", "p90", "evals", "Mcalls/s");
+        }
+
+        /*  Times pass, which makes calls_per_run calls and returns the sum   *
+         *  of the results, and prints the times per call in nanoseconds. If  *
+         *  evaluations is not NULL it points to a counter that the function  *
+         *  being solved adds to, and the evaluations per call are printed.   */
+        template <typename Pass>
+        void run(const char * const name,
+                 Pass pass,
+                 const unsigned long int * const evaluations = NULL)
+        {
+            std::vector<double> times(timed_runs);
+            unsigned long int evaluations_before = 0UL;
+            unsigned int n;
+            char evaluations_per_call[16];
+
+            for (n = 0U; n < warm_up_runs; ++n)
+                sink = sink + pass();
+
+            if (evaluations)
+                evaluations_before = *evaluations;
+
+            for (n = 0U; n < timed_runs; ++n)
+            {
+                const std::chrono::steady_clock::time_point start =
+                    std::chrono::steady_clock::now();
+
+                sink = sink + pass();
+
+                const std::chrono::steady_clock::time_point end =
+                    std::chrono::steady_clock::now();
+
+                times[n] =
+                    std::chrono::duration<double, std::nano>(end - start)
+                        .count() / static_cast<double>(calls_per_run);
+            }
+
+            std::sort(times.begin(), times.end());
+
+            /*  Calls that count nothing print a dash in this column.         */
+            if (evaluations)
+            {
+                const double total = static_cast<double>(
+                    *evaluations - evaluations_before
+                );
+
+                const double calls = static_cast<double>(calls_per_run) *
+                                     static_cast<double>(timed_runs);
+
+                std::snprintf(evaluations_per_call,
+                              sizeof(evaluations_per_call),
+                              "%.2f", total / calls);
+            }
+            else
+                std::snprintf(evaluations_per_call,
+                              sizeof(evaluations_per_call), "-");
+
+            std::printf("    %-32s %8.2f %8.2f %8.2f %10s %10.2f\n",
+                        name,
+                        percentile(times, 0.5),
+                        percentile(times, 0.1),
+                        percentile(times, 0.9),
+                        evaluations_per_call,
+                        1.0E+03 / percentile(times, 0.5));
+        }
+        /*  End of run.                                                       */
+};
+/*  End of Benchmark definition.                                              */
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,43 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Makes the C version of the bisection method callable from the         *
+ *      benchmark.                                                            *
+ *  Notes:                                                                    *
+ *      The example is included as is, with its main function renamed, so the *
+ *      benchmark times exactly the code in bisection_method.c, compiled as C.*
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/23                                                        *
+ ******************************************************************************/
+
+/*  Rename main so it does not clash with the main of the benchmark.          */
+#define main bisection_method_main
+#include "bisection_method.c"
+#undef main
+
+/*  The example's function is static. This gives the benchmark access to it.  */
+double bisection_method_baseline(function f, double a, double b);
+
+double bisection_method_baseline(function f, double a, double b)
+{
+    return bisection_method(f, a, b);
+}
+/*  End of bisection_method_baseline.                                         */
@@ -0,0 +1,133 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Benchmarks the bisection routines of bisection_method.cpp against the *
+ *      C version.                                                            *
+ *  Notes:                                                                    *
+ *      The routines are included from the header of the example, so this    *
+ *      times exactly the code that the example uses.                         *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/23                                                        *
+ ******************************************************************************/
+
+/*  The harness, and the random number generator for the inputs.              */
+#include "benchmark.hpp"
+
+/*  The routines being timed.                                                 */
+#include "bisection_method.hpp"
+
+/*  The C version, compiled as C in bisection_method_baseline.c.              */
+extern "C" double
+bisection_method_baseline(Bisection::pointer f, double a, double b);
+
+/*  The number of times the functions in main have been called.               */
+static unsigned long int evaluations = 0UL;
+
+/*  Times every routine on f over brackets [a, b] around the given root. The  *
+ *  two ends are up to 4 away from the root, on either side, at random. f is  *
+ *  a lambda without captures, which also converts to a function pointer.     */
+template <typename Function>
+static void compare(const char * const title, Function f, double root)
+{
+    const Bisection::pointer pointer = f;
+    const std::size_t n = 2048;
+    std::vector<double> a(n), b(n), out(n);
+    Random random;
+    std::size_t k;
+
+    for (k = 0; k < n; ++k)
+    {
+        a[k] = root - random.uniform(0.01, 4.0);
+        b[k] = root + random.uniform(0.01, 4.0);
+    }
+
+    Benchmark benchmark(title, n);
+
+    benchmark.run("bisection_method.c", [&](void) {
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k)
+            sum += bisection_method_baseline(pointer, a[k], b[k]);
+
+        return sum;
+    }, &evaluations);
+
+    benchmark.run("Bisection::root, pointer", [&](void) {
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k)
+            sum += Bisection::root(pointer, a[k], b[k]);
+
+        return sum;
+    }, &evaluations);
+
+    /*  A lambda may be inlined into the solver, a function pointer can not.  */
+    benchmark.run("Bisection::root, lambda", [&](void) {
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k)
+            sum += Bisection::root(f, a[k], b[k]);
+
+        return sum;
+    }, &evaluations);
+
+    benchmark.run("Bisection::root, batched", [&](void) {
+        double sum = 0.0;
+
+        Bisection::root(f, a.data(), b.data(), out.data(), n);
+
+        for (k = 0; k < n; ++k)
+            sum += out[k];
+
+        return sum;
+    }, &evaluations);
+}
+/*  End of compare.                                                           */
+
+/*  Times the root finders on a cheap and on a more expensive function. Both  *
+ *  count their calls, so the evaluations per root are printed as well.       */
+int main(void)
+{
+    /*  The root is the cube root of 2.                                       */
+    const auto cube_minus_two = [](double x) {
+        ++evaluations;
+        return x*x*x - 2.0;
+    };
+
+    /*  The root is the Dottie number, 0.739085...                            */
+    const auto cos_minus_x = [](double x) {
+        ++evaluations;
+        return std::cos(x) - x;
+    };
+
+    compare("x^3 - 2 on random brackets", cube_minus_two, 1.2599210498948732);
+    compare("cos(x) - x on random brackets", cos_minus_x, 0.7390851332151607);
+    return 0;
+}
+
+/*  This is built by the CMake project at the top of the repository. From     *
+ *  there, run:                                                               *
+ *      cmake -S . -B build                                                   *
+ *      cmake --build build --target bench                                    *
+ *  to run it together with the other benchmarks, or                          *
+ *  build/benchmarks/bisection_method_benchmark to run it alone. The timings  *
+ *  depend on the machine. Add -DMITX_NATIVE=ON to the first command to       *
+ *  enable the vector instructions used by the batched routines.              */
@@ -0,0 +1,224 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Benchmarks the complex powers of exponentiating_by_squaring.cpp       *
+ *      against the C89 and C99 versions and the standard library.            *
+ *  Notes:                                                                    *
+ *      The routines are included from the header of the example, so this    *
+ *      times exactly the code that the example uses.                         *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/23                                                        *
+ ******************************************************************************/
+
+/*  The harness, and the random number generator for the inputs.              */
+#include "benchmark.hpp"
+
+/*  The routines being timed.                                                 */
+#include "exponentiating_by_squaring.hpp"
+
+/*  The C versions, compiled as C in the two baseline files. The result is    *
+ *  written to out[0] and out[1], since C and C++ complex types differ.       */
+extern "C" void
+exp_by_squaring_c89(double real, double imag, int n, double *out);
+
+extern "C" void
+exp_by_squaring_c99(double real, double imag, int n, double *out);
+
+/*  The number of inputs, and the fixed power used for the second table.      */
+static const std::size_t number_of_values = 4096;
+static const int fixed_power = 37;
+
+/*  Times every implementation of z^n, with a different n for every z.        */
+static void compare(const std::vector<double> &re,
+                    const std::vector<double> &im,
+                    const std::vector<int> &power)
+{
+    const std::size_t n = re.size();
+    Benchmark benchmark("z^n, |z| in [0.9, 1.1], n in [-64, 64]", n);
+    std::size_t k;
+
+    benchmark.run("exponentiating_by_squaring_c89.c", [&](void) {
+        double sum = 0.0;
+        double out[2];
+
+        for (k = 0; k < n; ++k)
+        {
+            exp_by_squaring_c89(re[k], im[k], power[k], out);
+            sum += out[0] + out[1];
+        }
+
+        return sum;
+    });
+
+    benchmark.run("exponentiating_by_squaring_c99.c", [&](void) {
+        double sum = 0.0;
+        double out[2];
+
+        for (k = 0; k < n; ++k)
+        {
+            exp_by_squaring_c99(re[k], im[k], power[k], out);
+            sum += out[0] + out[1];
+        }
+
+        return sum;
+    });
+
+    benchmark.run("Complex", [&](void) {
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k)
+        {
+            const Complex z = exp_by_squaring(Complex(re[k], im[k]), power[k]);
+            sum += z.real() + z.imag();
+        }
+
+        return sum;
+    });
+
+    benchmark.run("FastComplex", [&](void) {
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k)
+        {
+            const FastComplex z =
+                exp_by_squaring(FastComplex(re[k], im[k]), power[k]);
+
+            sum += z.real() + z.imag();
+        }
+
+        return sum;
+    });
+
+    /*  The standard library computes z^n as exp(n log(z)) from C++11 on.     */
+    benchmark.run("std::pow", [&](void) {
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k)
+        {
+            const std::complex<double> z(re[k], im[k]);
+            const std::complex<double> z_pow =
+                std::pow(z, static_cast<double>(power[k]));
+
+            sum += z_pow.real() + z_pow.imag();
+        }
+
+        return sum;
+    });
+}
+/*  End of compare.                                                           */
+
+/*  Times the routines that need the same n for every z. The power is known   *
+ *  when compiling, so the squarings can be unrolled, or vectorized.          */
+static void compare_fixed(const std::vector<double> &re,
+                          const std::vector<double> &im)
+{
+    const std::size_t n = re.size();
+    std::vector<double> re_out(n), im_out(n);
+    Benchmark benchmark("z^37, |z| in [0.9, 1.1]", n);
+    std::size_t k;
+
+    benchmark.run("exponentiating_by_squaring_c99.c", [&](void) {
+        double sum = 0.0;
+        double out[2];
+
+        for (k = 0; k < n; ++k)
+        {
+            exp_by_squaring_c99(re[k], im[k], fixed_power, out);
+            sum += out[0] + out[1];
+        }
+
+        return sum;
+    });
+
+    benchmark.run("FastComplex", [&](void) {
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k)
+        {
+            const FastComplex z =
+                exp_by_squaring(FastComplex(re[k], im[k]), fixed_power);
+
+            sum += z.real() + z.imag();
+        }
+
+        return sum;
+    });
+
+    benchmark.run("FastComplex, unrolled", [&](void) {
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k)
+        {
+            const FastComplex z =
+                exp_by_squaring<fixed_power>(FastComplex(re[k], im[k]));
+
+            sum += z.real() + z.imag();
+        }
+
+        return sum;
+    });
+
+    benchmark.run("batched", [&](void) {
+        double sum = 0.0;
+
+        exp_by_squaring(re.data(), im.data(), re_out.data(), im_out.data(),
+                        n, fixed_power);
+
+        for (k = 0; k < n; ++k)
+            sum += re_out[k] + im_out[k];
+
+        return sum;
+    });
+}
+/*  End of compare_fixed.                                                     */
+
+/*  Times the powers on points near the unit circle, so that z^n neither      *
+ *  overflows nor underflows.                                                 */
+int main(void)
+{
+    std::vector<double> re(number_of_values), im(number_of_values);
+    std::vector<int> power(number_of_values);
+    Random random;
+    std::size_t k;
+
+    for (k = 0; k < number_of_values; ++k)
+    {
+        const double r = random.uniform(0.9, 1.1);
+        const double theta = random.uniform(0.0, 6.283185307179586);
+
+        re[k] = r * std::cos(theta);
+        im[k] = r * std::sin(theta);
+        power[k] = random.integer(-64, 64);
+    }
+
+    compare(re, im, power);
+    compare_fixed(re, im);
+    return 0;
+}
+
+/*  This is built by the CMake project at the top of the repository. From     *
+ *  there, run:                                                               *
+ *      cmake -S . -B build                                                   *
+ *      cmake --build build --target bench                                    *
+ *  to run it together with the other benchmarks, or                          *
+ *  build/benchmarks/exponentiating_by_squaring_benchmark to run it alone.    *
+ *  The timings depend on the machine. Add -DMITX_NATIVE=ON to the first      *
+ *  command to enable the vector instructions used by the batched routines.   */
@@ -0,0 +1,52 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Makes the C89 version of exponentiation by squaring callable from the *
+ *      benchmark.                                                            *
+ *  Notes:                                                                    *
+ *      The example is included as is, with its main function renamed, so the *
+ *      benchmark times exactly the code in exponentiating_by_squaring_c89.c, *
+ *      compiled as C.                                                        *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/23                                                        *
+ ******************************************************************************/
+
+/*  Rename main so it does not clash with the main of the benchmark.          */
+#define main exponentiating_by_squaring_c89_main
+#include "exponentiating_by_squaring_c89.c"
+#undef main
+
+/*  The example's function is static. This gives the benchmark access to it.  */
+void exp_by_squaring_c89(double real, double imag, int n, double *out);
+
+void exp_by_squaring_c89(double real, double imag, int n, double *out)
+{
+    /*  C89 has no complex type, the example uses a struct instead.           */
+    struct complex_number z, z_pow;
+
+    z.real = real;
+    z.imag = imag;
+    z_pow = exp_by_squaring(&z, n);
+
+    out[0] = z_pow.real;
+    out[1] = z_pow.imag;
+}
+/*  End of exp_by_squaring_c89.                                               */
@@ -0,0 +1,49 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Makes the C99 version of exponentiation by squaring callable from the *
+ *      benchmark.                                                            *
+ *  Notes:                                                                    *
+ *      The example is included as is, with its main function renamed, so the *
+ *      benchmark times exactly the code in exponentiating_by_squaring_c99.c, *
+ *      compiled as C.                                                        *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/23                                                        *
+ ******************************************************************************/
+
+/*  Rename main so it does not clash with the main of the benchmark.          */
+#define main exponentiating_by_squaring_c99_main
+#include "exponentiating_by_squaring_c99.c"
+#undef main
+
+/*  The example's function is static. This gives the benchmark access to it.  */
+void exp_by_squaring_c99(double real, double imag, int n, double *out);
+
+void exp_by_squaring_c99(double real, double imag, int n, double *out)
+{
+    /*  complex double is not available in C++, so pass the parts instead.    */
+    const complex double z = real + (complex double)I*imag;
+    const complex double z_pow = exp_by_squaring(z, n);
+
+    out[0] = creal(z_pow);
+    out[1] = cimag(z_pow);
+}
+/*  End of exp_by_squaring_c99.                                               */
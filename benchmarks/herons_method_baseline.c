@@ -0,0 +1,42 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Makes the C version of Heron's method callable from the benchmark.    *
+ *  Notes:                                                                    *
+ *      The example is included as is, with its main function renamed, so the *
+ *      benchmark times exactly the code in herons_method.c, compiled as C.   *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/23                                                        *
+ ******************************************************************************/
+
+/*  Rename main so it does not clash with the main of the benchmark.          */
+#define main herons_method_main
+#include "herons_method.c"
+#undef main
+
+/*  The example's function is static. This gives the benchmark access to it.  */
+double herons_method_baseline(double x);
+
+double herons_method_baseline(double x)
+{
+    return herons_method(x);
+}
+/*  End of herons_method_baseline.                                            */
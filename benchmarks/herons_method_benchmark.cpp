@@ -0,0 +1,144 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Benchmarks the square root routines of herons_method.cpp against the C*
+ *      version and the standard library.                                     *
+ *  Notes:                                                                    *
+ *      The routines are included from the header of the example, so this    *
+ *      times exactly the code that the example uses.                         *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/23                                                        *
+ ******************************************************************************/
+
+/*  The harness, and the random number generator for the inputs.              */
+#include "benchmark.hpp"
+
+/*  The routines being timed.                                                 */
+#include "herons_method.hpp"
+
+/*  The C version, compiled as C in herons_method_baseline.c.                 */
+extern "C" double herons_method_baseline(double x);
+
+/*  The number of error computations, x - a^2, made by the C++ routines.      */
+static unsigned long int evaluations = 0UL;
+
+/*  Times every routine on the given inputs.                                  */
+static void compare(const char * const title, const std::vector<double> &x)
+{
+    const std::size_t n = x.size();
+    std::vector<double> y(n);
+    Benchmark benchmark(title, n);
+
+    benchmark.run("herons_method.c", [&](void) {
+        double sum = 0.0;
+        std::size_t k;
+
+        for (k = 0; k < n; ++k)
+            sum += herons_method_baseline(x[k]);
+
+        return sum;
+    });
+
+    benchmark.run("Heron::sqrt, InputSeed", [&](void) {
+        double sum = 0.0;
+        std::size_t k;
+
+        for (k = 0; k < n; ++k)
+        {
+            const Heron::Result result =
+                Heron::detailed_sqrt(x[k], Heron::InputSeed);
+
+            evaluations += result.evaluations;
+            sum += result.root;
+        }
+
+        return sum;
+    }, &evaluations);
+
+    benchmark.run("Heron::sqrt, ExponentSeed", [&](void) {
+        double sum = 0.0;
+        std::size_t k;
+
+        for (k = 0; k < n; ++k)
+        {
+            const Heron::Result result =
+                Heron::detailed_sqrt(x[k], Heron::ExponentSeed);
+
+            evaluations += result.evaluations;
+            sum += result.root;
+        }
+
+        return sum;
+    }, &evaluations);
+
+    benchmark.run("Heron::sqrt, batched", [&](void) {
+        double sum = 0.0;
+        std::size_t k;
+
+        Heron::sqrt(x.data(), y.data(), n);
+
+        for (k = 0; k < n; ++k)
+            sum += y[k];
+
+        return sum;
+    });
+
+    benchmark.run("std::sqrt", [&](void) {
+        double sum = 0.0;
+        std::size_t k;
+
+        for (k = 0; k < n; ++k)
+            sum += std::sqrt(x[k]);
+
+        return sum;
+    });
+}
+/*  End of compare.                                                           */
+
+/*  Times the square roots on moderate inputs, where starting at x works, and *
+ *  across nearly the whole range of doubles, where it does not.              */
+int main(void)
+{
+    const std::size_t number_of_values = 4096;
+    std::vector<double> moderate(number_of_values);
+    std::vector<double> wide(number_of_values);
+    Random random;
+    std::size_t k;
+
+    for (k = 0; k < number_of_values; ++k)
+    {
+        moderate[k] = random.log_uniform(1.0E-03, 1.0E+03);
+        wide[k] = random.log_uniform(1.0E-300, 1.0E+300);
+    }
+
+    compare("sqrt(x), x log-uniform in [1E-3, 1E3]", moderate);
+    compare("sqrt(x), x log-uniform in [1E-300, 1E300]", wide);
+    return 0;
+}
+
+/*  This is built by the CMake project at the top of the repository. From     *
+ *  there, run:                                                               *
+ *      cmake -S . -B build                                                   *
+ *      cmake --build build --target bench                                    *
+ *  to run it together with the other benchmarks, or                          *
+ *  build/benchmarks/herons_method_benchmark to run it alone. The timings     *
+ *  depend on the machine. Add -DMITX_NATIVE=ON to the first command to       *
+ *  enable the vector instructions used by the batched routines.              */
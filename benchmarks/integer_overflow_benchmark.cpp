@@ -0,0 +1,192 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Benchmarks the checked and saturating array routines of               *
+ *      integer_overflow.hpp against the ordinary arithmetic, which wraps     *
+ *      around.                                                               *
+ *  Notes:                                                                    *
+ *      The routines are included from the header of the example, so this     *
+ *      times exactly the code that the example uses. The naive loops are     *
+ *      what would be written without any checks, and they are the fastest    *
+ *      possible, since the compiler vectorizes them. The scalar check is the *
+ *      usual way of checking, one number at a time and branching on the      *
+ *      result.                                                               *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/09/27                                                        *
+ ******************************************************************************/
+
+/*  The harness, and the random number generator for the inputs.              */
+#include "benchmark.hpp"
+
+/*  The routines being timed.                                                 */
+#include "integer_overflow.hpp"
+
+/*  The number of inputs. The four arrays of the checked routines fit in the  *
+ *  L1 cache of most processors even for 64-bit numbers, so this times the    *
+ *  arithmetic and not the memory.                                            */
+static const std::size_t number_of_values = 1024;
+
+/*  Adds a few elements of the output to the result of a pass, so the         *
+ *  compiler can not skip the work. Outputs of every type are converted to    *
+ *  double.                                                                   */
+template <typename Integer>
+static double checksum(const std::vector<Integer> &out)
+{
+    return static_cast<double>(out[0]) +
+           static_cast<double>(out[out.size() / 2]) +
+           static_cast<double>(out[out.size() - 1]);
+}
+/*  End of checksum.                                                          */
+
+/*  Times every routine on random numbers of the type Integer.                */
+template <typename Integer>
+static void compare(const char * const title)
+{
+    typedef BasicIntegerArithmetic<Integer> Arithmetic;
+    typedef typename Arithmetic::Mask Mask;
+
+    const std::size_t n = number_of_values;
+    std::vector<Integer> a(n), b(n), out(n);
+    std::vector<Mask> overflow(n);
+    Benchmark benchmark(title, n);
+    Random random;
+    std::size_t k;
+
+    /*  Every bit pattern is equally likely, so about a quarter to a half of  *
+     *  the sums and differences overflow, and almost all of the products.    */
+    for (k = 0; k < n; ++k)
+    {
+        a[k] = static_cast<Integer>(random.bits());
+        b[k] = static_cast<Integer>(random.bits());
+    }
+
+    /*  The ordinary sum. For signed types it is computed in the unsigned     *
+     *  type, since signed overflow is undefined, which gives the same bits.  */
+    benchmark.run("naive a + b, wrapping", [&](void) {
+        for (k = 0; k < n; ++k)
+            out[k] = static_cast<Integer>(static_cast<Mask>(
+                static_cast<Mask>(a[k]) + static_cast<Mask>(b[k])
+            ));
+
+        return checksum(out);
+    });
+
+    /*  The scalar check, with a branch for every number.                     */
+    benchmark.run("scalar check, branching", [&](void) {
+        std::size_t overflows = 0;
+
+        for (k = 0; k < n; ++k)
+        {
+            const typename Arithmetic::Result result =
+                Arithmetic::add(a[k], b[k]);
+
+            if (result.overflowed)
+            {
+                out[k] = Arithmetic::max_number;
+                ++overflows;
+            }
+            else
+                out[k] = result.value;
+        }
+
+        return checksum(out) + static_cast<double>(overflows);
+    });
+
+    benchmark.run("add, overflow mask", [&](void) {
+        const bool any = Arithmetic::add(
+            a.data(), b.data(), out.data(), overflow.data(), n
+        );
+
+        return checksum(out) + checksum(overflow) + (any ? 1.0 : 0.0);
+    });
+
+    benchmark.run("add_saturated", [&](void) {
+        const bool any =
+            Arithmetic::add_saturated(a.data(), b.data(), out.data(), n);
+
+        return checksum(out) + (any ? 1.0 : 0.0);
+    });
+
+    benchmark.run("subtract_saturated", [&](void) {
+        const bool any = Arithmetic::subtract_saturated(
+            a.data(), b.data(), out.data(), n
+        );
+
+        return checksum(out) + (any ? 1.0 : 0.0);
+    });
+
+    benchmark.run("naive a * b, wrapping", [&](void) {
+        for (k = 0; k < n; ++k)
+            out[k] = static_cast<Integer>(static_cast<Mask>(
+                static_cast<typename std::common_type<Mask, unsigned>::type>(
+                    static_cast<Mask>(a[k])
+                ) * static_cast<Mask>(b[k])
+            ));
+
+        return checksum(out);
+    });
+
+    benchmark.run("multiply_saturated", [&](void) {
+        const bool any = Arithmetic::multiply_saturated(
+            a.data(), b.data(), out.data(), n
+        );
+
+        return checksum(out) + (any ? 1.0 : 0.0);
+    });
+
+    /*  The total of a, as a telemetry program would add up counters.         */
+    benchmark.run("naive sum, wrapping", [&](void) {
+        Mask total = 0U;
+
+        for (k = 0; k < n; ++k)
+            total = static_cast<Mask>(total + static_cast<Mask>(a[k]));
+
+        return static_cast<double>(total);
+    });
+
+    benchmark.run("sum, checked", [&](void) {
+        const typename Arithmetic::Result total = Arithmetic::sum(a.data(), n);
+        const double overflowed = (total.overflowed ? 1.0 : 0.0);
+        return static_cast<double>(total.value) + overflowed;
+    });
+}
+/*  End of compare.                                                           */
+
+/*  Times the routines for every width that the hardware adds natively.       */
+int main(void)
+{
+    compare<std::uint8_t>("8-bit unsigned");
+    compare<std::uint16_t>("16-bit unsigned");
+    compare<std::uint32_t>("32-bit unsigned");
+    compare<std::uint64_t>("64-bit unsigned");
+    compare<std::int32_t>("32-bit signed");
+    compare<std::int64_t>("64-bit signed");
+    return 0;
+}
+
+/*  This is built by the CMake project at the top of the repository. From     *
+ *  there, run:                                                               *
+ *      cmake -S . -B build                                                   *
+ *      cmake --build build --target bench                                    *
+ *  to run it together with the other benchmarks, or                          *
+ *  build/benchmarks/integer_overflow_benchmark to run it alone. The timings  *
+ *  depend on the machine. Add -DMITX_NATIVE=ON to the first command to       *
+ *  enable the vector instructions used by the array routines.                */
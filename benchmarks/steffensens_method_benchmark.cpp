@@ -0,0 +1,121 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Benchmarks the routines of steffensens_method.cpp against the C       *
+ *      version.                                                              *
+ *  Notes:                                                                    *
+ *      The routines are included from the header of the example, so this    *
+ *      times exactly the code that the example uses.                         *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/23                                                        *
+ ******************************************************************************/
+
+/*  The harness, and the random number generator for the inputs.              */
+#include "benchmark.hpp"
+
+/*  The routines being timed.                                                 */
+#include "steffensens_method.hpp"
+
+/*  The C version, compiled as C in steffensens_method_baseline.c.            */
+extern "C" double steffensens_method_baseline(Steffensen::pointer f, double x);
+
+/*  The number of times the functions in main have been called.               */
+static unsigned long int evaluations = 0UL;
+
+/*  Times every routine on f from starting points in [low, high], chosen at   *
+ *  random. f is a lambda without captures, which also converts to a function *
+ *  pointer.                                                                  */
+template <typename Function>
+static void compare(const char * const title,
+                    Function f,
+                    double low,
+                    double high)
+{
+    const Steffensen::pointer pointer = f;
+    const std::size_t n = 4096;
+    std::vector<double> x(n);
+    Random random;
+    std::size_t k;
+
+    for (k = 0; k < n; ++k)
+        x[k] = random.uniform(low, high);
+
+    Benchmark benchmark(title, n);
+
+    benchmark.run("steffensens_method.c", [&](void) {
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k)
+            sum += steffensens_method_baseline(pointer, x[k]);
+
+        return sum;
+    }, &evaluations);
+
+    benchmark.run("Steffensen::root, pointer", [&](void) {
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k)
+            sum += Steffensen::root(pointer, x[k]);
+
+        return sum;
+    }, &evaluations);
+
+    /*  A lambda may be inlined into the solver, a function pointer can not.  */
+    benchmark.run("Steffensen::root, lambda", [&](void) {
+        double sum = 0.0;
+
+        for (k = 0; k < n; ++k)
+            sum += Steffensen::root(f, x[k]);
+
+        return sum;
+    }, &evaluations);
+}
+/*  End of compare.                                                           */
+
+/*  Times the root finders on a cheap and on a more expensive function. Both  *
+ *  count their calls, so the evaluations per root are printed as well.       */
+int main(void)
+{
+    /*  The roots are plus and minus the square root of 2.                    */
+    const auto square_minus_two = [](double x) {
+        ++evaluations;
+        return x*x - 2.0;
+    };
+
+    /*  The root is the Dottie number, 0.739085...                            */
+    const auto cos_minus_x = [](double x) {
+        ++evaluations;
+        return std::cos(x) - x;
+    };
+
+    compare("x^2 - 2 from x in [1, 3]", square_minus_two, 1.0, 3.0);
+    compare("cos(x) - x from x in [0, 1.5]", cos_minus_x, 0.0, 1.5);
+    return 0;
+}
+
+/*  This is built by the CMake project at the top of the repository. From     *
+ *  there, run:                                                               *
+ *      cmake -S . -B build                                                   *
+ *      cmake --build build --target bench                                    *
+ *  to run it together with the other benchmarks, or                          *
+ *  build/benchmarks/steffensens_method_benchmark to run it alone. The        *
+ *  timings depend on the machine. Add -DMITX_NATIVE=ON to the first command  *
+ *  to enable the vector instructions used by the batched routines.           */
@@ -19,6 +19,9 @@
  ******************************************************************************
  *  Purpose:                                                                  *
  *      Computes z^n for integer n using exponentiation by squaring.          *
+ *  Notes:                                                                    *
+ *      The functions are in exponentiating_by_squaring.hpp. This file shows  *
+ *      how to use them, and benchmarks them.                                 *
  ******************************************************************************
  *  Author: Ryan Maguire                                                      *
  *  Date:   2025/07/04                                                        *
@@ -30,97 +33,155 @@
 /*  Complex numbers provided here.                                            */
 #include <complex>
 
-/*  Print a complex number in standard form, x + y*i.                         */
-static void print_complex(std::complex<double> z)
-{
-    /*  We can use printf with the correct format specifiers to do the job.   */
-    std::printf("%.16E + %.16E*i\n", z.real(), z.imag());
-}
+/*  cos and sin, used for the points in the benchmark, are found here.        */
+#include <cmath>
 
-/*  Computes powers of a given complex number by repeatedly squaring.         */
-static std::complex<double> exp_by_squaring(std::complex<double> z, int n)
-{
-    /*  We start off with out = z, and then apply out = out^2 repeatedly.     */
-    std::complex<double> output = z;
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
 
-    /*  The scale factor is used to handle odd powers. That is, if we have    *
-     *  z^(2n+1), we can write this as z^(2n) * z = (z^2)^n * z. The scale    *
-     *  factor will pick up the solo "z" term, and the squaring part handles  *
-     *  (z^2)^n. Create a variable for this and initialize it to 1.           */
-    std::complex<double> scale = std::complex<double>(1.0, 0.0);
+/*  Timing routines, used for benchmarking the batched routine.               */
+#include <chrono>
+
+/*  Exponentiation by squaring, and the complex numbers it works with.        */
+#include "exponentiating_by_squaring.hpp"
+
+/*  Raises about a million points to the n-th power three ways: one at a time *
+ *  with Complex and operator^, one at a time with FastComplex, and with the  *
+ *  batched routine. Prints the time per point for each, the largest relative *
+ *  difference between Complex and the batch, and the number of FastComplex   *
+ *  powers that do not match the batch exactly.                               */
+static void benchmark_batch(int n)
+{
+    /*  The number of points, and arrays for the data. The points are stored  *
+     *  both ways, interleaved for operator^ and split for the batch.         */
+    const std::size_t number_of_points = 1048576;
+    static std::complex<double> points[number_of_points];
+    static std::complex<double> powers[number_of_points];
+    static std::complex<double> fast_powers[number_of_points];
+    static double real[number_of_points];
+    static double imag[number_of_points];
+    static double real_out[number_of_points];
+    static double imag_out[number_of_points];
 
-    /*  Special case. If n = 0, then z^0 = 1, by definition. Return 1.        */
-    if (n == 0)
-        return scale;
+    /*  Variable for indexing, the largest relative difference, and the       *
+     *  number of mismatches.                                                 */
+    std::size_t index;
+    double max_difference = 0.0;
+    std::size_t mismatches = 0;
 
-    /*  For negative powers use z^n = (1 / z)^(-n) to reduce n to positive.   */
-    if (n < 0)
+    /*  Points in the annulus 0.9 < |z| < 1.1, like the fractal workloads.    */
+    for (index = 0; index < number_of_points; ++index)
     {
-        output = 1.0 / output;
-        n = -n;
+        const double t = static_cast<double>(index) / number_of_points;
+        const double radius = 0.9 + 0.2 * t;
+        real[index] = radius * std::cos(6.283185307179586 * t * 7.0);
+        imag[index] = radius * std::sin(6.283185307179586 * t * 7.0);
+        points[index] = std::complex<double>(real[index], imag[index]);
+
+        /*  Touch the outputs too, so no loop pays for a first write.         */
+        powers[index] = fast_powers[index] = std::complex<double>(0.0, 0.0);
+        real_out[index] = imag_out[index] = 0.0;
     }
 
-    /*  Start the process. Compute z^n by removing all of the even factors    *
-     *  for n, iteratively updating the output along the way.                 */
-    while (n > 1)
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for (index = 0; index < number_of_points; ++index)
+        powers[index] = Complex(points[index]) ^ n;
+
+    const std::chrono::steady_clock::time_point standard_end =
+        std::chrono::steady_clock::now();
+
+    for (index = 0; index < number_of_points; ++index)
+        fast_powers[index] = FastComplex(points[index]) ^ n;
+
+    const std::chrono::steady_clock::time_point fast_end =
+        std::chrono::steady_clock::now();
+
+    exp_by_squaring(real, imag, real_out, imag_out, number_of_points, n);
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    const double standard =
+        std::chrono::duration<double, std::nano>(standard_end - start).count();
+
+    const double fast =
+        std::chrono::duration<double, std::nano>(fast_end - standard_end)
+            .count();
+
+    const double batched =
+        std::chrono::duration<double, std::nano>(end - fast_end).count();
+
+    for (index = 0; index < number_of_points; ++index)
     {
-        /*  If n is odd, n = 2*k+1, and if w = output, then:                  *
-         *                                                                    *
-         *       n    2k + 1                                                  *
-         *      w  = w                                                        *
-         *                                                                    *
-         *            -  2 -  n                                               *
-         *         = | w    |   * w                                           *
-         *            -    -                                                  *
-         *                                                                    *
-         *  Multiply "scale" by "output" to handle the "* w" on the right     *
-         *  side of the expression. We can continue squaring, replacing       *
-         *  output with output^2, to handle portion of this expression that   *
-         *  is inside of the parentheses.                                     */
-        if ((n % 2) == 1)
-        {
-            scale *= output;
-            --n;
-        }
-
-        /*  n is now even. Square the output and divide n by two.             */
-        output *= output;
-        n >>= 1;
+        const std::complex<double> w(real_out[index], imag_out[index]);
+        const double difference =
+            std::abs(w - powers[index]) / std::abs(powers[index]);
+
+        if (difference > max_difference)
+            max_difference = difference;
+
+        if (w != fast_powers[index])
+            ++mismatches;
     }
 
-    /*  n is now 1. The final output is output * scale. Compute this.         */
-    return output * scale;
+    std::printf("n = %3d: Complex %6.2f, FastComplex %6.2f, batched %6.2f "
+                "ns/point\n", n, standard / number_of_points,
+                fast / number_of_points, batched / number_of_points);
+
+    std::printf("         max relative difference %.3E, "
+                "FastComplex mismatches %lu\n", max_difference,
+                static_cast<unsigned long int>(mismatches));
 }
 
-/*  Let's extend the complex<double> class by providing the "^" operator.     */
-class Complex : public std::complex<double> {
-    public:
-
-        /*  Constructor from real and imaginary parts, z = x + iy.            */
-        Complex(double real, double imag) : std::complex<double>(real, imag)
-        {
-            /*  Nothing to do, simply inherit the std::complex constructor.   */
-        }
-
-        /*  Constructor from a complex number, z = w.                         */
-        Complex(const std::complex<double>& other) : std::complex<double>(other)
-        {
-            /*  Similarly, we do not need to add more functionality.          */
-        }
-
-        /*  Provide the "^" operator for complex numbers. We can then write   *
-         *  something like w = z^n, instead of w = exp_by_squaring(z, n).     */
-        Complex operator ^ (int n) const
-        {
-            return Complex(exp_by_squaring(*this, n));
-        }
-
-        /*  Provide the print function as a method for the class.             */
-        void print(void) const
-        {
-            print_complex(*this);
-        }
-};
+/*  Divides a few numbers by huge and tiny denominators, and compares with    *
+ *  std::complex. Without scaling, c + d * ratio in Smith's method overflows  *
+ *  for the largest denominators. Quotients that overflow, or underflow to    *
+ *  subnormal numbers, are skipped, since there the digits are lost anyway.   *
+ *  Prints one of each, and the largest relative difference.                  */
+static void check_division(void)
+{
+    /*  The parts of the numerators and denominators.                         */
+    const double parts[] = {
+        1.0, -3.0, 1.0E+300, 1.0E+308, -1.5E+308, 1.7976931348623157E+308,
+        1.0E-300, 1.0E-308, 3.0E-310, 4.9406564584124654E-324
+    };
+
+    const std::size_t number_of_parts = sizeof(parts) / sizeof(parts[0]);
+
+    /*  Variables for indexing, and the largest relative difference.          */
+    std::size_t a, b, c, d;
+    double max_difference = 0.0;
+
+    for (a = 0; a < number_of_parts; ++a)
+        for (b = 0; b < number_of_parts; ++b)
+            for (c = 0; c < number_of_parts; ++c)
+                for (d = 0; d < number_of_parts; ++d)
+                {
+                    const Complex z(parts[a], parts[b]);
+                    const Complex w(parts[c], parts[d]);
+                    const std::complex<double> quotient = z / w;
+                    const std::complex<double> expected =
+                        std::complex<double>(z) / std::complex<double>(w);
+                    const double size = std::abs(expected);
+
+                    if (!(size >= 2.2250738585072014E-308) || size > 1.0E+308)
+                        continue;
+
+                    const double difference =
+                        std::abs(quotient - expected) / size;
+
+                    if (difference > max_difference)
+                        max_difference = difference;
+                }
+
+    (Complex(1.0) / Complex(1.0E+308, 1.0E+308)).print();
+    (Complex(1.0) / Complex(1.0E-308, 1.0E-308)).print();
+    std::printf("Huge and tiny denominators, max relative difference %.3E\n",
+                max_difference);
+}
+/*  End of check_division.                                                    */
 
 /*  Test our routines by computing 1 / (1 + i)^30.                            */
 int main(void)
@@ -129,5 +190,111 @@ int main(void)
     const Complex z = Complex(1.0, 1.0);
     const Complex w = z^n;
     w.print();
+
+    /*  The same power with the exponent fixed at compile time. The squaring  *
+     *  chain does the same multiplications as the loop, so the two agree     *
+     *  exactly. Cubing is done with two multiplications.                     */
+    const Complex v = Complex::pow<-30>(z);
+    const Complex u = Complex(0.5, -1.5) ^ Exponent<3>();
+    v.print();
+    u.print();
+
+    std::printf("Runtime and compile-time powers agree: %s\n",
+                (v == w ? "Yes" : "No"));
+
+    /*  Complex is a literal type, so whole expressions can be computed by    *
+     *  the compiler. The static_asserts prove that no work is done at run    *
+     *  time. (1 + i)^8 = 16 exactly, and (1 + 2i + conj(1 + i)) / (3 + 4i)   *
+     *  is (2 + i) / (3 + 4i) = 0.4 - 0.2i.                                   */
+    constexpr Complex one_plus_i = Complex(1.0, 1.0);
+    constexpr Complex eighth_power = one_plus_i ^ 8;
+    constexpr Complex quotient =
+        (Complex(1.0, 2.0) + conj(one_plus_i)) / Complex(3.0, 4.0);
+
+    static_assert(eighth_power == Complex(16.0, 0.0),
+                  "(1 + i)^8 should be 16");
+
+    static_assert(abs_squared(quotient - Complex(0.4, -0.2)) < 1.0E-30,
+                  "(2 + i) / (3 + 4i) should be 0.4 - 0.2i");
+
+    eighth_power.print();
+    quotient.print();
+
+    /*  (1.5 + 2i)^1000000 has about 400,000 digits. exp_by_squaring gives    *
+     *  infinity, the scaled version gives the mantissa, the binary exponent, *
+     *  and log10|w|, which should be 10^6 log10(2.5). The small power is a   *
+     *  check, the scaled (1 + i)^-30 agrees with w above.                    */
+    const Complex big = Complex(1.5, 2.0);
+    const ScaledPower<StandardArithmetic> huge =
+        scaled_exp_by_squaring(big, 1000000);
+    const ScaledPower<StandardArithmetic> small =
+        scaled_exp_by_squaring(z, -30);
+
+    (big ^ 1000000).print();
+    huge.mantissa.print();
+    std::printf("exponent: %lld\n", huge.exponent);
+    std::printf("log10|w| = %.10f, expected %.10f\n",
+                huge.log_abs() / 2.302585092994046, 1.0E6 * std::log10(2.5));
+
+    std::printf("Scaled power agrees: %s\n",
+                (small.value() == w ? "Yes" : "No"));
+
+    /*  Division by the largest and smallest numbers.                         */
+    check_division();
+
+    /*  The batched routine on a million points. The exponent is read from a  *
+     *  volatile variable so that the compiler can not see it, which is what  *
+     *  happens when it comes from user input.                                */
+    volatile int exponents[3] = {3, 30, -30};
+    benchmark_batch(exponents[0]);
+    benchmark_batch(exponents[1]);
+    benchmark_batch(exponents[2]);
     return 0;
 }
+
+/*  We can execute this on GNU, Linux, FreeBSD, macOS, etc., via:             *
+ *      c++ -O2 exponentiating_by_squaring.cpp -o main                        *
+ *      ./main                                                                *
+ *  This will output the following:                                           *
+ *      -0.0000000000000000E+00 + 3.0517578125000000E-05*i                    *
+ *      -0.0000000000000000E+00 + 3.0517578125000000E-05*i                    *
+ *      -3.2500000000000000E+00 + 2.2500000000000000E+00*i                    *
+ *      Runtime and compile-time powers agree: Yes                            *
+ *      1.6000000000000000E+01 + 0.0000000000000000E+00*i                     *
+ *      4.0000000000000002E-01 + -2.0000000000000001E-01*i                    *
+ *      INF + INF*i                                                           *
+ *      -7.8923298305523570E-01 + -7.1951156987392728E-01*i                   *
+ *      exponent: 1321928                                                     *
+ *      log10|w| = 397940.0086720376, expected 397940.0086720376              *
+ *      Scaled power agrees: Yes                                              *
+ *      4.9999999999999995E-309 + -4.9999999999999995E-309*i                  *
+ *      5.0000000000000001E+307 + -5.0000000000000001E+307*i                  *
+ *      Huge and tiny denominators, max relative difference 2.099E-16         *
+ *  The exact mantissa is -0.78923298305622 - 0.71951156987495i, so after a   *
+ *  million steps about 12 digits are still correct. The first quotient is a  *
+ *  subnormal number, and is as close to 5E-309 as a subnormal can be.        *
+ *  followed by the timings for Complex, FastComplex, and the batched         *
+ *  routine. These depend on the machine, but FastComplex is typically faster *
+ *  than Complex, since it skips the checks for infinities and NaN's, and the *
+ *  batch is faster again. The differences are zero for positive powers. For  *
+ *  negative powers the reciprocals differ by rounding, and the power         *
+ *  amplifies this by a factor of about |n|, giving roughly 1E-14 for -30.    *
+ *  FastComplex and the batch use the same arithmetic, and never mismatch.    *
+ *                                                                            *
+ *  To enable the vector instructions for the batched routine, tell the       *
+ *  compiler what hardware to target. For example:                            *
+ *      c++ -O2 -march=native -ffp-contract=off \                             *
+ *          exponentiating_by_squaring.cpp -o main                            *
+ *                                                                            *
+ *  To record the squarings, or time every call, add -DSOLVER_TRACING, and    *
+ *  run the program with SOLVER_TRACE set to 1, 2, or 3. This needs C++17,    *
+ *  see solver_tracing.cpp for the details.                                   *
+ *                                                                            *
+ *  The constexpr routines need C++14 or later. Old compilers may need the    *
+ *  -std=c++14 option for this.                                               *
+ *                                                                            *
+ *  On Windows you will need to install a C++ compiler. Microsoft's MSVC is a *
+ *  common option. Using MSVC, type:                                          *
+ *      cl /O2 exponentiating_by_squaring.cpp /link /out:main.exe             *
+ *      main.exe                                                              *
+ *  This will produce the same output.                                        */
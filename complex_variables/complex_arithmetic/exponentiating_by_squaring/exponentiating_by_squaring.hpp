@@ -0,0 +1,1087 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Header-only implementation of exponentiation by squaring for complex  *
+ *      numbers.                                                              *
+ *  Notes:                                                                    *
+ *      Provides BasicComplex, the Complex and FastComplex typedefs, the      *
+ *      exp_by_squaring and scaled_exp_by_squaring functions, and a batched   *
+ *      exp_by_squaring for arrays. Everything is a template, constexpr, or   *
+ *      inline, so including this file is all that is needed.                 *
+ *      exponentiating_by_squaring.cpp shows how it is used.                  *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/30                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_EXPONENTIATING_BY_SQUARING_HPP
+#define MITX_EXPONENTIATING_BY_SQUARING_HPP
+
+/*  stdio provides the "printf" function, used for printing text.             */
+#include <cstdio>
+
+/*  Complex numbers provided here.                                            */
+#include <complex>
+
+/*  cos and sin, used for the points in the benchmark, and frexp and ldexp,   *
+ *  used for the scaled powers, are found here.                               */
+#include <cmath>
+
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  Each step of exp_by_squaring may be traced. This is off by default, and   *
+ *  compiles to nothing. Compile with -DSOLVER_TRACING to turn it on, see     *
+ *  solver_tracing.hpp for the details.                                       */
+#if defined(SOLVER_TRACING)
+#include "../../../real_analysis/continuous_functions/solver_tracing/solver_tracing.hpp"
+#endif
+
+/*  Vector intrinsics, used by the batched routine. We pick the widest        *
+ *  instruction set the compiler is targeting, and fall back to plain scalar  *
+ *  code if none is available.                                                */
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/*  How to multiply and divide complex numbers. The complex class below takes *
+ *  this as a template parameter, a policy, so the same code can be used with *
+ *  either choice. Both are constexpr, and work for any complex type Z with   *
+ *  real(), imag(), and a constructor from two doubles.                       *
+ *                                                                            *
+ *  StandardArithmetic follows std::complex. The C and C++ standards ask that *
+ *  products and quotients recover from intermediate infinities and NaN's,    *
+ *  for example (inf + i NaN) * (1 + i) should be infinite, not NaN. Many     *
+ *  compilers do this by checking the result of the four multiplies and two   *
+ *  adds, and calling a slow library routine (__muldc3 for GCC and clang) if  *
+ *  it is NaN. We do the same check, and hand the rare case to std::complex.  *
+ *  Division uses Smith's method, which avoids overflow in c^2 + d^2, with    *
+ *  Baudin and Smith's scaling by powers of two, so that huge and tiny        *
+ *  denominators give the same quotients as std::complex. Infinities, NaN's,  *
+ *  and division by zero go to std::complex. The rare cases can not be        *
+ *  computed at compile time, everything else can.                            */
+struct StandardArithmetic {
+
+    /*  Computes z * w.                                                       */
+    template <typename Z>
+    static constexpr Z multiply(const Z &z, const Z &w) noexcept
+    {
+        const double real = z.real() * w.real() - z.imag() * w.imag();
+        const double imag = z.real() * w.imag() + z.imag() * w.real();
+
+        /*  Both parts are NaN only if an infinity or NaN was involved. Let   *
+         *  std::complex recover from this, exactly as it always has.         */
+        if (real != real && imag != imag)
+            return Z(std::complex<double>(z) * std::complex<double>(w));
+
+        return Z(real, imag);
+    }
+
+    /*  Computes z / w.                                                       */
+    template <typename Z>
+    static constexpr Z divide(const Z &z, const Z &w) noexcept
+    {
+        double a = z.real();
+        double b = z.imag();
+        double c = w.real();
+        double d = w.imag();
+
+        /*  Powers of two used for scaling. Half of the largest double,       *
+         *  2^1023, and 2^-969, below which parts are scaled up by 2^105.     */
+        const double half_largest = 8.98846567431158E+307;
+        const double tiny = 2.004168360008973E-292;
+        const double up = 4.056481920730334E+31;
+        const double down = 2.465190328815662E-32;
+        double scale = 1.0;
+
+        /*  The rare cases, handled by std::complex.                          */
+        if (!is_finite(a) || !is_finite(b) || !is_finite(c) || !is_finite(d) ||
+            (c == 0.0 && d == 0.0))
+            return Z(std::complex<double>(z) / std::complex<double>(w));
+
+        /*  Baudin and Smith's scaling. For parts near the largest double, c  *
+         *  + d * ratio and a + b * ratio may overflow, so these are halved.  *
+         *  Parts near the smallest normal double lose their digits to        *
+         *  underflow, so these are scaled up. Scaling by a power of two is   *
+         *  exact, and it is undone at the end.                               */
+        const double ab = (absolute_value(a) > absolute_value(b) ?
+                           absolute_value(a) : absolute_value(b));
+        const double cd = (absolute_value(c) > absolute_value(d) ?
+                           absolute_value(c) : absolute_value(d));
+
+        if (ab >= half_largest)
+        {
+            a *= 0.5;
+            b *= 0.5;
+            scale *= 2.0;
+        }
+
+        if (cd >= half_largest)
+        {
+            c *= 0.5;
+            d *= 0.5;
+            scale *= 0.5;
+        }
+
+        if (ab <= tiny)
+        {
+            a *= up;
+            b *= up;
+            scale *= down;
+        }
+
+        if (cd <= tiny)
+        {
+            c *= up;
+            d *= up;
+            scale *= up;
+        }
+
+        /*  Smith's method. Divide through by the larger of c and d, so that  *
+         *  the ratio is at most 1 in magnitude and nothing overflows. If the *
+         *  ratio underflows to zero, the products with it are computed in    *
+         *  the other order, so that b d / c and a d / c are not lost.        */
+        if (absolute_value(c) >= absolute_value(d))
+        {
+            const double ratio = d / c;
+            const double denominator = c + d * ratio;
+
+            if (ratio == 0.0)
+                return Z(scale * ((a + d * (b / c)) / denominator),
+                         scale * ((b - d * (a / c)) / denominator));
+
+            return Z(scale * ((a + b * ratio) / denominator),
+                     scale * ((b - a * ratio) / denominator));
+        }
+
+        const double ratio = c / d;
+        const double denominator = c * ratio + d;
+
+        if (ratio == 0.0)
+            return Z(scale * ((c * (a / d) + b) / denominator),
+                     scale * ((c * (b / d) - a) / denominator));
+
+        return Z(scale * ((a * ratio + b) / denominator),
+                 scale * ((b * ratio - a) / denominator));
+    }
+
+    /*  Computes 1 / z.                                                       */
+    template <typename Z>
+    static constexpr Z reciprocal(const Z &z) noexcept
+    {
+        return divide(Z(1.0, 0.0), z);
+    }
+
+    private:
+
+        /*  std::fabs is not constexpr, so it can not be used when computing  *
+         *  values at compile time. The absolute value is easy to write.      */
+        static constexpr double absolute_value(double x) noexcept
+        {
+            return (x < 0.0 ? -x : x);
+        }
+
+        /*  Checks if x is finite, meaning not infinite and not NaN. For      *
+         *  finite x, x - x is zero. For infinity it is NaN, and NaN is not   *
+         *  equal to anything. std::isfinite is not constexpr, this is.       */
+        static constexpr bool is_finite(double x) noexcept
+        {
+            return (x - x) == 0.0;
+        }
+};
+
+/*  PlainArithmetic uses the textbook formulas, (a + ib)(c + id) = (ac - bd)  *
+ *  + i(ad + bc) and (a + ib) / (c + id) = (a + ib)(c - id) / (c^2 + d^2),    *
+ *  and nothing else. Every operation is still an IEEE operation, unlike with *
+ *  -ffast-math, but infinities and NaN's are not recovered, and division     *
+ *  overflows if |c + id| is larger than about 10^154. For the finite,        *
+ *  moderate values most programs have this gives the same products as        *
+ *  StandardArithmetic, much faster.                                          */
+struct PlainArithmetic {
+
+    /*  Computes z * w.                                                       */
+    template <typename Z>
+    static constexpr Z multiply(const Z &z, const Z &w) noexcept
+    {
+        return Z(z.real() * w.real() - z.imag() * w.imag(),
+                 z.real() * w.imag() + z.imag() * w.real());
+    }
+
+    /*  Computes z / w.                                                       */
+    template <typename Z>
+    static constexpr Z divide(const Z &z, const Z &w) noexcept
+    {
+        return multiply(z, reciprocal(w));
+    }
+
+    /*  Computes 1 / z.                                                       */
+    template <typename Z>
+    static constexpr Z reciprocal(const Z &z) noexcept
+    {
+        const double denominator = z.real() * z.real() + z.imag() * z.imag();
+        return Z(z.real() / denominator, -(z.imag() / denominator));
+    }
+};
+
+/*  Tag type that carries an exponent at compile time. z ^ Exponent<3>()      *
+ *  reads like the runtime z ^ 3, but picks the unrolled version.             */
+template <int N>
+struct Exponent {
+};
+
+/*  A complex number, z = x + iy, with the "^" operator. The class holds two  *
+ *  doubles and nothing else, and every operation is constexpr and noexcept.  *
+ *  It is a literal type, so the compiler may compute whole expressions at    *
+ *  compile time, and keep the parts in registers across a chain of           *
+ *  operations. The class is a template over the Arithmetic policy used for   *
+ *  "*", "/", and "^".                                                        */
+template <typename Arithmetic>
+class BasicComplex {
+
+    /*  The real and imaginary parts.                                         */
+    double x, y;
+
+    public:
+
+        /*  The default constructor gives zero.                               */
+        constexpr BasicComplex(void) noexcept : x(0.0), y(0.0)
+        {
+            /*  Nothing to do, the parts are set above.                       */
+        }
+
+        /*  Constructor from real and imaginary parts, z = x + iy. A real     *
+         *  number may be used wherever a complex one is expected.            */
+        constexpr BasicComplex(double real, double imag = 0.0) noexcept
+            : x(real), y(imag)
+        {
+            /*  Similarly, nothing to do.                                     */
+        }
+
+        /*  Constructor from a std::complex, z = w.                           */
+        constexpr BasicComplex(const std::complex<double> &other) noexcept
+            : x(other.real()), y(other.imag())
+        {
+            /*  Similarly, nothing to do.                                     */
+        }
+
+        /*  Conversion back to std::complex, for the standard library.        */
+        constexpr operator std::complex<double>(void) const noexcept
+        {
+            return std::complex<double>(x, y);
+        }
+
+        /*  The real and imaginary parts of z.                                */
+        constexpr double real(void) const noexcept
+        {
+            return x;
+        }
+
+        constexpr double imag(void) const noexcept
+        {
+            return y;
+        }
+
+        /*  The complex conjugate, x - iy.                                    */
+        friend constexpr BasicComplex conj(const BasicComplex &z) noexcept
+        {
+            return BasicComplex(z.x, -z.y);
+        }
+
+        /*  The square of the absolute value, |z|^2 = x^2 + y^2.              */
+        friend constexpr double abs_squared(const BasicComplex &z) noexcept
+        {
+            return z.x * z.x + z.y * z.y;
+        }
+
+        /*  Arithmetic. Addition and subtraction are done part by part.       */
+        friend constexpr BasicComplex
+        operator + (const BasicComplex &z, const BasicComplex &w) noexcept
+        {
+            return BasicComplex(z.x + w.x, z.y + w.y);
+        }
+
+        friend constexpr BasicComplex
+        operator - (const BasicComplex &z, const BasicComplex &w) noexcept
+        {
+            return BasicComplex(z.x - w.x, z.y - w.y);
+        }
+
+        friend constexpr BasicComplex
+        operator - (const BasicComplex &z) noexcept
+        {
+            return BasicComplex(-z.x, -z.y);
+        }
+
+        /*  Multiplication and division are done by the Arithmetic policy.    */
+        friend constexpr BasicComplex
+        operator * (const BasicComplex &z, const BasicComplex &w) noexcept
+        {
+            return Arithmetic::multiply(z, w);
+        }
+
+        friend constexpr BasicComplex
+        operator / (const BasicComplex &z, const BasicComplex &w) noexcept
+        {
+            return Arithmetic::divide(z, w);
+        }
+
+        /*  The same operations, in place.                                    */
+        constexpr BasicComplex &operator += (const BasicComplex &w) noexcept
+        {
+            return *this = *this + w;
+        }
+
+        constexpr BasicComplex &operator -= (const BasicComplex &w) noexcept
+        {
+            return *this = *this - w;
+        }
+
+        constexpr BasicComplex &operator *= (const BasicComplex &w) noexcept
+        {
+            return *this = *this * w;
+        }
+
+        constexpr BasicComplex &operator /= (const BasicComplex &w) noexcept
+        {
+            return *this = *this / w;
+        }
+
+        /*  Two complex numbers are equal if both parts are.                  */
+        friend constexpr bool
+        operator == (const BasicComplex &z, const BasicComplex &w) noexcept
+        {
+            return z.x == w.x && z.y == w.y;
+        }
+
+        friend constexpr bool
+        operator != (const BasicComplex &z, const BasicComplex &w) noexcept
+        {
+            return !(z == w);
+        }
+
+        /*  Provide the "^" operator for complex numbers. We can then write   *
+         *  something like w = z^n, instead of w = exp_by_squaring(z, n).     *
+         *  This is defined below, after exp_by_squaring.                     */
+        constexpr BasicComplex operator ^ (int n) const noexcept;
+
+        /*  The same with an exponent known at compile time. Writing w = z ^  *
+         *  Exponent<3>() costs exactly two multiplications.                  */
+        template <int N>
+        constexpr BasicComplex operator ^ (Exponent<N>) const noexcept;
+
+        /*  Computes z^N for an exponent N known at compile time, for example *
+         *  Complex::pow<-30>(z). This is the same as z ^ Exponent<N>(). It   *
+         *  is a static member so that the short name pow stays out of the    *
+         *  code that includes this file.                                     */
+        template <int N>
+        static constexpr BasicComplex pow(const BasicComplex &z) noexcept
+        {
+            return z ^ Exponent<N>();
+        }
+
+        /*  Print a complex number in standard form, x + y*i. We can use      *
+         *  printf with the correct format specifiers to do the job.          */
+        void print(void) const
+        {
+            std::printf("%.16E + %.16E*i\n", x, y);
+        }
+};
+
+/*  Complex numbers whose products and quotients follow std::complex. This is *
+ *  the safe choice.                                                          */
+typedef BasicComplex<StandardArithmetic> Complex;
+
+/*  Complex numbers that use the plain formulas. Opt in to this when the      *
+ *  values are known to be finite and moderate, and the speed matters.        *
+ *  Everything else about the program keeps the usual IEEE rules.             */
+typedef BasicComplex<PlainArithmetic> FastComplex;
+
+/*  Passes one step of exp_by_squaring to the tracer, after the square w has  *
+ *  been computed: the number of squarings so far, the part n of the exponent *
+ *  that is left, and the size |w|, which is what overflows for large powers. *
+ *  exp_by_squaring is constexpr, and the tracer can not run while the        *
+ *  compiler is computing a constant, so the step is only recorded when the   *
+ *  program runs. __builtin_is_constant_evaluated is the C++17 spelling of    *
+ *  C++20's std::is_constant_evaluated, and GCC, clang, and MSVC all provide  *
+ *  it.                                                                       */
+#if defined(SOLVER_TRACING)
+template <typename Arithmetic>
+constexpr void
+trace_squaring(unsigned int step,
+               int n,
+               const BasicComplex<Arithmetic> &w) noexcept
+{
+    if (!__builtin_is_constant_evaluated())
+        if (SolverTrace::active(SolverTrace::Iterations))
+            SolverTrace::step("exp_by_squaring", step,
+                              static_cast<double>(n),
+                              std::sqrt(abs_squared(w)));
+}
+/*  End of trace_squaring.                                                    */
+
+/*  A traced call, defined below exp_by_squaring.                             */
+template <typename Arithmetic>
+BasicComplex<Arithmetic>
+traced_exp_by_squaring(BasicComplex<Arithmetic> z, int n) noexcept;
+#endif
+
+/*  Computes powers of a given complex number by repeatedly squaring.         */
+template <typename Arithmetic, bool Traced = false>
+constexpr BasicComplex<Arithmetic>
+exp_by_squaring(BasicComplex<Arithmetic> z, int n) noexcept
+{
+#if defined(SOLVER_TRACING)
+
+    /*  While tracing, the call goes to a copy of this routine with Traced =  *
+     *  true, which has the hooks, out of line, as in the root finders. This  *
+     *  is never done for a constant, since the tracer can not run then.      */
+    if (!Traced && !__builtin_is_constant_evaluated())
+        if (SolverTrace::mode() != SolverTrace::Off)
+            return traced_exp_by_squaring(z, n);
+#endif
+
+    /*  We start off with out = z, and then apply out = out^2 repeatedly.     */
+    BasicComplex<Arithmetic> output = z;
+
+    /*  The scale factor is used to handle odd powers. That is, if we have    *
+     *  z^(2n+1), we can write this as z^(2n) * z = (z^2)^n * z. The scale    *
+     *  factor will pick up the solo "z" term, and the squaring part handles  *
+     *  (z^2)^n. Create a variable for this and initialize it to 1.           */
+    BasicComplex<Arithmetic> scale = BasicComplex<Arithmetic>(1.0, 0.0);
+
+    /*  Special case. If n = 0, then z^0 = 1, by definition. Return 1.        */
+    if (n == 0)
+        return scale;
+
+    /*  For negative powers use z^n = (1 / z)^(-n) to reduce n to positive.   */
+    if (n < 0)
+    {
+        output = Arithmetic::reciprocal(output);
+        n = -n;
+    }
+
+#if defined(SOLVER_TRACING)
+
+    /*  The number of squarings so far, for the tracer. Unlike the hooks in   *
+     *  the root finders this is left out entirely without tracing, since     *
+     *  even an unused counter changes the order GCC schedules the            *
+     *  multiplications in.                                                   */
+    unsigned int step = 0U;
+#endif
+
+    /*  Start the process. Compute z^n by removing all of the even factors    *
+     *  for n, iteratively updating the output along the way.                 */
+    while (n > 1)
+    {
+        /*  If n is odd, n = 2*k+1, and if w = output, then:                  *
+         *                                                                    *
+         *       n    2k + 1                                                  *
+         *      w  = w                                                        *
+         *                                                                    *
+         *            -  2 -  n                                               *
+         *         = | w    |   * w                                           *
+         *            -    -                                                  *
+         *                                                                    *
+         *  Multiply "scale" by "output" to handle the "* w" on the right     *
+         *  side of the expression. We can continue squaring, replacing       *
+         *  output with output^2, to handle portion of this expression that   *
+         *  is inside of the parentheses.                                     */
+        if ((n % 2) == 1)
+        {
+            scale *= output;
+            --n;
+        }
+
+        /*  n is now even. Square the output and divide n by two.             */
+        output *= output;
+        n >>= 1;
+
+#if defined(SOLVER_TRACING)
+        if (Traced)
+            trace_squaring(step++, n, output);
+#endif
+    }
+
+    /*  n is now 1. The final output is output * scale. Compute this.         */
+    return output * scale;
+}
+
+#if defined(SOLVER_TRACING)
+
+/*  A traced call. This is out of line, so that the code for tracing does not *
+ *  take up room where exp_by_squaring is inlined. Each call is timed, too.   */
+template <typename Arithmetic>
+MITX_TRACE_NOINLINE BasicComplex<Arithmetic>
+traced_exp_by_squaring(BasicComplex<Arithmetic> z, int n) noexcept
+{
+    const SolverTrace::Scope scope("exp_by_squaring");
+    return exp_by_squaring<Arithmetic, true>(z, n);
+}
+/*  End of traced_exp_by_squaring.                                            */
+#endif
+
+/*  The same for std::complex. By default StandardArithmetic is used,         *
+ *  exp_by_squaring(z, n, PlainArithmetic()) selects the plain formulas.      */
+template <typename Arithmetic = StandardArithmetic>
+std::complex<double>
+exp_by_squaring(std::complex<double> z, int n, Arithmetic = Arithmetic())
+{
+    return exp_by_squaring(BasicComplex<Arithmetic>(z), n);
+}
+
+/*  Most powers in practice are small and known when the program is written,  *
+ *  like z^2, z^3, or z^-30. For these we can do the loop above at compile    *
+ *  time. SquaringChain<N, HasScale, Z> performs the steps of the while loop  *
+ *  for the exponent N, one template per step, so that after inlining only    *
+ *  the complex multiplications are left. There is no modulus, no branch, and *
+ *  no counter. HasScale is false while scale is still 1, which lets us skip  *
+ *  the multiplication by 1 the loop does on the first odd bit.               *
+ *                                                                            *
+ *  The multiplications are done in the same order as the loop, so the result *
+ *  is identical to exp_by_squaring(z, N). For N > 1 this takes               *
+ *  floor(log2(N)) squarings and one multiplication per extra 1 bit of N.     *
+ *  This is the fewest possible for every N below 15.                         */
+template <int N, bool HasScale, typename Z>
+struct SquaringChain {
+    static constexpr Z evaluate(Z output, Z scale) noexcept
+    {
+        /*  The first odd bit sets scale = output, later ones multiply.       */
+        const bool odd = (N % 2) == 1;
+
+        if (odd)
+        {
+            if (HasScale)
+                scale *= output;
+            else
+                scale = output;
+        }
+
+        /*  Square and move on to the next bit of N.                          */
+        output *= output;
+        return SquaringChain<N / 2, HasScale || odd, Z>::evaluate(
+            output, scale
+        );
+    }
+};
+
+/*  n is now 1. The final output is output * scale, as in the loop.           */
+template <bool HasScale, typename Z>
+struct SquaringChain<1, HasScale, Z> {
+    static constexpr Z evaluate(Z output, Z scale) noexcept
+    {
+        return (HasScale ? output * scale : output);
+    }
+};
+
+/*  z^0 = 1, by definition.                                                   */
+template <bool HasScale, typename Z>
+struct SquaringChain<0, HasScale, Z> {
+    static constexpr Z evaluate(Z, Z) noexcept
+    {
+        return Z(1.0, 0.0);
+    }
+};
+
+/*  Computes z^N for an exponent N known at compile time. Negative powers use *
+ *  z^N = (1 / z)^(-N), as in the loop, and are reduced to positive. The      *
+ *  runtime exp_by_squaring(z, n) above is still used whenever n is only      *
+ *  known while the program runs.                                             */
+template <int N, typename Arithmetic>
+constexpr BasicComplex<Arithmetic>
+exp_by_squaring(BasicComplex<Arithmetic> z) noexcept
+{
+    /*  The absolute value of N, which is the length of the chain.            */
+    typedef BasicComplex<Arithmetic> Z;
+    const int length = (N < 0 ? -N : N);
+
+    if (N < 0)
+        return SquaringChain<length, false, Z>::evaluate(
+            Arithmetic::reciprocal(z), Z(1.0, 0.0)
+        );
+
+    return SquaringChain<length, false, Z>::evaluate(z, Z(1.0, 0.0));
+}
+
+/*  The same for std::complex, using StandardArithmetic by default.           */
+template <int N, typename Arithmetic = StandardArithmetic>
+std::complex<double>
+exp_by_squaring(std::complex<double> z, Arithmetic = Arithmetic())
+{
+    return exp_by_squaring<N>(BasicComplex<Arithmetic>(z));
+}
+
+/*  The "^" operator, now that exp_by_squaring has been defined.              */
+template <typename Arithmetic>
+constexpr BasicComplex<Arithmetic>
+BasicComplex<Arithmetic>::operator ^ (int n) const noexcept
+{
+    return exp_by_squaring(*this, n);
+}
+
+template <typename Arithmetic>
+template <int N>
+constexpr BasicComplex<Arithmetic>
+BasicComplex<Arithmetic>::operator ^ (Exponent<N>) const noexcept
+{
+    return exp_by_squaring<N>(*this);
+}
+
+/*  For large |n|, z^n overflows to infinity or underflows to zero long       *
+ *  before anything interesting happens to the answer. (1.5 + 2i)^1000 is     *
+ *  already larger than the largest double. ScaledPower stores the result as  *
+ *  mantissa * 2^exponent, where the larger part of the mantissa is between   *
+ *  1/2 and 1 in magnitude, and the exponent is a 64-bit integer. This can    *
+ *  hold z^n for any double z and int n.                                      */
+template <typename Arithmetic>
+struct ScaledPower {
+    BasicComplex<Arithmetic> mantissa;
+    long long int exponent;
+
+    /*  The value mantissa * 2^exponent as an ordinary complex number. This   *
+     *  is infinite or zero if it does not fit in a double.                   */
+    BasicComplex<Arithmetic> value(void) const
+    {
+        /*  std::ldexp takes an int. Anything beyond +-4096 is out of range   *
+         *  for a double anyway, so clamp the exponent there.                 *
+         *  The mantissa is at most 1, so 2^4096 is already infinite.         */
+        const long long int limit = 4096;
+        const int shift = static_cast<int>(
+            exponent > limit ? limit : (exponent < -limit ? -limit : exponent)
+        );
+
+        return BasicComplex<Arithmetic>(
+            std::ldexp(mantissa.real(), shift),
+            std::ldexp(mantissa.imag(), shift)
+        );
+    }
+
+    /*  The natural log of the absolute value, log|w| = log|mantissa| +       *
+     *  exponent log(2). This is what callers working in log-polar form need, *
+     *  and it does not overflow.                                             */
+    double log_abs(void) const
+    {
+        const double ln_2 = 0.6931471805599453;
+        return 0.5 * std::log(abs_squared(mantissa)) +
+               static_cast<double>(exponent) * ln_2;
+    }
+
+    /*  Rescales so that the larger part of the mantissa is between 1/2 and 1 *
+     *  in magnitude. The scaling is by a power of two, so it is exact, and   *
+     *  the value is unchanged. Zero, infinity, and NaN are left alone.       */
+    void normalize(void)
+    {
+        /*  The exponent of the larger of the two parts.                      */
+        const double real = std::fabs(mantissa.real());
+        const double imag = std::fabs(mantissa.imag());
+        const double largest = (real < imag ? imag : real);
+        int shift;
+
+        if (largest == 0.0 || !std::isfinite(largest))
+            return;
+
+        std::frexp(largest, &shift);
+
+        mantissa = BasicComplex<Arithmetic>(
+            std::ldexp(mantissa.real(), -shift),
+            std::ldexp(mantissa.imag(), -shift)
+        );
+
+        exponent += shift;
+    }
+};
+
+/*  Computes z^n with the same steps as exp_by_squaring, but the output and   *
+ *  the scale factor are each kept as a mantissa and a binary exponent, and   *
+ *  rescaled after every multiplication. Products of mantissas are at most 2  *
+ *  in each part, so nothing overflows, and the exponents are simply added.   *
+ *  This is one O(log n) pass, with no need to retry in log-polar form. The   *
+ *  rounding error is the same as for exp_by_squaring, roughly |n| times      *
+ *  double precision relative to |z^n|.                                       */
+template <typename Arithmetic>
+ScaledPower<Arithmetic>
+scaled_exp_by_squaring(BasicComplex<Arithmetic> z, int n)
+{
+    /*  Start with out = z, and the scale factor equal to 1, as before. The   *
+     *  exponent of n is kept in a long long so that -n can not overflow.     */
+    ScaledPower<Arithmetic> output = {z, 0};
+    ScaledPower<Arithmetic> scale = {BasicComplex<Arithmetic>(1.0, 0.0), 0};
+    long long int power = n;
+
+    output.normalize();
+
+    /*  Special case. If n = 0, then z^0 = 1, by definition. Return 1.        */
+    if (power == 0)
+        return scale;
+
+    /*  For negative powers use z^n = (1 / z)^(-n). Since the mantissa is     *
+     *  normalized, its reciprocal can not overflow, and 1 / 2^e = 2^-e.      */
+    if (power < 0)
+    {
+        output.mantissa = Arithmetic::reciprocal(output.mantissa);
+        output.exponent = -output.exponent;
+        output.normalize();
+        power = -power;
+    }
+
+    /*  The same loop as exp_by_squaring, rescaling as we go.                 */
+    while (power > 1)
+    {
+        if ((power % 2) == 1)
+        {
+            scale.mantissa *= output.mantissa;
+            scale.exponent += output.exponent;
+            scale.normalize();
+            --power;
+        }
+
+        /*  power is now even. Square the output and halve the power.         */
+        output.mantissa *= output.mantissa;
+        output.exponent *= 2;
+        output.normalize();
+        power >>= 1;
+    }
+
+    /*  power is now 1. The final output is output * scale.                   */
+    output.mantissa *= scale.mantissa;
+    output.exponent += scale.exponent;
+    output.normalize();
+    return output;
+}
+
+/*  The batched routine below works on several complex numbers at once. The   *
+ *  real parts are in one array and the imaginary parts in another            *
+ *  (structure-of-arrays), so that a vector register holds the real parts of  *
+ *  several numbers, and a complex multiplication is four vector multiplies   *
+ *  and two vector additions. BatchArithmetic wraps the vector instructions,  *
+ *  and has versions for a plain double as well, so that the squaring chain   *
+ *  is written once for both. They are static members of a struct, rather     *
+ *  than free functions, so that short names like add and multiply do not     *
+ *  leak into the code that includes this file.                               */
+struct BatchArithmetic {
+
+    /*  Versions for a single double, used for the numbers left over.         */
+    static double add(double x, double y) { return x + y; }
+    static double subtract(double x, double y) { return x - y; }
+    static double multiply(double x, double y) { return x * y; }
+    static double divide(double x, double y) { return x / y; }
+    static double negate(double x) { return -x; }
+
+#if defined(__AVX512F__)
+
+    /*  Eight doubles fit in a 512-bit AVX-512 register.                      */
+    typedef __m512d vector_double;
+    static const std::size_t complex_lanes = 8;
+
+    static vector_double load(const double *x)
+    {
+        return _mm512_loadu_pd(x);
+    }
+
+    static void store(double *x, vector_double v)
+    {
+        _mm512_storeu_pd(x, v);
+    }
+
+    static vector_double broadcast(double x)
+    {
+        return _mm512_set1_pd(x);
+    }
+
+    static vector_double add(vector_double x, vector_double y)
+    {
+        return _mm512_add_pd(x, y);
+    }
+
+    static vector_double subtract(vector_double x, vector_double y)
+    {
+        return _mm512_sub_pd(x, y);
+    }
+
+    static vector_double multiply(vector_double x, vector_double y)
+    {
+        return _mm512_mul_pd(x, y);
+    }
+
+    static vector_double divide(vector_double x, vector_double y)
+    {
+        return _mm512_div_pd(x, y);
+    }
+
+    static vector_double negate(vector_double x)
+    {
+        return _mm512_castsi512_pd(
+            _mm512_xor_si512(
+                _mm512_castpd_si512(x),
+                _mm512_castpd_si512(_mm512_set1_pd(-0.0))
+            )
+        );
+    }
+
+#elif defined(__AVX__)
+
+    /*  Four doubles fit in a 256-bit AVX register.                           */
+    typedef __m256d vector_double;
+    static const std::size_t complex_lanes = 4;
+
+    static vector_double load(const double *x)
+    {
+        return _mm256_loadu_pd(x);
+    }
+
+    static void store(double *x, vector_double v)
+    {
+        _mm256_storeu_pd(x, v);
+    }
+
+    static vector_double broadcast(double x)
+    {
+        return _mm256_set1_pd(x);
+    }
+
+    static vector_double add(vector_double x, vector_double y)
+    {
+        return _mm256_add_pd(x, y);
+    }
+
+    static vector_double subtract(vector_double x, vector_double y)
+    {
+        return _mm256_sub_pd(x, y);
+    }
+
+    static vector_double multiply(vector_double x, vector_double y)
+    {
+        return _mm256_mul_pd(x, y);
+    }
+
+    static vector_double divide(vector_double x, vector_double y)
+    {
+        return _mm256_div_pd(x, y);
+    }
+
+    static vector_double negate(vector_double x)
+    {
+        return _mm256_xor_pd(x, _mm256_set1_pd(-0.0));
+    }
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+    /*  Two doubles fit in a 128-bit NEON register.                           */
+    typedef float64x2_t vector_double;
+    static const std::size_t complex_lanes = 2;
+
+    static vector_double load(const double *x)
+    {
+        return vld1q_f64(x);
+    }
+
+    static void store(double *x, vector_double v)
+    {
+        vst1q_f64(x, v);
+    }
+
+    static vector_double broadcast(double x)
+    {
+        return vdupq_n_f64(x);
+    }
+
+    static vector_double add(vector_double x, vector_double y)
+    {
+        return vaddq_f64(x, y);
+    }
+
+    static vector_double subtract(vector_double x, vector_double y)
+    {
+        return vsubq_f64(x, y);
+    }
+
+    static vector_double multiply(vector_double x, vector_double y)
+    {
+        return vmulq_f64(x, y);
+    }
+
+    static vector_double divide(vector_double x, vector_double y)
+    {
+        return vdivq_f64(x, y);
+    }
+
+    static vector_double negate(vector_double x)
+    {
+        return vnegq_f64(x);
+    }
+
+#else
+
+    /*  No vector instructions. The scalar loop does all of the work.         */
+    static const std::size_t complex_lanes = 1;
+
+#endif
+
+    /*  Computes (re + i im)^n in place, with the same steps as               *
+     *  exp_by_squaring(z, n). Vector is either double, or a vector of        *
+     *  doubles, in which case every lane is raised to the same power. Since  *
+     *  n is shared, every lane takes the same path through the loop, and     *
+     *  there is nothing to mask. n must be non-zero, z^0 = 1 is handled by   *
+     *  the caller.                                                           *
+     *                                                                        *
+     *  The multiplication is the textbook one, (a + ib)(c + id) = (ac - bd)  *
+     *  + i(ad + bc), and 1 / (a + ib) = (a - ib) / (a^2 + b^2). Unlike       *
+     *  std::complex, there is no extra work to recover from infinities and   *
+     *  NaN's, and 1 / z overflows if |z| is larger than about 10^154.        */
+    template <typename Vector>
+    static void squaring_chain(Vector &re, Vector &im, int n)
+    {
+        /*  The scale factor for odd powers. It is 1 until the first odd bit, *
+         *  which we track with a flag instead of multiplying by 1.           */
+        Vector scale_re = re;
+        Vector scale_im = im;
+        bool has_scale = false;
+
+        /*  For negative powers use z^n = (1 / z)^(-n) to reduce n to         *
+         *  positive.                                                         */
+        if (n < 0)
+        {
+            const Vector denominator = add(multiply(re, re), multiply(im, im));
+            re = divide(re, denominator);
+            im = negate(divide(im, denominator));
+            n = -n;
+        }
+
+        /*  Same loop as exp_by_squaring, with the multiplications written    *
+         *  out.                                                              */
+        while (n > 1)
+        {
+            if ((n % 2) == 1)
+            {
+                if (has_scale)
+                {
+                    const Vector t = subtract(
+                        multiply(scale_re, re), multiply(scale_im, im)
+                    );
+
+                    scale_im = add(
+                        multiply(scale_re, im), multiply(scale_im, re)
+                    );
+
+                    scale_re = t;
+                }
+
+                else
+                {
+                    scale_re = re;
+                    scale_im = im;
+                    has_scale = true;
+                }
+
+                --n;
+            }
+
+            /*  n is now even. Square the output and divide n by two.         */
+            const Vector square_re = subtract(
+                multiply(re, re), multiply(im, im)
+            );
+
+            im = add(multiply(re, im), multiply(im, re));
+            re = square_re;
+            n >>= 1;
+        }
+
+        /*  n is now 1. The final output is output * scale.                   */
+        if (has_scale)
+        {
+            const Vector t = subtract(
+                multiply(re, scale_re), multiply(im, scale_im)
+            );
+
+            im = add(multiply(re, scale_im), multiply(im, scale_re));
+            re = t;
+        }
+    }
+};
+/*  End of BatchArithmetic definition.                                        */
+
+/*  Computes (real[k] + i imag[k])^n for 0 <= k < length, and stores the      *
+ *  result in real_out and imag_out. The output arrays may be the same as the *
+ *  input arrays. As many numbers as possible are done a full vector at a     *
+ *  time, and the rest one at a time. The two give the same result, since the *
+ *  steps are identical, as long as the compiler does not fuse multiplies and *
+ *  adds differently in the two loops (use -ffp-contract=off to be sure).     *
+ *                                                                            *
+ *  For finite results this is identical to z ^ n for n >= 0. For n < 0 the   *
+ *  reciprocal is computed differently than std::complex does, and the two    *
+ *  can differ in the last bit or so. The arithmetic is the same as           *
+ *  PlainArithmetic, so the result is always identical to FastComplex ^ n.    */
+inline void exp_by_squaring(const double * const real,
+                            const double * const imag,
+                            double * const real_out,
+                            double * const imag_out,
+                            std::size_t length,
+                            int n)
+{
+    /*  Index for the numbers.                                                */
+    std::size_t index = 0;
+
+    /*  Special case. If n = 0, then z^0 = 1, by definition.                  */
+    if (n == 0)
+    {
+        for (index = 0; index < length; ++index)
+        {
+            real_out[index] = 1.0;
+            imag_out[index] = 0.0;
+        }
+
+        return;
+    }
+
+#if defined(__AVX512F__) || defined(__AVX__) || \
+    (defined(__ARM_NEON) && defined(__aarch64__))
+
+    /*  The end of the full vectors.                                          */
+    const std::size_t end = length - length % BatchArithmetic::complex_lanes;
+
+    for (; index < end; index += BatchArithmetic::complex_lanes)
+    {
+        BatchArithmetic::vector_double re =
+            BatchArithmetic::load(real + index);
+        BatchArithmetic::vector_double im =
+            BatchArithmetic::load(imag + index);
+        BatchArithmetic::squaring_chain(re, im, n);
+        BatchArithmetic::store(real_out + index, re);
+        BatchArithmetic::store(imag_out + index, im);
+    }
+
+#endif
+
+    /*  The numbers left over, one at a time.                                 */
+    for (; index < length; ++index)
+    {
+        double re = real[index];
+        double im = imag[index];
+        BatchArithmetic::squaring_chain(re, im, n);
+        real_out[index] = re;
+        imag_out[index] = im;
+    }
+}
+/*  End of exp_by_squaring.                                                   */
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,331 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Finds all of the roots of many low degree polynomials at once.        *
+ *  Notes:                                                                    *
+ *      The solver is in polynomial_roots.hpp. This file shows how to use it, *
+ *      and times it on a large batch of quadratics like 2 - x^2, the problem *
+ *      solved by herons_method.cpp and steffensens_method.cpp.               *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/09/06                                                        *
+ ******************************************************************************/
+
+/*  stdio provides the "printf" function, used for printing text.             */
+#include <cstdio>
+
+/*  sqrt, for checking the roots of the quadratics, is found here.            */
+#include <cmath>
+
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  std::uint64_t, used by the random number generator, is found here.        */
+#include <cstdint>
+
+/*  std::vector, for the coefficients and roots of the batches.               */
+#include <vector>
+
+/*  Timing routines, used for benchmarking the batched routine.               */
+#include <chrono>
+
+/*  The root finder itself, in PolynomialRoots.                               */
+#include "polynomial_roots.hpp"
+
+/*  A simple random number generator, a linear congruential generator. This   *
+ *  gives the same numbers on every platform, unlike std::rand, so the output *
+ *  below is the same everywhere. Returns a number in [-1, 1).                */
+static double random_real(std::uint64_t &state)
+{
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<double>(state >> 11) * 0x1.0P-52 - 1.0;
+}
+/*  End of random_real.                                                       */
+
+/*  Computes |p(z)| / (|a_0| + |a_1| |z| + ... + |a_n| |z|^n) for one         *
+ *  polynomial in a batch. This is the relative residual, which is about the  *
+ *  precision of double for a root that is as accurate as the coefficients    *
+ *  allow.                                                                    */
+static double residual(const std::vector<double> &coefficients,
+                       unsigned int degree,
+                       std::size_t count,
+                       std::size_t m,
+                       const Complex &z)
+{
+    Complex p = coefficients[degree * count + m];
+    double size = std::fabs(coefficients[degree * count + m]);
+    const double z_size = std::sqrt(abs_squared(z));
+    unsigned int k;
+
+    for (k = degree; k-- > 0U;)
+    {
+        p = p * z + Complex(coefficients[k * count + m]);
+        size = size * z_size + std::fabs(coefficients[k * count + m]);
+    }
+
+    return std::sqrt(abs_squared(p)) / size;
+}
+/*  End of residual.                                                          */
+
+/*  Solves a batch of quadratics x^2 - c, for c between 1 and 4, both all at  *
+ *  once and one at a time, and prints the time per polynomial and the        *
+ *  largest error.                                                            */
+static void benchmark_quadratics(void)
+{
+    /*  The number of polynomials, and the number of times the batch is       *
+     *  solved, to get a stable time.                                         */
+    const std::size_t count = 65536;
+    const unsigned int repeats = 10U;
+
+    /*  Coefficient k of polynomial m is at coefficients[k * count + m].      */
+    std::vector<double> coefficients(3 * count);
+    std::vector<double> real(2 * count), imag(2 * count);
+    std::vector<double> positive(count), values(count);
+    std::size_t m, failures = 0;
+    unsigned int n;
+    double worst = 0.0, worst_value = 0.0;
+
+    for (m = 0; m < count; ++m)
+    {
+        coefficients[m] = -(1.0 + 3.0 * static_cast<double>(m) / count);
+        coefficients[count + m] = 0.0;
+        coefficients[2 * count + m] = 1.0;
+    }
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for (n = 0U; n < repeats; ++n)
+        failures += PolynomialRoots::roots(
+            coefficients.data(), 2U, count, real.data(), imag.data()
+        );
+
+    const std::chrono::steady_clock::time_point batched_end =
+        std::chrono::steady_clock::now();
+
+    /*  The same polynomials one at a time, each with its coefficients stored *
+     *  together, as most code would have them.                               */
+    for (n = 0U; n < repeats; ++n)
+    {
+        for (m = 0; m < count; ++m)
+        {
+            const double a[3] = {coefficients[m], 0.0, 1.0};
+            Complex z[2];
+            failures += !PolynomialRoots::roots(a, 2U, z);
+            values[m] = z[0].real();
+        }
+    }
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    const double batched =
+        std::chrono::duration<double, std::nano>(batched_end - start).count();
+
+    const double single =
+        std::chrono::duration<double, std::nano>(end - batched_end).count();
+
+    /*  The roots are +/- sqrt(c), in some order. Compare against std::sqrt,  *
+     *  and check that the imaginary parts are tiny.                          */
+    for (m = 0; m < count; ++m)
+    {
+        const double root = std::sqrt(-coefficients[m]);
+        const std::size_t j = (real[m] > 0.0 ? 0 : count);
+
+        const double error = std::fabs(real[m + j] - root) / root +
+                             std::fabs(real[m + count - j] + root) / root +
+                             std::fabs(imag[m]) + std::fabs(imag[m + count]);
+
+        if (error > worst)
+            worst = error;
+
+        positive[m] = real[m + j];
+    }
+
+    /*  p at the positive root, with the vectorized Horner's method.          */
+    PolynomialRoots::evaluate(
+        coefficients.data(), 2U, count, positive.data(), values.data()
+    );
+
+    for (m = 0; m < count; ++m)
+        if (std::fabs(values[m]) > worst_value)
+            worst_value = std::fabs(values[m]);
+
+    std::printf("%lu quadratics x^2 - c, failures: %lu\n",
+                static_cast<unsigned long int>(count),
+                static_cast<unsigned long int>(failures));
+
+    std::printf("    largest error %.3E, largest |p(root)| %.3E\n",
+                worst, worst_value);
+
+    std::printf("    batched:    %6.2f ns/polynomial\n",
+                batched / (repeats * count));
+
+    std::printf("    one by one: %6.2f ns/polynomial\n",
+                single / (repeats * count));
+}
+/*  End of benchmark_quadratics.                                              */
+
+/*  Solves a batch of random polynomials of the given degree, with            *
+ *  coefficients in [-1, 1) and leading coefficient 1, and prints the largest *
+ *  relative residual.                                                        */
+static void random_polynomials(unsigned int degree)
+{
+    const std::size_t count = 10000;
+    std::vector<double> coefficients((degree + 1U) * count);
+    std::vector<double> real(degree * count), imag(degree * count);
+    std::uint64_t state = 1U;
+    double worst = 0.0;
+    std::size_t m, k;
+    unsigned int j;
+
+    for (k = 0; k < degree * count; ++k)
+        coefficients[k] = random_real(state);
+
+    for (m = 0; m < count; ++m)
+        coefficients[degree * count + m] = 1.0;
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    const std::size_t failures = PolynomialRoots::roots(
+        coefficients.data(), degree, count, real.data(), imag.data()
+    );
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(end - start).count();
+
+    for (m = 0; m < count; ++m)
+    {
+        for (j = 0U; j < degree; ++j)
+        {
+            const Complex z(real[j * count + m], imag[j * count + m]);
+            const double r = residual(coefficients, degree, count, m, z);
+
+            if (r > worst)
+                worst = r;
+        }
+    }
+
+    std::printf("degree %2u: failures: %lu, largest residual %.3E, "
+                "%.2f ns/polynomial\n",
+                degree, static_cast<unsigned long int>(failures), worst,
+                nanoseconds / count);
+}
+/*  End of random_polynomials.                                                */
+
+/*  Main routine used for testing our implementation of the Aberth iteration. */
+int main(void)
+{
+    /*  The coefficients of 2 - x^2, z^3 - 1, x^2, and 10^300 + 10^-300 x^2,  *
+     *  constant term first.                                                  */
+    const double quadratic[3] = {2.0, 0.0, -1.0};
+    const double cubic[4] = {-1.0, 0.0, 0.0, 1.0};
+    const double square[3] = {0.0, 0.0, 1.0};
+    const double wide[3] = {1.0E300, 0.0, 1.0E-300};
+    Complex roots[3];
+    unsigned int j;
+
+    /*  The roots of 2 - x^2 are +/- sqrt(2).                                 */
+    PolynomialRoots::roots(quadratic, 2U, roots);
+    std::printf("Roots of 2 - x^2:\n");
+
+    for (j = 0U; j < 2U; ++j)
+    {
+        std::printf("    ");
+        roots[j].print();
+    }
+
+    /*  The roots of z^3 - 1 are the cube roots of unity.                     */
+    PolynomialRoots::roots(cubic, 3U, roots);
+    std::printf("Roots of z^3 - 1:\n");
+
+    for (j = 0U; j < 3U; ++j)
+    {
+        std::printf("    ");
+        roots[j].print();
+    }
+
+    /*  Both roots of x^2 are zero. The corrections shrink with the roots,    *
+     *  so only an absolute tolerance can tell that the iteration is done.    */
+    const bool converged = PolynomialRoots::roots(square, 2U, roots);
+    const double size = abs_squared(roots[0]) + abs_squared(roots[1]);
+
+    std::printf("Roots of x^2, converged: %d, both below 1E-15: %s\n",
+                converged, (size < 1.0E-30 ? "Yes" : "No"));
+
+    /*  The roots are +/- 10^300 i, but 10^300 / 10^-300 is not a double.     */
+    PolynomialRoots::roots(wide, 2U, roots);
+    std::printf("Roots of 1E+300 + 1E-300 x^2:\n");
+
+    for (j = 0U; j < 2U; ++j)
+    {
+        std::printf("    ");
+        roots[j].print();
+    }
+
+    /*  Many quadratics at once.                                              */
+    benchmark_quadratics();
+
+    /*  Random polynomials of a few degrees. Almost all of their roots are    *
+     *  simple, and every one should converge.                                */
+    random_polynomials(3U);
+    random_polynomials(5U);
+    random_polynomials(8U);
+    random_polynomials(16U);
+
+    return 0;
+}
+
+/*  We can execute this on GNU, Linux, FreeBSD, macOS, etc., via:             *
+ *      c++ polynomial_roots.cpp -o main                                      *
+ *      ./main                                                                *
+ *  This will output the following:                                           *
+ *      Roots of 2 - x^2:                                                     *
+ *          1.4142135623730949E+00 + 0.0000000000000000E+00*i                 *
+ *          -1.4142135623730949E+00 + 0.0000000000000000E+00*i                *
+ *      Roots of z^3 - 1:                                                     *
+ *          1.0000000000000000E+00 + 0.0000000000000000E+00*i                 *
+ *          -5.0000000000000000E-01 + 8.6602540378443871E-01*i                *
+ *          -5.0000000000000000E-01 + -8.6602540378443860E-01*i               *
+ *      Roots of x^2, converged: 1, both below 1E-15: Yes                     *
+ *      Roots of 1E+300 + 1E-300 x^2:                                         *
+ *          0.0000000000000000E+00 + 1.0000000000000001E+300*i                *
+ *          0.0000000000000000E+00 + -1.0000000000000001E+300*i               *
+ *      65536 quadratics x^2 - c, failures: 0                                 *
+ *          largest error 5.878E-16, largest |p(root)| 1.332E-15              *
+ *  followed by the times for the batched and the one by one versions, and    *
+ *  one line for each random degree, all with 0 failures and residuals near   *
+ *  1E-15. The times depend on the machine. The last digits of the roots may  *
+ *  differ too, since the vector instructions round in a different order.     *
+ *  Without options the compiler only uses the instructions every x86-64      *
+ *  processor has, and PolynomialRoots works on plain doubles. To use AVX or  *
+ *  AVX-512, compile with                                                     *
+ *      c++ -O3 -march=native polynomial_roots.cpp -o main                    *
+ *  On a machine with AVX-512 this is about three times faster.               *
+ *                                                                            *
+ *  On Windows you will need to install a C++ compiler. Microsoft's MSVC is a *
+ *  common option. Using MSVC, type:                                          *
+ *      cl /std:c++17 /O2 polynomial_roots.cpp /link /out:main.exe            *
+ *      main.exe                                                              *
+ *  This will produce the same output.                                        */
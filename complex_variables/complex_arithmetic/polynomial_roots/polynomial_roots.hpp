@@ -0,0 +1,745 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Header-only batched root finder for many polynomials of the same low  *
+ *      degree, using Horner's method and the Aberth iteration.               *
+ *  Notes:                                                                    *
+ *      The coefficients are given as a structure of arrays, so that one      *
+ *      vector register holds the same coefficient of several polynomials,    *
+ *      and all of them are solved at once. The complex numbers and           *
+ *      exp_by_squaring come from exponentiating_by_squaring.hpp.             *
+ *      polynomial_roots.cpp shows how it is used.                            *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/09/06                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_POLYNOMIAL_ROOTS_HPP
+#define MITX_POLYNOMIAL_ROOTS_HPP
+
+/*  fabs, sqrt, pow, cos, sin, frexp, and ldexp are found here.               */
+#include <cmath>
+
+/*  std::numeric_limits, used for the precision of double, found here.        */
+#include <limits>
+
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  Complex, exp_by_squaring, and the vector instructions in BatchArithmetic. */
+#include "../exponentiating_by_squaring/exponentiating_by_squaring.hpp"
+
+/*  GCC warns that the alignment attributes of __m512d and __m256d are        *
+ *  dropped when they are used as template arguments, as in Lanes below. Only *
+ *  the type matters there, the alignment of the arrays in Lanes comes from   *
+ *  the vector type itself, so the warning is turned off for this header.     */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+#endif
+
+/*  Finds every root of many polynomials of the same degree n at once,        *
+ *                                                                            *
+ *        p(x) = a_0 + a_1 x + a_2 x^2 + ... + a_n x^n.                       *
+ *                                                                            *
+ *  The coefficients are real, and the roots are complex. The coefficients    *
+ *  are stored as a structure of arrays: coefficient k of polynomial m is at  *
+ *  coefficients[k * count + m], where count is the number of polynomials.    *
+ *  The roots are stored the same way, root j of polynomial m at real[j *     *
+ *  count + m] and imag[j * count + m]. A vector register then holds the same *
+ *  coefficient, or the same root, of neighbouring polynomials, and every     *
+ *  vector instruction works on that many polynomials.                        *
+ *                                                                            *
+ *  The roots are found with the Aberth iteration, which improves all n roots *
+ *  at the same time. With w_j = p(z_j) / p'(z_j), the Newton step for root   *
+ *  j, the update is                                                          *
+ *                                                                            *
+ *        z_j <- z_j - w_j / (1 - w_j S_j),                                   *
+ *        S_j  = sum over k != j of 1 / (z_j - z_k).                          *
+ *                                                                            *
+ *  The sum pushes the approximations apart, so that they do not all converge *
+ *  to the same root. The convergence is cubic for simple roots, and linear   *
+ *  for repeated ones. p(z_j) and p'(z_j) are computed together with Horner's *
+ *  method.                                                                   *
+ *                                                                            *
+ *  Every polynomial in a vector takes the same number of steps, the number   *
+ *  the slowest one needs, since the lanes of a register can not branch       *
+ *  separately. Polynomials that are already done simply take a few more      *
+ *  steps that do not change them.                                            */
+class PolynomialRoots {
+
+    /*  Count vectors of doubles, in which each lane belongs to a different   *
+     *  polynomial, with the usual arithmetic operators. Vector is either     *
+     *  double or BatchArithmetic::vector_double. The operators make the      *
+     *  Aberth step readable, and the compiler removes the wrapper and the    *
+     *  loops entirely.                                                       *
+     *                                                                        *
+     *  Each step of the Aberth iteration waits on the one before it, and the *
+     *  divisions in particular take many cycles before the result is ready.  *
+     *  A single vector keeps the processor mostly idle. With several         *
+     *  independent vectors, here Count of them, the processor works on all   *
+     *  of them while it waits.                                               */
+    template <typename Vector, unsigned int Count>
+    struct Lanes {
+        Vector v[Count];
+
+        friend Lanes operator + (const Lanes &x, const Lanes &y)
+        {
+            Lanes z;
+            unsigned int n;
+
+            for (n = 0U; n < Count; ++n)
+                z.v[n] = BatchArithmetic::add(x.v[n], y.v[n]);
+
+            return z;
+        }
+
+        friend Lanes operator - (const Lanes &x, const Lanes &y)
+        {
+            Lanes z;
+            unsigned int n;
+
+            for (n = 0U; n < Count; ++n)
+                z.v[n] = BatchArithmetic::subtract(x.v[n], y.v[n]);
+
+            return z;
+        }
+
+        friend Lanes operator - (const Lanes &x)
+        {
+            Lanes z;
+            unsigned int n;
+
+            for (n = 0U; n < Count; ++n)
+                z.v[n] = BatchArithmetic::negate(x.v[n]);
+
+            return z;
+        }
+
+        friend Lanes operator * (const Lanes &x, const Lanes &y)
+        {
+            Lanes z;
+            unsigned int n;
+
+            for (n = 0U; n < Count; ++n)
+                z.v[n] = BatchArithmetic::multiply(x.v[n], y.v[n]);
+
+            return z;
+        }
+
+        friend Lanes operator / (const Lanes &x, const Lanes &y)
+        {
+            Lanes z;
+            unsigned int n;
+
+            for (n = 0U; n < Count; ++n)
+                z.v[n] = BatchArithmetic::divide(x.v[n], y.v[n]);
+
+            return z;
+        }
+    };
+
+    /*  Loading, storing, and setting every lane to one value, for a single   *
+     *  double. The second argument of load and broadcast only selects the    *
+     *  type.                                                                 */
+    static double load(const double *x, double)
+    {
+        return *x;
+    }
+
+    static void store(double *x, double y)
+    {
+        *x = y;
+    }
+
+    static double broadcast(double x, double)
+    {
+        return x;
+    }
+
+#if defined(__AVX512F__) || defined(__AVX__) || \
+    (defined(__ARM_NEON) && defined(__aarch64__))
+
+    /*  The same for a vector.                                                */
+    typedef BatchArithmetic::vector_double vector_double;
+
+    static vector_double load(const double *x, vector_double)
+    {
+        return BatchArithmetic::load(x);
+    }
+
+    static void store(double *x, vector_double y)
+    {
+        BatchArithmetic::store(x, y);
+    }
+
+    static vector_double broadcast(double x, vector_double)
+    {
+        return BatchArithmetic::broadcast(x);
+    }
+
+#else
+
+    /*  No vector instructions. Groups of plain doubles still let the         *
+     *  processor work on several polynomials at once.                        */
+    typedef double vector_double;
+
+#endif
+
+    /*  The number of vectors in a group, the Count used for all but the last *
+     *  few polynomials of a batch.                                           */
+    static const unsigned int group = 2U;
+
+    /*  The number of polynomials held by Count Vectors.                      */
+    template <typename Vector, unsigned int Count>
+    static constexpr std::size_t lanes(void)
+    {
+        return Count * (sizeof(Vector) / sizeof(double));
+    }
+
+    /*  The same operations for Count Vectors. The lanes are consecutive in   *
+     *  memory, so the vectors are too.                                       */
+    template <typename Vector, unsigned int Count>
+    static Lanes<Vector, Count> load(const double *x)
+    {
+        const std::size_t width = lanes<Vector, 1U>();
+        Lanes<Vector, Count> y;
+        unsigned int n;
+
+        for (n = 0U; n < Count; ++n)
+            y.v[n] = load(x + n * width, Vector());
+
+        return y;
+    }
+
+    template <typename Vector, unsigned int Count>
+    static void store(double *x, const Lanes<Vector, Count> &y)
+    {
+        const std::size_t width = lanes<Vector, 1U>();
+        unsigned int n;
+
+        for (n = 0U; n < Count; ++n)
+            store(x + n * width, y.v[n]);
+    }
+
+    template <typename Vector, unsigned int Count>
+    static Lanes<Vector, Count> broadcast(double x)
+    {
+        Lanes<Vector, Count> y;
+        unsigned int n;
+
+        for (n = 0U; n < Count; ++n)
+            y.v[n] = broadcast(x, Vector());
+
+        return y;
+    }
+
+    /*  x^(1/m) for x >= 0. The square root is far cheaper than pow, and      *
+     *  quadratics are the common case.                                       */
+    static double root_of(double x, unsigned int m)
+    {
+        if (m == 1U)
+            return x;
+
+        if (m == 2U)
+            return std::sqrt(x);
+
+        return std::pow(x, 1.0 / static_cast<double>(m));
+    }
+    /*  End of root_of.                                                       */
+
+    /*  |x / y|^(1/m), without forming x / y, which may overflow or underflow *
+     *  even when the root does not. With x = u 2^e and y = v 2^f, and e - f  *
+     *  = q m + s for 0 <= s < m, this is |u / v 2^s|^(1/m) 2^q, and the      *
+     *  number under the root is between 1/2 and 2^m.                         */
+    static double ratio_root(double x, double y, unsigned int m)
+    {
+        const int width = static_cast<int>(m);
+        int e, f;
+        const double u = std::frexp(x, &e);
+        const double v = std::frexp(y, &f);
+        int q = (e - f) / width;
+        int s = (e - f) - q * width;
+
+        /*  Integer division rounds towards zero, we want the floor.          */
+        if (s < 0)
+        {
+            s += width;
+            --q;
+        }
+
+        return std::ldexp(root_of(std::fabs(std::ldexp(u / v, s)), m), q);
+    }
+    /*  End of ratio_root.                                                    */
+
+    /*  (x / y) r^-m, again without the overflow of x / y or r^-m alone. The  *
+     *  fractions of x, y, and r are between 1/2 and 1, so the fractional     *
+     *  part below is at most 2^(m+1), and the exponent is applied once, at   *
+     *  the end.                                                              */
+    static double scaled_ratio(double x, double y, double r, unsigned int m)
+    {
+        int e, f, g;
+        const double u = std::frexp(x, &e);
+        const double v = std::frexp(y, &f);
+        const double w = std::frexp(r, &g);
+        double fraction = u / v;
+        unsigned int k;
+
+        for (k = 0U; k < m; ++k)
+            fraction /= w;
+
+        return std::ldexp(fraction, e - f - static_cast<int>(m) * g);
+    }
+    /*  End of scaled_ratio.                                                  */
+
+    /*  The starting radius for one polynomial, max |a_k / a_n|^(1/(n-k))     *
+     *  over k < n. Every root has absolute value less than twice this        *
+     *  (Fujiwara's bound), and the largest is at least this divided by n, so *
+     *  circles of this radius start close to the roots. If every other       *
+     *  coefficient is zero, all roots are zero, and we start on the unit     *
+     *  circle instead. If a_n is subnormal, or some nonzero a_k / a_n is     *
+     *  outside the normal range of double, that bound is computed with       *
+     *  ratio_root, and wide is set. The radius can then only overflow if the *
+     *  largest root of p is within a factor of n of the largest double.      */
+    static double radius(const double *coefficients,
+                         std::size_t stride,
+                         unsigned int degree,
+                         bool &wide)
+    {
+        const double smallest = std::numeric_limits<double>::min();
+        const double biggest = 0.5 * std::numeric_limits<double>::max();
+        const double leading = std::fabs(coefficients[degree * stride]);
+        double largest = 0.0;
+        unsigned int k;
+
+        if (!(leading >= smallest))
+            wide = true;
+
+        for (k = 0U; k < degree; ++k)
+        {
+            const double a = std::fabs(coefficients[k * stride]);
+            const double ratio = a / leading;
+            double bound;
+
+            if (a == 0.0 || (ratio >= smallest && ratio <= biggest))
+                bound = root_of(ratio, degree - k);
+            else
+            {
+                bound = ratio_root(a, leading, degree - k);
+                wide = true;
+            }
+
+            if (bound > largest)
+                largest = bound;
+        }
+
+        return (largest == 0.0 ? 1.0 : largest);
+    }
+    /*  End of radius.                                                        */
+
+    /*  Solves lanes<Vector, Count>() polynomials at once. coefficients       *
+     *  points at the first coefficient of the first polynomial, and          *
+     *  coefficient k of the polynomial in lane l is at coefficients[k *      *
+     *  stride + l]. The roots are written the same way, with root_stride.    *
+     *  unit holds the starting points on the unit circle. Returns the number *
+     *  of polynomials that had not converged after the last step.            */
+    template <typename Vector, unsigned int Count>
+    static std::size_t solve(const double *coefficients,
+                             std::size_t stride,
+                             unsigned int degree,
+                             const Complex *unit,
+                             double *real,
+                             double *imag,
+                             std::size_t root_stride)
+    {
+        /*  The number of polynomials, one per lane.                          */
+        constexpr std::size_t number_of_lanes = lanes<Vector, Count>();
+        typedef Lanes<Vector, Count> Pack;
+
+        /*  The scaled coefficients, and the approximations to the roots.     */
+        Pack a[maximum_degree + 1U];
+        Pack re[maximum_degree];
+        Pack im[maximum_degree];
+
+        /*  Per lane values, read and written by the scalar code.             */
+        double start[number_of_lanes];
+        double scaled[number_of_lanes];
+        double corrections[number_of_lanes];
+        double sizes[number_of_lanes];
+
+        /*  Constants in every lane.                                          */
+        const Pack zero = broadcast<Vector, Count>(0.0);
+        const Pack one = broadcast<Vector, Count>(1.0);
+
+        /*  The tolerance on the sum of squared corrections, relative to the  *
+         *  sum of |z_j|^2. This is the precision of double, so the           *
+         *  corrections are below about 10^-8 relative to the roots. Near a   *
+         *  simple root the error after a step is at most about the square of *
+         *  the correction, so the roots then already have full precision,    *
+         *  and waiting for the corrections themselves to reach 10^-16 would  *
+         *  cost another step. At a repeated root the convergence is only     *
+         *  linear, but such roots are only determined to about 10^-8 by the  *
+         *  coefficients anyway.                                              */
+        const double tolerance = std::numeric_limits<double>::epsilon();
+
+        /*  An absolute floor for the sum of |z_j|^2. If every root is zero,  *
+         *  as for x^2, the sum goes to zero with the corrections, and the    *
+         *  relative test could never pass. The scaled roots are less than 2  *
+         *  in size, and a correction of about the precision of double,       *
+         *  relative to the radius r, can not be told apart from zero.        */
+        const double smallest = tolerance;
+
+        unsigned int iteration, j, k;
+        std::size_t lane, failures = 0;
+        bool wide = false;
+
+        /*  The radius r of every lane, see the radius function.              */
+        for (lane = 0; lane < number_of_lanes; ++lane)
+            start[lane] = radius(coefficients + lane, stride, degree, wide);
+
+        const Pack r = load<Vector, Count>(start);
+        const Pack inverse = one / r;
+
+        /*  We solve q(y) = p(r y) / (a_n r^n) instead of p. Its roots are    *
+         *  those of p divided by r, so they are less than 2 in size, and     *
+         *  none of the products below can overflow or underflow, no matter   *
+         *  how large or small the roots of p are, as long as r is finite.    *
+         *  The coefficients of q are (a_k / a_n) r^(k - n), and these are at *
+         *  most 1. The power of r is applied one factor at a time, since     *
+         *  r^(k - n) on its own may underflow even though the coefficient    *
+         *  does not. The partial products then lie between a_k / a_n and the *
+         *  coefficient, so they are safe whenever a_k / a_n is. If it is not *
+         *  in some lane, scaled_ratio works with the exponents instead, one  *
+         *  lane at a time, which is slower but can not overflow.             */
+        if (!wide)
+        {
+            const Pack leading =
+                one / load<Vector, Count>(coefficients + degree * stride);
+
+            for (k = 0U; k < degree; ++k)
+            {
+                a[k] = load<Vector, Count>(coefficients + k * stride) *
+                       leading;
+
+                for (j = k; j < degree; ++j)
+                    a[k] = a[k] * inverse;
+            }
+        }
+        else
+        {
+            for (k = 0U; k < degree; ++k)
+            {
+                for (lane = 0; lane < number_of_lanes; ++lane)
+                    scaled[lane] =
+                        scaled_ratio(coefficients[k * stride + lane],
+                                     coefficients[degree * stride + lane],
+                                     start[lane], degree - k);
+
+                a[k] = load<Vector, Count>(scaled);
+            }
+        }
+
+        a[degree] = one;
+
+        for (j = 0U; j < degree; ++j)
+        {
+            re[j] = broadcast<Vector, Count>(unit[j].real());
+            im[j] = broadcast<Vector, Count>(unit[j].imag());
+        }
+
+        for (iteration = 0U; iteration < maximum_number_of_iterations;
+             ++iteration)
+        {
+            /*  The sizes of the corrections and of the roots, summed over j. *
+             *  These decide when to stop.                                    */
+            Pack correction_size = zero;
+            Pack root_size = zero;
+
+            for (j = 0U; j < degree; ++j)
+            {
+                /*  Horner's method for q(z_j), and its derivative. p = p z + *
+                 *  a_k, and dp = dp z + p, using the old p. q is monic, so p *
+                 *  starts at 1.                                              */
+                Pack p_re = one;
+                Pack p_im = zero;
+                Pack dp_re = zero;
+                Pack dp_im = zero;
+
+                for (k = degree; k-- > 0U;)
+                {
+                    const Pack t = dp_re * re[j] - dp_im * im[j];
+                    dp_im = dp_re * im[j] + dp_im * re[j] + p_im;
+                    dp_re = t + p_re;
+
+                    const Pack u = p_re * re[j] - p_im * im[j];
+                    p_im = p_re * im[j] + p_im * re[j];
+                    p_re = u + a[k];
+                }
+
+                /*  The Aberth correction is w / (1 - w S), with the Newton   *
+                 *  step w = p / p' and S the sum of 1 / (z_j - z_k) over k   *
+                 *  != j. Written out, that is n quotients that wait on each  *
+                 *  other, and division is slow. Instead S is kept as a       *
+                 *  single fraction N / D. Adding 1 / u to N / D gives (N u + *
+                 *  D) / (D u), so D is the product of the z_j - z_k, and N   *
+                 *  is built alongside it with multiplications only. The      *
+                 *  correction is then p D / (p' D - p N), a single complex   *
+                 *  quotient. Since the scaled roots are less than 2 in size, *
+                 *  D is at most 4^(n-1), so it stays finite.                 */
+                Pack n_re = zero;
+                Pack n_im = zero;
+                Pack d_re = one;
+                Pack d_im = zero;
+
+                for (k = 0U; k < degree; ++k)
+                {
+                    if (k == j)
+                        continue;
+
+                    const Pack x = re[j] - re[k];
+                    const Pack y = im[j] - im[k];
+
+                    const Pack t = n_re * x - n_im * y + d_re;
+                    n_im = n_re * y + n_im * x + d_im;
+                    n_re = t;
+
+                    const Pack u = d_re * x - d_im * y;
+                    d_im = d_re * y + d_im * x;
+                    d_re = u;
+                }
+
+                /*  The numerator p D, and the denominator p' D - p N.        */
+                const Pack top_re = p_re * d_re - p_im * d_im;
+                const Pack top_im = p_re * d_im + p_im * d_re;
+                const Pack bottom_re = dp_re * d_re - dp_im * d_im
+                                     - (p_re * n_re - p_im * n_im);
+                const Pack bottom_im = dp_re * d_im + dp_im * d_re
+                                     - (p_re * n_im + p_im * n_re);
+
+                /*  One real division, by |p' D - p N|^2, and the rest is     *
+                 *  done by multiplying with the reciprocal.                  */
+                const Pack e =
+                    one / (bottom_re * bottom_re + bottom_im * bottom_im);
+                const Pack c_re = (top_re * bottom_re + top_im * bottom_im) * e;
+                const Pack c_im = (top_im * bottom_re - top_re * bottom_im) * e;
+
+                /*  The new z_j is used right away for the other roots, which *
+                 *  converges a little faster than updating them all at the   *
+                 *  end.                                                      */
+                re[j] = re[j] - c_re;
+                im[j] = im[j] - c_im;
+
+                correction_size = correction_size + c_re * c_re + c_im * c_im;
+                root_size = root_size + re[j] * re[j] + im[j] * im[j];
+            }
+
+            /*  We are done once the corrections are tiny in every lane. The  *
+             *  scaling does not change the ratio of the two sums.            */
+            store(corrections, correction_size);
+            store(sizes, root_size);
+            failures = 0;
+
+            for (lane = 0; lane < number_of_lanes; ++lane)
+            {
+                const double bound = tolerance * (sizes[lane] + smallest);
+
+                if (!(corrections[lane] <= bound))
+                    ++failures;
+            }
+
+            if (failures == 0)
+                break;
+        }
+
+        /*  The roots of p are r times the roots of q.                        */
+        for (j = 0U; j < degree; ++j)
+        {
+            store(real + j * root_stride, r * re[j]);
+            store(imag + j * root_stride, r * im[j]);
+        }
+
+        return failures;
+    }
+    /*  End of solve.                                                         */
+
+    /*  The starting points on the unit circle, e^{i theta} omega^j with      *
+     *  omega = e^{2 pi i / n}. The powers of omega are computed with         *
+     *  exp_by_squaring. The angle theta keeps the points off the real axis,  *
+     *  so that the starting points are not symmetric under conjugation, like *
+     *  the roots of a real polynomial are. A symmetric start may never find  *
+     *  a pair of complex roots.                                              */
+    static void unit_circle(unsigned int degree, Complex *unit)
+    {
+        const double two_pi = 6.283185307179586;
+        const double theta = 0.4;
+        const Complex rotation(std::cos(theta), std::sin(theta));
+        const double angle = two_pi / static_cast<double>(degree);
+        const Complex omega(std::cos(angle), std::sin(angle));
+        unsigned int j;
+
+        for (j = 0U; j < degree; ++j)
+            unit[j] = rotation * exp_by_squaring(omega, static_cast<int>(j));
+    }
+    /*  End of unit_circle.                                                   */
+
+    /*  We want the functions visible outside the class. Declare them public. */
+    public:
+
+        /*  The largest degree supported. The roots and coefficients of a     *
+         *  vector of polynomials are kept in registers, or at least in a     *
+         *  small array on the stack, so the size is fixed.                   */
+        static const unsigned int maximum_degree = 16U;
+
+        /*  Most polynomials need fewer than 10 steps. Repeated roots         *
+         *  converge slowly, and may use all of these.                        */
+        static const unsigned int maximum_number_of_iterations = 64U;
+
+        /*  Evaluates p_m(x[m]) for count polynomials with Horner's method, p *
+         *  = (...((a_n x + a_{n-1}) x + a_{n-2}) ...) x + a_0, and stores    *
+         *  the result in out[m]. The coefficients are stored as described    *
+         *  above. As many polynomials as possible are done a full vector at  *
+         *  a time, and the rest one at a time.                               */
+        static void evaluate(const double *coefficients,
+                             unsigned int degree,
+                             std::size_t count,
+                             const double *x,
+                             double *out)
+        {
+            std::size_t index = 0;
+            unsigned int k;
+
+            const std::size_t width = lanes<vector_double, group>();
+            typedef Lanes<vector_double, group> Pack;
+
+            for (; index + width <= count; index += width)
+            {
+                const double * const a = coefficients + index;
+                const Pack t = load<vector_double, group>(x + index);
+                Pack sum = load<vector_double, group>(a + degree * count);
+
+                for (k = degree; k-- > 0U;)
+                    sum = sum * t + load<vector_double, group>(a + k * count);
+
+                store(out + index, sum);
+            }
+
+            /*  The polynomials left over, one at a time.                     */
+            for (; index < count; ++index)
+            {
+                double sum = coefficients[degree * count + index];
+
+                for (k = degree; k-- > 0U;)
+                    sum = sum * x[index] + coefficients[k * count + index];
+
+                out[index] = sum;
+            }
+        }
+        /*  End of evaluate.                                                  */
+
+        /*  Computes every root of count polynomials of the given degree. The *
+         *  coefficients and roots are stored as described above, and the     *
+         *  leading coefficients must be non-zero. Returns the number of      *
+         *  polynomials that did not converge, which is zero unless some have *
+         *  repeated roots or are very badly conditioned. If the degree is    *
+         *  zero there are no roots, and if it is larger than maximum_degree  *
+         *  nothing is done, and every polynomial counts as a failure.        */
+        static std::size_t roots(const double *coefficients,
+                                 unsigned int degree,
+                                 std::size_t count,
+                                 double *real,
+                                 double *imag)
+        {
+            Complex unit[maximum_degree];
+            std::size_t index = 0;
+            std::size_t failures = 0;
+
+            if (degree == 0U)
+                return 0;
+
+            if (degree > maximum_degree)
+                return count;
+
+            unit_circle(degree, unit);
+
+            const std::size_t width = lanes<vector_double, group>();
+
+            for (; index + width <= count; index += width)
+                failures += solve<vector_double, group>(
+                    coefficients + index, count, degree, unit,
+                    real + index, imag + index, count
+                );
+
+            /*  What remains is less than a group, one vector at a time.      */
+            for (; index + lanes<vector_double, 1U>() <= count;
+                 index += lanes<vector_double, 1U>())
+                failures += solve<vector_double, 1U>(
+                    coefficients + index, count, degree, unit,
+                    real + index, imag + index, count
+                );
+
+            /*  The polynomials left over, one at a time.                     */
+            for (; index < count; ++index)
+                failures += solve<double, 1U>(
+                    coefficients + index, count, degree, unit,
+                    real + index, imag + index, count
+                );
+
+            return failures;
+        }
+        /*  End of roots.                                                     */
+
+        /*  Computes every root of a single polynomial with coefficients a_0, *
+         *  a_1, ..., a_n, stored one after the other. This is the same as    *
+         *  the batched routine with count = 1. Returns true if the iteration *
+         *  converged. The roots found are written to out either way, unless  *
+         *  the degree is larger than maximum_degree.                         */
+        static bool roots(const double *coefficients,
+                          unsigned int degree,
+                          Complex *out)
+        {
+            double real[maximum_degree];
+            double imag[maximum_degree];
+            unsigned int j;
+
+            /*  Nothing is computed for degrees that are too large.           */
+            if (degree > maximum_degree)
+                return false;
+
+            const bool converged = (roots(coefficients, degree, 1, real, imag)
+                                    == 0);
+
+            /*  The approximations are written even if the iteration did not  *
+             *  converge, since they are usually still close to the roots.    */
+            for (j = 0U; j < degree; ++j)
+                out[j] = Complex(real[j], imag[j]);
+
+            return converged;
+        }
+        /*  End of roots.                                                     */
+};
+/*  End of PolynomialRoots definition.                                        */
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
+/*  End of include guard.                                                     */
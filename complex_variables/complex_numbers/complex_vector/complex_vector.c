@@ -0,0 +1,425 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Defines the arena, the arrays of complex numbers, and the bulk        *
+ *      routines declared in complex_vector.h.                                *
+ *  Notes:                                                                    *
+ *      Written in C89, so it builds with the compilers of small embedded     *
+ *      systems too. The loops are written so that the compiler can vectorize *
+ *      them: each one reads the inputs of an element before writing its      *
+ *      output, and has no branches and no function calls except sqrt, which  *
+ *      compilers vectorize.                                                  *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/10/04                                                        *
+ ******************************************************************************/
+
+/*  malloc and free, for arenas that allocate their own memory.               */
+#include <stdlib.h>
+
+/*  sqrt, used for the modulus, is found here.                                */
+#include <math.h>
+
+/*  The types and the declarations of the routines.                           */
+#include "complex_vector.h"
+
+/*  Rounds size up to the next multiple of the alignment. The alignment is a  *
+ *  power of two, so this is adding alignment - 1 and clearing the low bits.  */
+static size_t round_up(size_t size)
+{
+    const size_t mask = (size_t)(COMPLEX_VECTOR_ALIGNMENT - 1);
+    return (size + mask) & ~mask;
+}
+/*  End of round_up.                                                          */
+
+/*  Returns the number of bytes from pointer to the next aligned address. C89 *
+ *  has no integer type that can hold a pointer. size_t can on every platform *
+ *  we know of, and only the low bits matter here anyway.                     */
+static size_t alignment_offset(const void *pointer)
+{
+    const size_t address = (size_t)pointer;
+    return round_up(address) - address;
+}
+/*  End of alignment_offset.                                                  */
+
+/*  Starts an arena in memory provided by the caller.                         */
+int complex_arena_init(struct complex_arena *arena, void *buffer, size_t size)
+{
+    const size_t offset = alignment_offset(buffer);
+
+    arena->owned = NULL;
+    arena->used = 0;
+
+    /*  Not even the first aligned byte is in the buffer.                     */
+    if (buffer == NULL || offset >= size)
+    {
+        arena->memory = NULL;
+        arena->capacity = 0;
+        return 0;
+    }
+
+    arena->memory = (unsigned char *)buffer + offset;
+    arena->capacity = size - offset;
+    return 1;
+}
+/*  End of complex_arena_init.                                                */
+
+/*  Starts an arena in memory allocated with malloc.                          */
+int complex_arena_create(struct complex_arena *arena, size_t size)
+{
+    /*  malloc only promises the alignment of the largest basic type, usually *
+     *  16 bytes, so ask for enough extra to move up to the next multiple of  *
+     *  64.                                                                   */
+    const size_t extra = (size_t)(COMPLEX_VECTOR_ALIGNMENT - 1);
+    void *block;
+
+    /*  size + extra would wrap around to a small number, and malloc would    *
+     *  return a tiny block for an arena that thinks it has size bytes.       */
+    if (size > (size_t)-1 - extra)
+    {
+        arena->memory = NULL;
+        arena->capacity = 0;
+        arena->used = 0;
+        arena->owned = NULL;
+        return 0;
+    }
+
+    block = malloc(size + extra);
+
+    if (!complex_arena_init(arena, block, size + extra))
+    {
+        free(block);
+        return 0;
+    }
+
+    /*  Hand out only size bytes, even if the aligned block is larger.        */
+    arena->capacity = size;
+    arena->owned = block;
+    return 1;
+}
+/*  End of complex_arena_create.                                              */
+
+/*  Hands out the next size bytes of the arena.                               */
+void *complex_arena_allocate(struct complex_arena *arena, size_t size)
+{
+    const size_t rounded = round_up(size);
+    unsigned char *block;
+
+    /*  Written so that nothing can overflow: used never exceeds capacity. A  *
+     *  size that rounds to zero is too large to have been meant, since every *
+     *  real size rounds up to at least the alignment, and zero itself gets   *
+     *  no memory either.                                                     */
+    if (rounded == 0 || rounded > arena->capacity - arena->used)
+        return NULL;
+
+    block = arena->memory + arena->used;
+    arena->used += rounded;
+    return block;
+}
+/*  End of complex_arena_allocate.                                            */
+
+/*  Makes all of the memory of the arena available again.                     */
+void complex_arena_reset(struct complex_arena *arena)
+{
+    arena->used = 0;
+}
+/*  End of complex_arena_reset.                                               */
+
+/*  Frees the block of the arena if the arena allocated it.                   */
+void complex_arena_destroy(struct complex_arena *arena)
+{
+    free(arena->owned);
+    arena->owned = NULL;
+    arena->memory = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+}
+/*  End of complex_arena_destroy.                                             */
+
+/*  Returns 1 if length numbers of the given size fit in a size_t, so that    *
+ *  the number of bytes of an array can be computed.                          */
+static int size_fits(size_t length, size_t size)
+{
+    return length <= ((size_t)-1) / size;
+}
+/*  End of size_fits.                                                         */
+
+/*  Creates an array of structs from the arena.                               */
+int complex_vector_aos_create(struct complex_vector_aos *vector,
+                              struct complex_arena *arena,
+                              size_t length)
+{
+    const size_t size = sizeof(struct complex_number);
+    void *block = NULL;
+
+    if (size_fits(length, size))
+        block = complex_arena_allocate(arena, length * size);
+
+    if (block == NULL)
+    {
+        vector->data = NULL;
+        vector->length = 0;
+        return 0;
+    }
+
+    vector->data = (struct complex_number *)block;
+    vector->length = length;
+    return 1;
+}
+/*  End of complex_vector_aos_create.                                         */
+
+/*  Creates a struct of arrays from the arena.                                */
+int complex_vector_soa_create(struct complex_vector_soa *vector,
+                              struct complex_arena *arena,
+                              size_t length)
+{
+    /*  The two arrays are allocated one after the other, so that if the      *
+     *  second does not fit, the first can be given back by moving the arena  *
+     *  back to where it was.                                                 */
+    const size_t used = arena->used;
+    void *real = NULL, *imag = NULL;
+
+    if (size_fits(length, sizeof(double)))
+    {
+        real = complex_arena_allocate(arena, length * sizeof(double));
+        imag = complex_arena_allocate(arena, length * sizeof(double));
+    }
+
+    if (real == NULL || imag == NULL)
+    {
+        arena->used = used;
+        vector->real = NULL;
+        vector->imag = NULL;
+        vector->length = 0;
+        return 0;
+    }
+
+    vector->real = (double *)real;
+    vector->imag = (double *)imag;
+    vector->length = length;
+    return 1;
+}
+/*  End of complex_vector_soa_create.                                         */
+
+/*  Copies an array of structs into a struct of arrays.                       */
+int complex_vector_aos_to_soa(const struct complex_vector_aos *in,
+                              struct complex_vector_soa *out)
+{
+    size_t k;
+
+    if (in->length != out->length)
+        return 0;
+
+    for (k = 0; k < out->length; ++k)
+    {
+        out->real[k] = in->data[k].real;
+        out->imag[k] = in->data[k].imag;
+    }
+
+    return 1;
+}
+/*  End of complex_vector_aos_to_soa.                                         */
+
+/*  Copies a struct of arrays into an array of structs.                       */
+int complex_vector_soa_to_aos(const struct complex_vector_soa *in,
+                              struct complex_vector_aos *out)
+{
+    size_t k;
+
+    if (in->length != out->length)
+        return 0;
+
+    for (k = 0; k < out->length; ++k)
+    {
+        out->data[k].real = in->real[k];
+        out->data[k].imag = in->imag[k];
+    }
+
+    return 1;
+}
+/*  End of complex_vector_soa_to_aos.                                         */
+
+/*  Computes out = a + b, element by element, for arrays of structs.          */
+int complex_vector_aos_add(const struct complex_vector_aos *a,
+                           const struct complex_vector_aos *b,
+                           struct complex_vector_aos *out)
+{
+    size_t k;
+
+    if (a->length != out->length || b->length != out->length)
+        return 0;
+
+    for (k = 0; k < out->length; ++k)
+    {
+        const double real = a->data[k].real + b->data[k].real;
+        const double imag = a->data[k].imag + b->data[k].imag;
+
+        out->data[k].real = real;
+        out->data[k].imag = imag;
+    }
+
+    return 1;
+}
+/*  End of complex_vector_aos_add.                                            */
+
+/*  Computes out = a * b, element by element, for arrays of structs. The      *
+ *  product is (x + iy)(u + iv) = (xu - yv) + i(xv + yu).                     */
+int complex_vector_aos_multiply(const struct complex_vector_aos *a,
+                                const struct complex_vector_aos *b,
+                                struct complex_vector_aos *out)
+{
+    size_t k;
+
+    if (a->length != out->length || b->length != out->length)
+        return 0;
+
+    for (k = 0; k < out->length; ++k)
+    {
+        const double x = a->data[k].real, y = a->data[k].imag;
+        const double u = b->data[k].real, v = b->data[k].imag;
+
+        out->data[k].real = x*u - y*v;
+        out->data[k].imag = x*v + y*u;
+    }
+
+    return 1;
+}
+/*  End of complex_vector_aos_multiply.                                       */
+
+/*  Computes out = conj(in), element by element, for arrays of structs.       */
+int complex_vector_aos_conjugate(const struct complex_vector_aos *in,
+                                 struct complex_vector_aos *out)
+{
+    size_t k;
+
+    if (in->length != out->length)
+        return 0;
+
+    for (k = 0; k < out->length; ++k)
+    {
+        const double real = in->data[k].real;
+        const double imag = in->data[k].imag;
+
+        out->data[k].real = real;
+        out->data[k].imag = -imag;
+    }
+
+    return 1;
+}
+/*  End of complex_vector_aos_conjugate.                                      */
+
+/*  Computes |z| for every element of an array of structs. This is the        *
+ *  formula of modulus in basic_syntax_c89.c. It overflows if x^2 + y^2 is    *
+ *  larger than the largest double, about 1.8E+308, which C99's hypot avoids, *
+ *  but hypot is not in C89, and is far too slow to vectorize.                */
+void complex_vector_aos_modulus(const struct complex_vector_aos *in,
+                                double *modulus)
+{
+    size_t k;
+
+    for (k = 0; k < in->length; ++k)
+    {
+        const double x = in->data[k].real, y = in->data[k].imag;
+        modulus[k] = sqrt(x*x + y*y);
+    }
+}
+/*  End of complex_vector_aos_modulus.                                        */
+
+/*  Computes out = a + b, element by element, for structs of arrays.          */
+int complex_vector_soa_add(const struct complex_vector_soa *a,
+                           const struct complex_vector_soa *b,
+                           struct complex_vector_soa *out)
+{
+    size_t k;
+
+    if (a->length != out->length || b->length != out->length)
+        return 0;
+
+    for (k = 0; k < out->length; ++k)
+    {
+        const double real = a->real[k] + b->real[k];
+        const double imag = a->imag[k] + b->imag[k];
+
+        out->real[k] = real;
+        out->imag[k] = imag;
+    }
+
+    return 1;
+}
+/*  End of complex_vector_soa_add.                                            */
+
+/*  Computes out = a * b, element by element, for structs of arrays.          */
+int complex_vector_soa_multiply(const struct complex_vector_soa *a,
+                                const struct complex_vector_soa *b,
+                                struct complex_vector_soa *out)
+{
+    size_t k;
+
+    if (a->length != out->length || b->length != out->length)
+        return 0;
+
+    for (k = 0; k < out->length; ++k)
+    {
+        const double x = a->real[k], y = a->imag[k];
+        const double u = b->real[k], v = b->imag[k];
+
+        out->real[k] = x*u - y*v;
+        out->imag[k] = x*v + y*u;
+    }
+
+    return 1;
+}
+/*  End of complex_vector_soa_multiply.                                       */
+
+/*  Computes out = conj(in), element by element, for structs of arrays.       */
+int complex_vector_soa_conjugate(const struct complex_vector_soa *in,
+                                 struct complex_vector_soa *out)
+{
+    size_t k;
+
+    if (in->length != out->length)
+        return 0;
+
+    for (k = 0; k < out->length; ++k)
+    {
+        const double real = in->real[k];
+        const double imag = in->imag[k];
+
+        out->real[k] = real;
+        out->imag[k] = -imag;
+    }
+
+    return 1;
+}
+/*  End of complex_vector_soa_conjugate.                                      */
+
+/*  Computes |z| for every element of a struct of arrays.                     */
+void complex_vector_soa_modulus(const struct complex_vector_soa *in,
+                                double *modulus)
+{
+    size_t k;
+
+    for (k = 0; k < in->length; ++k)
+    {
+        const double x = in->real[k], y = in->imag[k];
+        modulus[k] = sqrt(x*x + y*y);
+    }
+}
+/*  End of complex_vector_soa_modulus.                                        */
@@ -0,0 +1,189 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Arrays of complex numbers for C89, stored either as an array of       *
+ *      structs or as a struct of arrays, allocated from an arena, with bulk  *
+ *      arithmetic.                                                           *
+ *  Notes:                                                                    *
+ *      Declares the types and routines, which are defined in                 *
+ *      complex_vector.c. basic_syntax_c89.c works with one complex number at *
+ *      a time. Programs that keep many of them, each allocated with its own  *
+ *      call to malloc, spread them all over memory, and every operation      *
+ *      waits for a cache miss. Here every array is one contiguous, aligned   *
+ *      block, and the loops are plain enough for the compiler to vectorize   *
+ *      them.                                                                 *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/10/04                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_COMPLEX_VECTOR_H
+#define MITX_COMPLEX_VECTOR_H
+
+/*  The size_t data type, used for sizes and indices, is found here.          */
+#include <stddef.h>
+
+/*  The routines are compiled as C. C++ programs need to know this.           */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*  Every block handed out by an arena starts at a multiple of this many      *
+ *  bytes. 64 is the size of a cache line on most processors, and of an       *
+ *  AVX-512 register, so no vector load of an array ever straddles two cache  *
+ *  lines.                                                                    */
+#define COMPLEX_VECTOR_ALIGNMENT 64
+
+/*  C89 does not provide complex numbers, but we can define them.             */
+struct complex_number {
+    double real, imag;
+};
+
+/*  An arena hands out memory from one large block, one piece after another.  *
+ *  Allocating is adding to a counter, and everything is freed at once, by    *
+ *  resetting or destroying the arena. The pieces of one arena are next to    *
+ *  each other in memory, so arrays that are used together share the cache,   *
+ *  and there is no per-allocation bookkeeping. The memory is either the      *
+ *  caller's, for systems without malloc, or allocated by                     *
+ *  complex_arena_create.                                                     */
+struct complex_arena {
+
+    /*  The first aligned byte of the block, and the number of bytes there.   */
+    unsigned char *memory;
+    size_t capacity;
+
+    /*  The number of bytes handed out so far.                                */
+    size_t used;
+
+    /*  The pointer returned by malloc, or NULL if the memory is the caller's.*/
+    void *owned;
+};
+
+/*  An array of structs. The real and imaginary parts of each number are next *
+ *  to each other, which is what basic_syntax_c89.c and most C code use. This *
+ *  is the better layout when the numbers are used one at a time.             */
+struct complex_vector_aos {
+    struct complex_number *data;
+    size_t length;
+};
+
+/*  A struct of arrays. All of the real parts are stored together, and all of *
+ *  the imaginary parts. A vector register then holds the real parts of       *
+ *  several numbers, so the bulk routines load and store whole registers,     *
+ *  with no shuffling. This is the better layout for the bulk routines.       */
+struct complex_vector_soa {
+    double *real;
+    double *imag;
+    size_t length;
+};
+
+/*  Arenas. complex_arena_init uses the size bytes at buffer, which need not  *
+ *  be aligned, and complex_arena_create allocates size bytes with malloc.    *
+ *  Both return 1 on success. complex_arena_create returns 0 if malloc fails, *
+ *  or if size is so large that the extra bytes for the alignment do not fit  *
+ *  in a size_t, and complex_arena_init if the buffer is too small to hold    *
+ *  even one aligned byte.                                                    */
+extern int
+complex_arena_init(struct complex_arena *arena, void *buffer, size_t size);
+
+extern int complex_arena_create(struct complex_arena *arena, size_t size);
+
+/*  Returns size bytes, aligned to COMPLEX_VECTOR_ALIGNMENT, or NULL if there *
+ *  is not enough room left in the arena.                                     */
+extern void *complex_arena_allocate(struct complex_arena *arena, size_t size);
+
+/*  complex_arena_reset frees everything handed out, so the memory can be     *
+ *  used again. complex_arena_destroy also frees the block, if the arena      *
+ *  allocated it.                                                             */
+extern void complex_arena_reset(struct complex_arena *arena);
+extern void complex_arena_destroy(struct complex_arena *arena);
+
+/*  Creates an array of length complex numbers from the arena. The numbers    *
+ *  are not initialized. Returns 1 on success, and 0, with the array empty,   *
+ *  if there is not enough room.                                              */
+extern int
+complex_vector_aos_create(struct complex_vector_aos *vector,
+                          struct complex_arena *arena,
+                          size_t length);
+
+extern int
+complex_vector_soa_create(struct complex_vector_soa *vector,
+                          struct complex_arena *arena,
+                          size_t length);
+
+/*  Copies between the two layouts. The arrays must have the same length.     *
+ *  Returns 1 on success, and 0, copying nothing, if they do not.             */
+extern int
+complex_vector_aos_to_soa(const struct complex_vector_aos *in,
+                          struct complex_vector_soa *out);
+
+extern int
+complex_vector_soa_to_aos(const struct complex_vector_soa *in,
+                          struct complex_vector_aos *out);
+
+/*  The bulk routines. Element k of out is computed from element k of the     *
+ *  inputs, for every k below out->length. The inputs must have the same      *
+ *  length as out. The routines return 1 on success, and 0, writing nothing,  *
+ *  if they do not. out may be one of the inputs, so a = a * b is             *
+ *  complex_vector_soa_multiply(&a, &b, &a). The moduli are written to the    *
+ *  array modulus, which must have at least in->length elements.              */
+extern int
+complex_vector_aos_add(const struct complex_vector_aos *a,
+                       const struct complex_vector_aos *b,
+                       struct complex_vector_aos *out);
+
+extern int
+complex_vector_aos_multiply(const struct complex_vector_aos *a,
+                            const struct complex_vector_aos *b,
+                            struct complex_vector_aos *out);
+
+extern int
+complex_vector_aos_conjugate(const struct complex_vector_aos *in,
+                             struct complex_vector_aos *out);
+
+extern void
+complex_vector_aos_modulus(const struct complex_vector_aos *in,
+                           double *modulus);
+
+extern int
+complex_vector_soa_add(const struct complex_vector_soa *a,
+                       const struct complex_vector_soa *b,
+                       struct complex_vector_soa *out);
+
+extern int
+complex_vector_soa_multiply(const struct complex_vector_soa *a,
+                            const struct complex_vector_soa *b,
+                            struct complex_vector_soa *out);
+
+extern int
+complex_vector_soa_conjugate(const struct complex_vector_soa *in,
+                             struct complex_vector_soa *out);
+
+extern void
+complex_vector_soa_modulus(const struct complex_vector_soa *in,
+                           double *modulus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*  End of include guard.                                                     */
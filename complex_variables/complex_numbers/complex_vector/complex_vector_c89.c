@@ -0,0 +1,344 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Shows how to use the arrays of complex numbers in complex_vector.h,   *
+ *      and times them against one malloc per number.                         *
+ *  Notes:                                                                    *
+ *      The routines are in complex_vector.c. This is the bulk version of     *
+ *      basic_syntax_c89.c, written in C89 as well.                           *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/10/04                                                        *
+ ******************************************************************************/
+
+/*  stdio.h provides the "printf" function, used for printing text.           */
+#include <stdio.h>
+
+/*  malloc and free, for the one-malloc-per-number version.                   */
+#include <stdlib.h>
+
+/*  clock, used for timing the routines, is found here.                       */
+#include <time.h>
+
+/*  The arrays of complex numbers and the bulk routines.                      */
+#include "complex_vector.h"
+
+/*  The number of complex numbers in the timed arrays, and the number of      *
+ *  passes over them. Three arrays of 16384 numbers take 768 kilobytes, which *
+ *  fits in the L2 cache of most processors, but the same numbers scattered   *
+ *  over the heap do not.                                                     */
+#define NUMBER_OF_VALUES 16384
+#define NUMBER_OF_PASSES 800
+
+/*  A simple random number generator, a linear congruential generator. This   *
+ *  gives the same numbers on every platform, unlike rand. C89 has no 64-bit  *
+ *  integers, so this uses the 32-bit one from Numerical Recipes, which works *
+ *  with unsigned long, always at least 32 bits. Returns a number in [0, 1).  */
+static double random_real(unsigned long int *state)
+{
+    *state = (*state * 1664525UL + 1013904223UL) & 0xFFFFFFFFUL;
+    return (double)(*state) / 4294967296.0;
+}
+/*  End of random_real.                                                       */
+
+/*  Returns the number of nanoseconds per number, for clock ticks spent over  *
+ *  every pass.                                                               */
+static double nanoseconds(clock_t start, clock_t end)
+{
+    const double seconds = (double)(end - start) / (double)CLOCKS_PER_SEC;
+    return 1.0E+09 * seconds / ((double)NUMBER_OF_VALUES * NUMBER_OF_PASSES);
+}
+/*  End of nanoseconds.                                                       */
+
+/*  Prints a complex number as x + y i, the same as basic_syntax_c89.c.       */
+static void print_complex(const char *name, double real, double imag)
+{
+    printf("%s = %f + %f i\n", name, real, imag);
+}
+/*  End of print_complex.                                                     */
+
+/*  Uses the routines on a few numbers, and prints the results.               */
+static void show_routines(void)
+{
+    /*  The arena can use any memory, here an array on the stack, as a        *
+     *  program without malloc would. 1024 bytes hold a few arrays of four    *
+     *  numbers, with room left over for the alignment.                       */
+    unsigned char buffer[1024];
+    const double real[4] = {1.0, 2.0, -3.0, 0.0};
+    const double imag[4] = {1.0, -1.0, 0.5, 4.0};
+    struct complex_arena arena, huge;
+    struct complex_vector_soa a, b, out, shorter;
+    struct complex_vector_aos a_aos, b_aos, out_aos;
+    double modulus[4];
+    size_t k, mismatches = 0;
+
+    if (!complex_arena_init(&arena, buffer, sizeof(buffer)) ||
+        !complex_vector_soa_create(&a, &arena, 4) ||
+        !complex_vector_soa_create(&b, &arena, 4) ||
+        !complex_vector_soa_create(&out, &arena, 4) ||
+        !complex_vector_aos_create(&a_aos, &arena, 4) ||
+        !complex_vector_aos_create(&b_aos, &arena, 4) ||
+        !complex_vector_aos_create(&out_aos, &arena, 4))
+    {
+        puts("The arena is too small.");
+        return;
+    }
+
+    /*  a is 1 + i, 2 - i, -3 + 0.5 i, and 4 i. b is the conjugate of a.      */
+    for (k = 0; k < 4; ++k)
+    {
+        a.real[k] = real[k];
+        a.imag[k] = imag[k];
+    }
+
+    complex_vector_soa_conjugate(&a, &b);
+    complex_vector_soa_to_aos(&a, &a_aos);
+    complex_vector_soa_to_aos(&b, &b_aos);
+
+    /*  z times its conjugate is |z|^2, a real number, so the products should *
+     *  be 2, 5, 9.25, and 16.                                                */
+    complex_vector_soa_multiply(&a, &b, &out);
+    complex_vector_soa_modulus(&a, modulus);
+
+    for (k = 0; k < 4; ++k)
+    {
+        print_complex("z", a.real[k], a.imag[k]);
+        print_complex("    z * conj(z)", out.real[k], out.imag[k]);
+        printf("    |z| = %f\n", modulus[k]);
+    }
+
+    /*  And z + conj(z) is twice the real part of z.                          */
+    complex_vector_soa_add(&a, &b, &out);
+
+    for (k = 0; k < 4; ++k)
+        printf("z + conj(z) = %f + %f i\n", out.real[k], out.imag[k]);
+
+    /*  The two layouts must give exactly the same numbers.                   */
+    complex_vector_soa_multiply(&a, &b, &out);
+    complex_vector_aos_multiply(&a_aos, &b_aos, &out_aos);
+
+    for (k = 0; k < 4; ++k)
+        if (out.real[k] != out_aos.data[k].real ||
+            out.imag[k] != out_aos.data[k].imag)
+            ++mismatches;
+
+    printf("AoS and SoA products differ in %lu places.\n",
+           (unsigned long int)mismatches);
+
+    /*  Arrays of different lengths are refused, and nothing is written. So   *
+     *  is an arena too large for the extra bytes of the alignment.           */
+    shorter = a;
+    shorter.length = 3;
+
+    printf("Adding arrays of lengths 3 and 4 succeeds: %d\n",
+           complex_vector_soa_add(&shorter, &b, &out));
+
+    printf("Creating an arena of SIZE_MAX bytes succeeds: %d\n\n",
+           complex_arena_create(&huge, (size_t)-1));
+}
+/*  End of show_routines.                                                     */
+
+/*  Multiplies two arrays of NUMBER_OF_VALUES random numbers,                 *
+ *  NUMBER_OF_PASSES times, with each layout, and prints the time per         *
+ *  product. The first version allocates every number with its own call to    *
+ *  malloc, and in between allocates a random amount of other memory, as a    *
+ *  program that has run for a while would. Its numbers end up scattered over *
+ *  the heap.                                                                 */
+static void benchmark(void)
+{
+    struct complex_number **a_pointers, **b_pointers, **out_pointers;
+    void **others;
+    struct complex_arena arena;
+    struct complex_vector_aos a_aos, b_aos, out_aos;
+    struct complex_vector_soa a, b, out;
+    unsigned long int state = 1UL;
+    double checksum = 0.0;
+    clock_t start, end;
+    size_t k, pass;
+
+    /*  Two arrays of structs and two structs of arrays, times three, plus    *
+     *  room for the alignment.                                               */
+    const size_t size = 6 * NUMBER_OF_VALUES * sizeof(struct complex_number) +
+                        16 * COMPLEX_VECTOR_ALIGNMENT;
+
+    a_pointers = malloc(NUMBER_OF_VALUES * sizeof(*a_pointers));
+    b_pointers = malloc(NUMBER_OF_VALUES * sizeof(*b_pointers));
+    out_pointers = malloc(NUMBER_OF_VALUES * sizeof(*out_pointers));
+    others = malloc(3 * NUMBER_OF_VALUES * sizeof(*others));
+
+    if (!a_pointers || !b_pointers || !out_pointers || !others ||
+        !complex_arena_create(&arena, size))
+    {
+        puts("Out of memory.");
+        free(a_pointers);
+        free(b_pointers);
+        free(out_pointers);
+        free(others);
+        return;
+    }
+
+    /*  The arena holds everything, so these can not fail.                    */
+    complex_vector_aos_create(&a_aos, &arena, NUMBER_OF_VALUES);
+    complex_vector_aos_create(&b_aos, &arena, NUMBER_OF_VALUES);
+    complex_vector_aos_create(&out_aos, &arena, NUMBER_OF_VALUES);
+    complex_vector_soa_create(&a, &arena, NUMBER_OF_VALUES);
+    complex_vector_soa_create(&b, &arena, NUMBER_OF_VALUES);
+    complex_vector_soa_create(&out, &arena, NUMBER_OF_VALUES);
+
+    for (k = 0; k < NUMBER_OF_VALUES; ++k)
+    {
+        a_aos.data[k].real = 2.0 * random_real(&state) - 1.0;
+        a_aos.data[k].imag = 2.0 * random_real(&state) - 1.0;
+        b_aos.data[k].real = 2.0 * random_real(&state) - 1.0;
+        b_aos.data[k].imag = 2.0 * random_real(&state) - 1.0;
+    }
+
+    complex_vector_aos_to_soa(&a_aos, &a);
+    complex_vector_aos_to_soa(&b_aos, &b);
+
+    /*  The same numbers, one malloc each, with other memory in between.      */
+    for (k = 0; k < NUMBER_OF_VALUES; ++k)
+    {
+        a_pointers[k] = malloc(sizeof(struct complex_number));
+        others[3 * k] = malloc(16 + (size_t)(240.0 * random_real(&state)));
+        b_pointers[k] = malloc(sizeof(struct complex_number));
+        others[3 * k + 1] = malloc(16 + (size_t)(240.0 * random_real(&state)));
+        out_pointers[k] = malloc(sizeof(struct complex_number));
+        others[3 * k + 2] = malloc(16 + (size_t)(240.0 * random_real(&state)));
+
+        /*  Exiting frees everything allocated so far.                        */
+        if (!a_pointers[k] || !b_pointers[k] || !out_pointers[k])
+        {
+            puts("Out of memory.");
+            exit(EXIT_FAILURE);
+        }
+
+        *a_pointers[k] = a_aos.data[k];
+        *b_pointers[k] = b_aos.data[k];
+    }
+
+    start = clock();
+
+    for (pass = 0; pass < NUMBER_OF_PASSES; ++pass)
+    {
+        for (k = 0; k < NUMBER_OF_VALUES; ++k)
+        {
+            const double x = a_pointers[k]->real, y = a_pointers[k]->imag;
+            const double u = b_pointers[k]->real, v = b_pointers[k]->imag;
+
+            out_pointers[k]->real = x*u - y*v;
+            out_pointers[k]->imag = x*v + y*u;
+        }
+
+        checksum += out_pointers[pass]->real;
+    }
+
+    end = clock();
+    printf("one malloc per number: %6.3f ns/product\n",
+           nanoseconds(start, end));
+
+    start = clock();
+
+    for (pass = 0; pass < NUMBER_OF_PASSES; ++pass)
+    {
+        complex_vector_aos_multiply(&a_aos, &b_aos, &out_aos);
+        checksum += out_aos.data[pass].real;
+    }
+
+    end = clock();
+    printf("array of structs:      %6.3f ns/product\n",
+           nanoseconds(start, end));
+
+    start = clock();
+
+    for (pass = 0; pass < NUMBER_OF_PASSES; ++pass)
+    {
+        complex_vector_soa_multiply(&a, &b, &out);
+        checksum += out.real[pass];
+    }
+
+    end = clock();
+    printf("struct of arrays:      %6.3f ns/product\n",
+           nanoseconds(start, end));
+
+    /*  Every version computed the same products, so this is three times the  *
+     *  sum of the first NUMBER_OF_PASSES real parts.                         */
+    printf("checksum: %f\n", checksum);
+
+    for (k = 0; k < NUMBER_OF_VALUES; ++k)
+    {
+        free(a_pointers[k]);
+        free(b_pointers[k]);
+        free(out_pointers[k]);
+        free(others[3 * k]);
+        free(others[3 * k + 1]);
+        free(others[3 * k + 2]);
+    }
+
+    free(a_pointers);
+    free(b_pointers);
+    free(out_pointers);
+    free(others);
+    complex_arena_destroy(&arena);
+}
+/*  End of benchmark.                                                         */
+
+/*  Shows the routines, and times the three ways of storing the numbers.      */
+int main(void)
+{
+    show_routines();
+    benchmark();
+    return 0;
+}
+
+/*  We can execute this on GNU, Linux, FreeBSD, macOS, etc., via:             *
+ *      cc -O3 complex_vector_c89.c complex_vector.c -o main -lm              *
+ *      ./main                                                                *
+ *  This will output the following:                                           *
+ *      z = 1.000000 + 1.000000 i                                             *
+ *          z * conj(z) = 2.000000 + 0.000000 i                               *
+ *          |z| = 1.414214                                                    *
+ *      z = 2.000000 + -1.000000 i                                            *
+ *          z * conj(z) = 5.000000 + 0.000000 i                               *
+ *          |z| = 2.236068                                                    *
+ *      z = -3.000000 + 0.500000 i                                            *
+ *          z * conj(z) = 9.250000 + 0.000000 i                               *
+ *          |z| = 3.041381                                                    *
+ *      z = 0.000000 + 4.000000 i                                             *
+ *          z * conj(z) = 16.000000 + 0.000000 i                              *
+ *          |z| = 4.000000                                                    *
+ *      z + conj(z) = 2.000000 + 0.000000 i                                   *
+ *      z + conj(z) = 4.000000 + 0.000000 i                                   *
+ *      z + conj(z) = -6.000000 + 0.000000 i                                  *
+ *      z + conj(z) = 0.000000 + 0.000000 i                                   *
+ *      AoS and SoA products differ in 0 places.                              *
+ *      Adding arrays of lengths 3 and 4 succeeds: 0                          *
+ *      Creating an arena of SIZE_MAX bytes succeeds: 0                       *
+ *  followed by the time per product for the three ways of storing the        *
+ *  numbers, and a checksum. The times depend on the machine. The numbers     *
+ *  allocated one at a time are scattered over the heap, and every product    *
+ *  waits for memory, so this is many times slower than the arrays. Add       *
+ *  -march=native -fno-math-errno to the first command to let the compiler    *
+ *  use the widest vector instructions of the machine, and to vectorize the   *
+ *  moduli.                                                                   *
+ *                                                                            *
+ *  On Windows you will need to install a C compiler. Common options are      *
+ *  Microsoft's MSVC, LLVM's clang, MinGW (which uses the GNU toolchain), or  *
+ *  installing Cygwin and running the commands above.                         */
@@ -0,0 +1,108 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                   LICENSE                                    %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%   This file is part of mitx_mathematics_programming_examples.                %
+%                                                                              %
+%   mitx_mathematics_programming_examples is free software: you can            %
+%   redistribute it and/or modify it under the terms of the GNU General Public %
+%   License as published by the Free Software Foundation, either version 3 of  %
+%   the License, or (at your option) any later version.                        %
+%                                                                              %
+%   mitx_mathematics_programming_examples is distributed in the hope that it   %
+%   will be useful, but WITHOUT ANY WARRANTY; without even the implied         %
+%   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the  %
+%   GNU General Public License for more details.                               %
+%                                                                              %
+%   You should have received a copy of the GNU General Public License          %
+%   along with mitx_mathematics_programming_examples.  If not, see             %
+%   <https://www.gnu.org/licenses/>.                                           %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%   Purpose:                                                                   %
+%       Animates the snapshots written by heat_equation_baking_a_cake.cpp.     %
+%   Notes:                                                                     %
+%       The solver streams the temperature to a binary file every few steps,   %
+%       instead of keeping every time step in memory and plotting as it goes.  %
+%       This reads the file one snapshot at a time and plots it, as the        %
+%       MATLAB version does. It works on both GNU Octave and MATLAB.           %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%   Author:     Ryan Maguire                                                   %
+%   Date:       August 16, 2025.                                               %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Read the temperature snapshots written by the C++ solver, and animate them.
+close all;
+clearvars;
+
+% The file written by heat_equation_baking_a_cake.cpp.
+file_name = 'heat_equation_baking_a_cake.bin';
+file = fopen(file_name, 'r');
+
+if file < 0
+    error('Could not open %s. Run the C++ solver first.', file_name);
+end
+
+% The header. See SnapshotWriter in the C++ code for the layout.
+magic = fread(file, [1, 8], '*char');
+
+if ~strcmp(magic, 'CAKESNAP')
+    fclose(file);
+    error('%s is not a snapshot file.', file_name);
+end
+
+version = fread(file, 1, 'uint32');
+bytes_per_value = fread(file, 1, 'uint32');
+number_of_points = fread(file, 1, 'uint64');
+number_of_snapshots = fread(file, 1, 'uint64');
+length_of_cake = fread(file, 1, 'double');
+time_between_snapshots = fread(file, 1, 'double');
+
+if version ~= 1
+    fclose(file);
+    error('Unknown snapshot file version %d.', version);
+end
+
+% The values are either single or double precision.
+if bytes_per_value == 4
+    precision = 'single';
+else
+    precision = 'double';
+end
+
+% The spatial grid, as in the MATLAB version.
+x = linspace(0.0, length_of_cake, number_of_points);
+
+% Only one snapshot is in memory at a time.
+for i = 1:number_of_snapshots
+
+    u = fread(file, [1, number_of_points], precision);
+
+    % The file may be shorter than the header says if the solver stopped.
+    if length(u) < number_of_points
+        break;
+    end
+
+    % First time through the loop, create the plot.
+    % Subsequent times, update YData and title.
+    if i == 1
+
+        % Plot solution.
+        p = plot(x, u, 'linewidth', 2);
+        xlabel('$x$', 'interpreter', 'latex')
+        ylabel('$u$', 'interpreter', 'latex')
+
+        % The oven is at 200 degrees, and the far end cools towards 0.
+        ylim([0, 200]);
+    else
+
+        % Update the plot.
+        set(p, 'YData', u);
+    end
+
+    time = (i - 1) * time_between_snapshots;
+    title(['t = ', num2str(time, '%.3f')], 'interpreter', 'latex')
+
+    drawnow
+
+end
+
+fclose(file);
@@ -86,8 +86,10 @@ static unsigned int get_max_number(void)
         /*  We compute 2^n by bit-shifting 1 by n bits. Consider the same     *
          *  idea but in decimal. If you have 10.00 and want one hundred, you  *
          *  would simply shift the decimal over by one, obtaining 100.0. This *
-         *  is the binary equivalent of that idea.                            */
-        two_to_the_n = 1 << index;
+         *  is the binary equivalent of that idea. The 1 must be unsigned.    *
+         *  1 is a signed int, and shifting it into the sign bit is undefined *
+         *  behavior.                                                         */
+        two_to_the_n = 1U << index;
 
         /*  Add this power of two to the output.                              */
         max_integer = max_integer + two_to_the_n;
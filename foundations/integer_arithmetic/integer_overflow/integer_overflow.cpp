@@ -0,0 +1,302 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Shows that integer addition can overflow, using the compile-time      *
+ *      properties and the checked arithmetic in integer_overflow.hpp.        *
+ *  Notes:                                                                    *
+ *      This is the C++ version of integer_overflow.c. The number of bits and *
+ *      the largest value are constants here, known to the compiler, and not  *
+ *      computed by loops.                                                    *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/09/27                                                        *
+ ******************************************************************************/
+
+/*  stdio provides the "printf" function, used for printing text.             */
+#include <cstdio>
+
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  std::uint64_t, used by the random number generator, is found here.        */
+#include <cstdint>
+
+/*  std::vector, for the numbers that are summed in the benchmark.            */
+#include <vector>
+
+/*  Timing routines, used for benchmarking the checked addition.              */
+#include <chrono>
+
+/*  The integer properties and checked arithmetic, in BasicIntegerArithmetic. */
+#include "integer_overflow.hpp"
+
+/*  Everything in BasicIntegerArithmetic is a constant expression, so the     *
+ *  compiler checks these while compiling, and nothing is computed at run     *
+ *  time. If any of them were false, the program would not compile.           */
+static_assert(IntegerArithmetic::max_number + 1U == 0U,
+              "the largest unsigned int plus one wraps around to zero");
+
+static_assert(BasicIntegerArithmetic<unsigned char>::number_of_bits == 8,
+              "a byte has eight bits");
+
+static_assert(BasicIntegerArithmetic<int>::add(
+                  BasicIntegerArithmetic<int>::max_number, 1
+              ).overflowed, "the largest int plus one overflows");
+
+static_assert(!BasicIntegerArithmetic<long long>::multiply(
+                  -3037000499LL, 3037000499LL
+              ).overflowed, "3037000499 is sqrt(2^63), rounded down");
+
+static_assert(BasicIntegerArithmetic<signed char>::multiply(-128, -1).value ==
+              -128, "-128 * -1 overflows back to -128");
+
+/*  Prints the number of bits, smallest value, and largest value of a type.   */
+template <typename Integer>
+static void print_properties(const char * const name)
+{
+    typedef BasicIntegerArithmetic<Integer> Arithmetic;
+
+    /*  long long and unsigned long long hold every value of the smaller      *
+     *  types, so each is printed as one of these two.                        */
+    typedef long long int Signed;
+    typedef unsigned long long int Unsigned;
+
+    if (std::numeric_limits<Integer>::is_signed)
+        std::printf("%-18s %4d %20lld %20lld\n",
+                    name, Arithmetic::number_of_bits,
+                    static_cast<Signed>(Arithmetic::min_number),
+                    static_cast<Signed>(Arithmetic::max_number));
+    else
+        std::printf("%-18s %4d %20llu %20llu\n",
+                    name, Arithmetic::number_of_bits,
+                    static_cast<Unsigned>(Arithmetic::min_number),
+                    static_cast<Unsigned>(Arithmetic::max_number));
+}
+/*  End of print_properties.                                                  */
+
+/*  Prints the result of a checked operation on ints.                         */
+static void print_result(const char * const expression,
+                         BasicIntegerArithmetic<int>::Result result)
+{
+    std::printf("%-24s = %11d%s\n", expression, result.value,
+                result.overflowed ? " (overflowed)" : "");
+}
+/*  End of print_result.                                                      */
+
+/*  Sums random 32-bit numbers in 32 bits, first with the ordinary +, then    *
+ *  with the checked add, counting the overflows, and then with the checked   *
+ *  array sum. The checksums and the counts are printed, so the compiler can  *
+ *  not skip any of the work.                                                 */
+static void benchmark(void)
+{
+    /*  The number of inputs, and the number of passes over them.             */
+    const std::size_t number_of_values = 65536;
+    const std::size_t number_of_passes = 256;
+
+    std::vector<std::uint32_t> values(number_of_values);
+    std::uint64_t state = 1U;
+    std::uint32_t plain_sum = 0U, checked_sum = 0U, array_sum = 0U;
+    std::size_t index, pass, overflows = 0, array_overflows = 0;
+
+    /*  A linear congruential generator, keeping the top 32 bits.             */
+    for (index = 0; index < number_of_values; ++index)
+    {
+        state = state * 6364136223846793005U + 1442695040888963407U;
+        values[index] = static_cast<std::uint32_t>(state >> 32);
+    }
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for (pass = 0; pass < number_of_passes; ++pass)
+        for (index = 0; index < number_of_values; ++index)
+            plain_sum += values[index];
+
+    const std::chrono::steady_clock::time_point middle =
+        std::chrono::steady_clock::now();
+
+    for (pass = 0; pass < number_of_passes; ++pass)
+    {
+        for (index = 0; index < number_of_values; ++index)
+        {
+            const BasicIntegerArithmetic<std::uint32_t>::Result result =
+                BasicIntegerArithmetic<std::uint32_t>::add(
+                    checked_sum, values[index]
+                );
+
+            checked_sum = result.value;
+            overflows += result.overflowed;
+        }
+    }
+
+    const std::chrono::steady_clock::time_point checked_end =
+        std::chrono::steady_clock::now();
+
+    /*  The array routine checks the whole sum at once. It only says whether  *
+     *  the total overflowed, not how many times, but it is vectorized.       */
+    for (pass = 0; pass < number_of_passes; ++pass)
+    {
+        const BasicIntegerArithmetic<std::uint32_t>::Result result =
+            BasicIntegerArithmetic<std::uint32_t>::sum(
+                values.data(), number_of_values
+            );
+
+        array_sum += result.value;
+        array_overflows += result.overflowed;
+    }
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    const double additions = static_cast<double>(number_of_values) *
+                             static_cast<double>(number_of_passes);
+
+    const double plain =
+        std::chrono::duration<double, std::nano>(middle - start).count();
+
+    const double checked =
+        std::chrono::duration<double, std::nano>(checked_end - middle).count();
+
+    const double array =
+        std::chrono::duration<double, std::nano>(end - checked_end).count();
+
+    const bool agree = (plain_sum == checked_sum && plain_sum == array_sum);
+
+    std::printf("Sums agree: %s, overflows: %lu, overflowing passes: %lu\n",
+                agree ? "yes" : "no",
+                static_cast<unsigned long int>(overflows),
+                static_cast<unsigned long int>(array_overflows));
+
+    std::printf("    plain:   %6.3f ns/addition\n", plain / additions);
+    std::printf("    checked: %6.3f ns/addition\n", checked / additions);
+    std::printf("    array:   %6.3f ns/addition\n", array / additions);
+}
+/*  End of benchmark.                                                         */
+
+/*  A short program for testing our functions.                                */
+int main(void)
+{
+    /*  The same three lines as integer_overflow.c.                           */
+    const int number_of_bits = IntegerArithmetic::number_of_bits;
+    const unsigned int max_number = IntegerArithmetic::max_number;
+    const unsigned int max_number_plus_one = max_number + 1U;
+
+    std::printf("Total Number of Bits: %d\n", number_of_bits);
+    std::printf("Largest Integer Value: %u\n", max_number);
+    std::printf("Largest Value Plus One: %u\n\n", max_number_plus_one);
+
+    /*  The same for every integer type.                                      */
+    std::printf("%-18s %4s %20s %20s\n",
+                "type", "bits", "smallest", "largest");
+    print_properties<signed char>("signed char");
+    print_properties<unsigned char>("unsigned char");
+    print_properties<short int>("short");
+    print_properties<unsigned short int>("unsigned short");
+    print_properties<int>("int");
+    print_properties<unsigned int>("unsigned int");
+    print_properties<long int>("long");
+    print_properties<unsigned long int>("unsigned long");
+    print_properties<long long int>("long long");
+    print_properties<unsigned long long int>("unsigned long long");
+    std::printf("\n");
+
+    /*  For int, overflow is undefined behavior, and the ordinary + and * may *
+     *  not be used at all when the result is too big. The checked versions   *
+     *  say so, and give the result wrapped around.                           */
+    const int max_int = BasicIntegerArithmetic<int>::max_number;
+    const int min_int = BasicIntegerArithmetic<int>::min_number;
+
+    print_result("2147483647 + 1",
+                 BasicIntegerArithmetic<int>::add(max_int, 1));
+    print_result("-2147483648 + -1",
+                 BasicIntegerArithmetic<int>::add(min_int, -1));
+    print_result("2147483647 + -2147483648",
+                 BasicIntegerArithmetic<int>::add(max_int, min_int));
+    print_result("65536 * 32768",
+                 BasicIntegerArithmetic<int>::multiply(65536, 32768));
+    print_result("-65536 * 32768",
+                 BasicIntegerArithmetic<int>::multiply(-65536, 32768));
+    print_result("-2147483648 * -1",
+                 BasicIntegerArithmetic<int>::multiply(min_int, -1));
+    std::printf("\n");
+
+    /*  The saturated versions stop at the limits instead, so the largest     *
+     *  value plus one stays the largest value, rather than going back to     *
+     *  zero.                                                                 */
+    std::printf("Largest Value Plus One, Saturated: %u\n",
+                IntegerArithmetic::add_saturated(max_number, 1U));
+    std::printf("2147483647 + 1, Saturated: %d\n",
+                BasicIntegerArithmetic<int>::add_saturated(max_int, 1));
+    std::printf("-2147483648 - 1, Saturated: %d\n",
+                BasicIntegerArithmetic<int>::subtract_saturated(min_int, 1));
+    std::printf("-65536 * 65536, Saturated: %d\n\n",
+                BasicIntegerArithmetic<int>::multiply_saturated(-65536, 65536));
+
+    /*  Checking every addition of a long sum.                                */
+    benchmark();
+    return 0;
+}
+
+/*  We can execute this on GNU, Linux, FreeBSD, macOS, etc., via:             *
+ *      c++ integer_overflow.cpp -o main                                      *
+ *      ./main                                                                *
+ *  This will output the following:                                           *
+ *      Total Number of Bits: 32                                              *
+ *      Largest Integer Value: 4294967295                                     *
+ *      Largest Value Plus One: 0                                             *
+ *                                                                            *
+ *      type               bits             smallest              largest     *
+ *      signed char           8                 -128                  127     *
+ *      unsigned char         8                    0                  255     *
+ *      short                16               -32768                32767     *
+ *      unsigned short       16                    0                65535     *
+ *      int                  32          -2147483648           2147483647     *
+ *      unsigned int         32                    0           4294967295     *
+ *      long                 64 -9223372036854775808  9223372036854775807     *
+ *      unsigned long        64                    0 18446744073709551615     *
+ *      long long            64 -9223372036854775808  9223372036854775807     *
+ *      unsigned long long   64                    0 18446744073709551615     *
+ *                                                                            *
+ *      2147483647 + 1           = -2147483648 (overflowed)                   *
+ *      -2147483648 + -1         =  2147483647 (overflowed)                   *
+ *      2147483647 + -2147483648 =          -1                                *
+ *      65536 * 32768            = -2147483648 (overflowed)                   *
+ *      -65536 * 32768           = -2147483648                                *
+ *      -2147483648 * -1         = -2147483648 (overflowed)                   *
+ *                                                                            *
+ *      Largest Value Plus One, Saturated: 4294967295                         *
+ *      2147483647 + 1, Saturated: 2147483647                                 *
+ *      -2147483648 - 1, Saturated: -2147483648                               *
+ *      -65536 * 65536, Saturated: -2147483648                                *
+ *                                                                            *
+ *      Sums agree: yes, overflows: 8401642, overflowing passes: 256          *
+ *  followed by the time per addition for the ordinary sum, the sum checked   *
+ *  one addition at a time, and the checked array sum. The times depend on    *
+ *  the machine. The ordinary sum and the array sum are done several numbers  *
+ *  at a time with vector instructions, and the checked sum one addition at a *
+ *  time, since each one needs the carry flag, so it is several times slower. *
+ *  The checks on constants cost nothing, they are done by the compiler.      *
+ *                                                                            *
+ *  On Windows you will need to install a C++ compiler. Microsoft's MSVC is a *
+ *  common option. Using MSVC, type:                                          *
+ *      cl /std:c++17 /O2 integer_overflow.cpp /link /out:main.exe            *
+ *      main.exe                                                              *
+ *  MSVC does not have the built-in functions, and uses the portable code,    *
+ *  which gives the same output.                                              */
@@ -0,0 +1,627 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Header-only, compile-time properties of integer types, and addition,  *
+ *      subtraction, and multiplication that detect overflow.                 *
+ *  Notes:                                                                    *
+ *      Provides BasicIntegerArithmetic<Integer> and the IntegerArithmetic    *
+ *      typedef. integer_overflow.c computes the number of bits and the       *
+ *      largest value of unsigned int with loops. These are known to the      *
+ *      compiler, and here they are constants that cost nothing at run time.  *
+ *      There are also saturating versions, and versions for whole arrays     *
+ *      that return overflow masks instead of branching, which the compiler   *
+ *      can vectorize.                                                        *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/09/27                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_INTEGER_OVERFLOW_HPP
+#define MITX_INTEGER_OVERFLOW_HPP
+
+/*  std::numeric_limits, which knows the properties of every integer type.    */
+#include <limits>
+
+/*  The std::size_t data type, used for the lengths of arrays, is found here. */
+#include <cstddef>
+
+/*  std::make_unsigned, std::conditional, and std::is_same are found here.    */
+#include <type_traits>
+
+/*  GCC and clang have built-in functions that compute a sum, difference, or  *
+ *  product, and report whether it overflowed. They compile to the arithmetic *
+ *  instruction followed by a jump on the overflow or carry flag, which is as *
+ *  cheap as it gets, and they may be used in constant expressions. GCC has   *
+ *  had them since version 5, and allows them in constant expressions since   *
+ *  version 7. Other compilers, MSVC in particular, use the portable code     *
+ *  below.                                                                    */
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_add_overflow) && \
+    __has_builtin(__builtin_sub_overflow) && \
+    __has_builtin(__builtin_mul_overflow)
+#define MITX_HAS_OVERFLOW_BUILTINS
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 7
+#define MITX_HAS_OVERFLOW_BUILTINS
+#endif
+
+/*  Class providing the properties of an integer type, and checked arithmetic *
+ *  for it. Integer may be any of the signed or unsigned integer types, from  *
+ *  signed char to unsigned long long. Everything is constexpr, so it can be  *
+ *  used in constant expressions and templates, and when used with constants  *
+ *  the compiler computes the result and nothing is left for run time.        */
+template <typename Integer>
+class BasicIntegerArithmetic {
+
+    static_assert(std::numeric_limits<Integer>::is_integer,
+                  "BasicIntegerArithmetic needs an integer type");
+
+    static_assert(!std::is_same<Integer, bool>::value,
+                  "bool is not an arithmetic type here");
+
+    /*  Wrapping arithmetic is done in the unsigned type of the same size,    *
+     *  where it is well defined. Types narrower than int are promoted to int *
+     *  before any arithmetic, and the product of two unsigned shorts may     *
+     *  overflow int, which is undefined. Computing in at least unsigned int  *
+     *  avoids this.                                                          */
+    typedef typename std::make_unsigned<Integer>::type Unsigned;
+    typedef typename std::common_type<Unsigned, unsigned int>::type Wide;
+
+    /*  The sum, product, and difference modulo 2^N, where N is the number of *
+     *  bits. Converting the result back to a signed type was                 *
+     *  implementation-defined before C++20, and every compiler keeps the low *
+     *  N bits, the same as the hardware does.                                */
+    static constexpr Integer wrapped_sum(Integer a, Integer b)
+    {
+        return static_cast<Integer>(static_cast<Unsigned>(
+            static_cast<Wide>(static_cast<Unsigned>(a)) +
+            static_cast<Wide>(static_cast<Unsigned>(b))
+        ));
+    }
+    /*  End of wrapped_sum.                                                   */
+
+    static constexpr Integer wrapped_product(Integer a, Integer b)
+    {
+        return static_cast<Integer>(static_cast<Unsigned>(
+            static_cast<Wide>(static_cast<Unsigned>(a)) *
+            static_cast<Wide>(static_cast<Unsigned>(b))
+        ));
+    }
+    /*  End of wrapped_product.                                               */
+
+    static constexpr Integer wrapped_difference(Integer a, Integer b)
+    {
+        return static_cast<Integer>(static_cast<Unsigned>(
+            static_cast<Wide>(static_cast<Unsigned>(a)) -
+            static_cast<Wide>(static_cast<Unsigned>(b))
+        ));
+    }
+    /*  End of wrapped_difference.                                            */
+
+    /*  We want the constants and functions visible outside the class.        */
+    public:
+
+        /*  The number of bits of the type, including the sign bit of a       *
+         *  signed type. numeric_limits counts the bits that hold the value,  *
+         *  digits, which is the loop in integer_overflow.c done by the       *
+         *  compiler. Padding bits, which no common platform has, are not     *
+         *  counted.                                                          */
+        static constexpr int number_of_bits =
+            std::numeric_limits<Integer>::digits +
+            (std::numeric_limits<Integer>::is_signed ? 1 : 0);
+
+        /*  The largest and smallest values of the type. For unsigned types   *
+         *  the largest is 2^N - 1, the sum computed by get_max_number in     *
+         *  integer_overflow.c, and the smallest is zero. For signed types    *
+         *  they are 2^(N-1) - 1 and -2^(N-1).                                */
+        static constexpr Integer max_number =
+            std::numeric_limits<Integer>::max();
+
+        static constexpr Integer min_number =
+            std::numeric_limits<Integer>::min();
+
+        /*  The result of a checked operation. value is the true result       *
+         *  modulo 2^N, so for unsigned types it is what the ordinary         *
+         *  operation gives, and overflowed says whether this differs from    *
+         *  the true result.                                                  */
+        struct Result {
+            Integer value;
+            bool overflowed;
+        };
+
+        /*  Computes a + b, and reports whether it overflowed. Signed         *
+         *  overflow is undefined behavior in C and C++, so the portable      *
+         *  version checks before adding: a + b > max exactly when b > 0 and  *
+         *  a > max - b, which can not overflow itself.                       */
+        static constexpr Result add(Integer a, Integer b)
+        {
+            Result result = {0, false};
+
+#if defined(MITX_HAS_OVERFLOW_BUILTINS)
+            result.overflowed = __builtin_add_overflow(a, b, &result.value);
+#else
+            result.value = wrapped_sum(a, b);
+
+            if (std::numeric_limits<Integer>::is_signed)
+                result.overflowed = (b > 0 && a > max_number - b) ||
+                                    (b < 0 && a < min_number - b);
+
+            /*  For unsigned types the sum wraps around, and it overflowed    *
+             *  exactly when it is smaller than a.                            */
+            else
+                result.overflowed = result.value < a;
+#endif
+
+            return result;
+        }
+        /*  End of add.                                                       */
+
+        /*  Computes a * b, and reports whether it overflowed. The portable   *
+         *  version compares against max / b, or min / b, choosing the bound  *
+         *  by the signs. Division rounds towards zero, which is the right    *
+         *  direction in every case: for b < 0, a b <= max means a >= max /   *
+         *  b, rounded up.                                                    */
+        static constexpr Result multiply(Integer a, Integer b)
+        {
+            Result result = {0, false};
+
+#if defined(MITX_HAS_OVERFLOW_BUILTINS)
+            result.overflowed = __builtin_mul_overflow(a, b, &result.value);
+#else
+            result.value = wrapped_product(a, b);
+
+            if (a == 0 || b == 0)
+                result.overflowed = false;
+
+            else if (a > 0)
+            {
+                if (b > 0)
+                    result.overflowed = a > max_number / b;
+                else
+                    result.overflowed = b < min_number / a;
+            }
+
+            else
+            {
+                if (b > 0)
+                    result.overflowed = a < min_number / b;
+                else
+                    result.overflowed = a < max_number / b;
+            }
+#endif
+
+            return result;
+        }
+        /*  End of multiply.                                                  */
+
+        /*  Computes a - b, and reports whether it overflowed. a - b < min    *
+         *  exactly when b > 0 and a < min + b, and a - b > max exactly when  *
+         *  b < 0 and a > max + b.                                            */
+        static constexpr Result subtract(Integer a, Integer b)
+        {
+            Result result = {0, false};
+
+#if defined(MITX_HAS_OVERFLOW_BUILTINS)
+            result.overflowed = __builtin_sub_overflow(a, b, &result.value);
+#else
+            result.value = wrapped_difference(a, b);
+
+            if (std::numeric_limits<Integer>::is_signed)
+                result.overflowed = (b > 0 && a < min_number + b) ||
+                                    (b < 0 && a > max_number + b);
+
+            /*  For unsigned types the difference is negative exactly when b  *
+             *  is larger than a.                                             */
+            else
+                result.overflowed = a < b;
+#endif
+
+            return result;
+        }
+        /*  End of subtract.                                                  */
+
+    /*  The array routines below are written so the compiler can vectorize    *
+     *  them, which it only does for loops without branches. So they do not   *
+     *  use the checks above, they compute the result of every element, and   *
+     *  whether it overflowed, as bit masks. A mask is all ones when the      *
+     *  element overflowed and zero when it did not, the same as the vector   *
+     *  comparison instructions give, and picking between two results with a  *
+     *  mask is two logical operations.                                       */
+
+    /*  The 64-bit type of the same signedness. The product of two numbers of *
+     *  up to 32 bits fits in it, so it can be computed exactly and compared  *
+     *  against the limits, and so does the sum of many of them. 64-bit       *
+     *  products use the scalar check, which is not vectorized.               */
+    typedef typename std::conditional<
+        std::numeric_limits<Integer>::is_signed, long long int,
+        unsigned long long int
+    >::type Product;
+
+    /*  Returns 1 if the top bit, which is the sign bit for signed types, of  *
+     *  x is set, and 0 otherwise.                                            */
+    static constexpr Unsigned top_bit(Unsigned x)
+    {
+        return static_cast<Unsigned>(x >> (number_of_bits - 1));
+    }
+    /*  End of top_bit.                                                       */
+
+    /*  Returns all ones if bit is 1, and zero if it is 0.                    */
+    static constexpr Unsigned to_mask(Unsigned bit)
+    {
+        return static_cast<Unsigned>(
+            static_cast<Wide>(0U) - static_cast<Wide>(bit)
+        );
+    }
+    /*  End of to_mask.                                                       */
+
+    /*  Returns x where the mask is set, and y where it is not.               */
+    static constexpr Unsigned select(Unsigned mask, Unsigned x, Unsigned y)
+    {
+        return static_cast<Unsigned>((x & mask) | (y & ~mask));
+    }
+    /*  End of select.                                                        */
+
+    /*  The value a sum or difference saturates to when it overflows. For     *
+     *  signed types this is min if a is negative and max otherwise, since    *
+     *  the result overflowed in the direction of a. The two differ by one,   *
+     *  so it is max plus the sign bit of a. For unsigned types the sum       *
+     *  saturates to max, and the difference to zero.                         */
+    static constexpr Unsigned signed_limit(Unsigned a)
+    {
+        return static_cast<Unsigned>(
+            static_cast<Wide>(static_cast<Unsigned>(max_number)) +
+            static_cast<Wide>(top_bit(a))
+        );
+    }
+    /*  End of signed_limit.                                                  */
+
+    /*  Returns the overflow mask of x + y, given their sum modulo 2^N. A     *
+     *  signed sum overflowed exactly when its sign differs from the signs of *
+     *  both x and y, and an unsigned sum exactly when it is smaller than x.  */
+    static constexpr Unsigned sum_overflow(Unsigned x, Unsigned y, Unsigned sum)
+    {
+        if constexpr (std::numeric_limits<Integer>::is_signed)
+            return to_mask(top_bit(
+                static_cast<Unsigned>((x ^ sum) & (y ^ sum))
+            ));
+        else
+            return to_mask(static_cast<Unsigned>(sum < x));
+    }
+    /*  End of sum_overflow.                                                  */
+
+    /*  Sets sum to a + b modulo 2^N, and saturated to a + b clamped to the   *
+     *  range of the type, and returns the overflow mask.                     */
+    static constexpr Unsigned add_mask(Integer a, Integer b,
+                                       Unsigned &sum, Unsigned &saturated)
+    {
+        const Unsigned x = static_cast<Unsigned>(a);
+        const Unsigned y = static_cast<Unsigned>(b);
+
+        sum = static_cast<Unsigned>(
+            static_cast<Wide>(x) + static_cast<Wide>(y)
+        );
+
+        const Unsigned mask = sum_overflow(x, y, sum);
+
+        if constexpr (std::numeric_limits<Integer>::is_signed)
+            saturated = select(mask, signed_limit(x), sum);
+        else
+            saturated = static_cast<Unsigned>(sum | mask);
+
+        return mask;
+    }
+    /*  End of add_mask.                                                      */
+
+    /*  The same for a - b. A signed difference overflowed exactly when a and *
+     *  b have different signs, and the difference has the sign of b. An      *
+     *  unsigned difference overflowed exactly when b is larger than a.       */
+    static constexpr Unsigned subtract_mask(Integer a, Integer b,
+                                            Unsigned &difference,
+                                            Unsigned &saturated)
+    {
+        const Unsigned x = static_cast<Unsigned>(a);
+        const Unsigned y = static_cast<Unsigned>(b);
+        Unsigned mask = 0U;
+
+        difference = static_cast<Unsigned>(
+            static_cast<Wide>(x) - static_cast<Wide>(y)
+        );
+
+        if constexpr (std::numeric_limits<Integer>::is_signed)
+        {
+            const Unsigned signs = static_cast<Unsigned>(
+                (x ^ y) & (x ^ difference)
+            );
+
+            mask = to_mask(top_bit(signs));
+            saturated = select(mask, signed_limit(x), difference);
+        }
+        else
+        {
+            mask = to_mask(static_cast<Unsigned>(x < y));
+            saturated = static_cast<Unsigned>(difference & ~mask);
+        }
+
+        return mask;
+    }
+    /*  End of subtract_mask.                                                 */
+
+    /*  The same for a * b. A product that overflows saturates towards the    *
+     *  sign of the true product, which is negative exactly when a and b have *
+     *  different signs.                                                      */
+    static constexpr Unsigned multiply_mask(Integer a, Integer b,
+                                            Unsigned &product,
+                                            Unsigned &saturated)
+    {
+        if constexpr (number_of_bits <= 32)
+        {
+            const Product exact =
+                static_cast<Product>(a) * static_cast<Product>(b);
+
+            const Product low = static_cast<Product>(min_number);
+            const Product high = static_cast<Product>(max_number);
+            const Product clamped =
+                (exact < low ? low : (exact > high ? high : exact));
+
+            product = static_cast<Unsigned>(exact);
+            saturated = static_cast<Unsigned>(clamped);
+            return to_mask(static_cast<Unsigned>(exact != clamped));
+        }
+        else
+        {
+            const Result result = multiply(a, b);
+            const Unsigned mask = to_mask(result.overflowed);
+            const Unsigned x = static_cast<Unsigned>(a);
+            const Unsigned y = static_cast<Unsigned>(b);
+            Unsigned limit = static_cast<Unsigned>(max_number);
+
+            if constexpr (std::numeric_limits<Integer>::is_signed)
+                limit = signed_limit(static_cast<Unsigned>(x ^ y));
+
+            product = static_cast<Unsigned>(result.value);
+            saturated = select(mask, limit, product);
+            return mask;
+        }
+    }
+    /*  End of multiply_mask.                                                 */
+
+    /*  Applies Kernel, one of the three routines above, to a[k] and b[k] for *
+     *  k = 0, 1, ..., n - 1, and writes the results, and the overflow masks  *
+     *  unless Saturate is set. Returns the logical or of the masks, so the   *
+     *  caller can check for any overflow with a single comparison.           */
+    template <Unsigned (*Kernel)(Integer, Integer, Unsigned &, Unsigned &),
+              bool Saturate>
+    static Unsigned apply(const Integer *a, const Integer *b,
+                          Integer *out, Unsigned *overflow, std::size_t n)
+    {
+        Unsigned any = 0U;
+        std::size_t k;
+
+        for (k = 0; k < n; ++k)
+        {
+            Unsigned result = 0U, saturated = 0U;
+            const Unsigned mask = Kernel(a[k], b[k], result, saturated);
+
+            out[k] = static_cast<Integer>(Saturate ? saturated : result);
+            any = static_cast<Unsigned>(any | mask);
+
+            if constexpr (!Saturate)
+                overflow[k] = mask;
+        }
+
+        return any;
+    }
+    /*  End of apply.                                                         */
+
+    /*  We want the constants and functions visible outside the class.        */
+    public:
+
+        /*  The type of the overflow masks, the unsigned type of the same     *
+         *  size. Element k of a mask array is all ones if operation k        *
+         *  overflowed, and zero if it did not.                               */
+        typedef Unsigned Mask;
+
+        /*  a + b, a - b, and a * b, saturated. A result larger than max is   *
+         *  max, and a result smaller than min is min, so an overflowing      *
+         *  total stays as large as it can be, rather than wrapping around to *
+         *  a small number. These have no branches.                           */
+        static constexpr Integer add_saturated(Integer a, Integer b)
+        {
+            Unsigned sum = 0U, saturated = 0U;
+            add_mask(a, b, sum, saturated);
+            return static_cast<Integer>(saturated);
+        }
+        /*  End of add_saturated.                                             */
+
+        static constexpr Integer subtract_saturated(Integer a, Integer b)
+        {
+            Unsigned difference = 0U, saturated = 0U;
+            subtract_mask(a, b, difference, saturated);
+            return static_cast<Integer>(saturated);
+        }
+        /*  End of subtract_saturated.                                        */
+
+        static constexpr Integer multiply_saturated(Integer a, Integer b)
+        {
+            Unsigned product = 0U, saturated = 0U;
+            multiply_mask(a, b, product, saturated);
+            return static_cast<Integer>(saturated);
+        }
+        /*  End of multiply_saturated.                                        */
+
+        /*  Computes out[k] = a[k] + b[k] modulo 2^N for k = 0, 1, ..., n -   *
+         *  1, and sets overflow[k] to the overflow mask. Returns true if any *
+         *  of them overflowed. out may be the same array as a or b, so a +=  *
+         *  b is add(a, b, a, overflow, n).                                   */
+        static bool add(const Integer *a, const Integer *b,
+                        Integer *out, Mask *overflow, std::size_t n)
+        {
+            return apply<add_mask, false>(a, b, out, overflow, n) != 0U;
+        }
+        /*  End of add.                                                       */
+
+        /*  The same for out[k] = a[k] - b[k].                                */
+        static bool subtract(const Integer *a, const Integer *b,
+                             Integer *out, Mask *overflow, std::size_t n)
+        {
+            return apply<subtract_mask, false>(a, b, out, overflow, n) != 0U;
+        }
+        /*  End of subtract.                                                  */
+
+        /*  The same for out[k] = a[k] * b[k].                                */
+        static bool multiply(const Integer *a, const Integer *b,
+                             Integer *out, Mask *overflow, std::size_t n)
+        {
+            return apply<multiply_mask, false>(a, b, out, overflow, n) != 0U;
+        }
+        /*  End of multiply.                                                  */
+
+        /*  Computes out[k] = a[k] + b[k], saturated, for k = 0, 1, ..., n -  *
+         *  1. Returns true if any of them was saturated.                     */
+        static bool add_saturated(const Integer *a, const Integer *b,
+                                  Integer *out, std::size_t n)
+        {
+            return apply<add_mask, true>(a, b, out, NULL, n) != 0U;
+        }
+        /*  End of add_saturated.                                             */
+
+        /*  The same for out[k] = a[k] - b[k].                                */
+        static bool subtract_saturated(const Integer *a, const Integer *b,
+                                       Integer *out, std::size_t n)
+        {
+            return apply<subtract_mask, true>(a, b, out, NULL, n) != 0U;
+        }
+        /*  End of subtract_saturated.                                        */
+
+        /*  The same for out[k] = a[k] * b[k].                                */
+        static bool multiply_saturated(const Integer *a, const Integer *b,
+                                       Integer *out, std::size_t n)
+        {
+            return apply<multiply_mask, true>(a, b, out, NULL, n) != 0U;
+        }
+        /*  End of multiply_saturated.                                        */
+
+        /*  Computes values[0] + values[1] + ... + values[n - 1], and reports *
+         *  whether the true sum is outside the range of the type. Only the   *
+         *  final sum matters, so a total that goes over max and comes back,  *
+         *  as signed totals can, is not an overflow.                         */
+        static Result sum(const Integer *values, std::size_t n)
+        {
+            Result result = {0, false};
+
+            /*  Numbers of up to 32 bits are added in 64 bits. A block of     *
+             *  2^30 of them can not overflow a 64-bit total, so the only     *
+             *  checks are one per block, and one at the end. The loop within *
+             *  a block is an ordinary sum, which the compiler vectorizes,    *
+             *  widening the numbers as it loads them.                        */
+            if constexpr (number_of_bits <= 32)
+            {
+                typedef BasicIntegerArithmetic<Product> Total;
+                const std::size_t block = static_cast<std::size_t>(1) << 30;
+                Product total = 0;
+                std::size_t start, k;
+
+                for (start = 0; start < n; start += block)
+                {
+                    const std::size_t end =
+                        (n - start < block ? n : start + block);
+                    Product block_sum = 0;
+
+                    for (k = start; k < end; ++k)
+                        block_sum += static_cast<Product>(values[k]);
+
+                    const typename Total::Result partial =
+                        Total::add(total, block_sum);
+
+                    total = partial.value;
+                    result.overflowed = result.overflowed || partial.overflowed;
+                }
+
+                result.value =
+                    static_cast<Integer>(static_cast<Unsigned>(total));
+                result.overflowed = result.overflowed ||
+                                    total < static_cast<Product>(min_number) ||
+                                    total > static_cast<Product>(max_number);
+            }
+
+            /*  64-bit numbers can not be widened, so they are split into     *
+             *  their top 32 bits, h, and their bottom 32 bits, l, with x = h *
+             *  2^32 + l, and the two halves are summed separately. These are *
+             *  again ordinary sums, which the compiler vectorizes. The       *
+             *  bottom halves are moved into the top total after each block,  *
+             *  leaving a number below 2^32, and then the true sum is H 2^32  *
+             *  + L with 0 <= L < 2^32. This is in range exactly when H is in *
+             *  the range of the top halves, min / 2^32 <= H <= max / 2^32.   */
+            else
+            {
+                typedef BasicIntegerArithmetic<Product> Total;
+                const std::size_t block = static_cast<std::size_t>(1) << 30;
+                const Unsigned bottom = 0xFFFFFFFFU;
+                Product high = 0;
+                Unsigned low = 0U;
+                std::size_t start, k;
+
+                for (start = 0; start < n; start += block)
+                {
+                    const std::size_t end =
+                        (n - start < block ? n : start + block);
+
+                    Product block_high = 0;
+                    Unsigned block_low = 0U;
+
+                    for (k = start; k < end; ++k)
+                    {
+                        block_high += static_cast<Product>(values[k] >> 32);
+                        block_low += static_cast<Unsigned>(values[k]) & bottom;
+                    }
+
+                    /*  Carry the bottom halves into the top total.           */
+                    low += block_low;
+                    block_high += static_cast<Product>(low >> 32);
+                    low &= bottom;
+
+                    const typename Total::Result partial =
+                        Total::add(high, block_high);
+
+                    high = partial.value;
+                    result.overflowed = result.overflowed || partial.overflowed;
+                }
+
+                result.value = static_cast<Integer>(
+                    (static_cast<Unsigned>(high) << 32) | low
+                );
+
+                result.overflowed = result.overflowed ||
+                                    high < (min_number >> 32) ||
+                                    high > (max_number >> 32);
+            }
+
+            return result;
+        }
+        /*  End of sum.                                                       */
+};
+/*  End of BasicIntegerArithmetic definition.                                 */
+
+/*  integer_overflow.c works with unsigned int.                               */
+typedef BasicIntegerArithmetic<unsigned int> IntegerArithmetic;
+
+#endif
+/*  End of include guard.                                                     */
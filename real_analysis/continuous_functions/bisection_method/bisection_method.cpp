@@ -19,6 +19,9 @@
  ******************************************************************************
  *  Purpose:                                                                  *
  *      Calculates the root of a function using the bisection method.         *
+ *  Notes:                                                                    *
+ *      The solver is in bisection_method.hpp. This file shows how to use it, *
+ *      and benchmarks it.                                                    *
  ******************************************************************************
  *  Author: Ryan Maguire                                                      *
  *  Date:   2025/03/09                                                        *
@@ -27,122 +30,121 @@
 /*  stdio provides the "printf" function, used for printing text.             */
 #include <cstdio>
 
-/*  Floating-point absolute value function, fabs, provided here.              */
+/*  Floating-point sine function, sin, provided here.                         */
 #include <cmath>
 
+/*  Timing routines, used for benchmarking the two versions of root.          */
+#include <chrono>
+
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  The bisection method itself, in BasicBisection and Bisection.             */
+#include "bisection_method.hpp"
+
 /*  Function pointer notation is a little confusing. Create a typedef for it  *
  *  so we do not need to explicitly use it later.                             */
 typedef double (*function)(double);
 
-/*  Class providing an implementation of the bisection method.                */
-class Bisection {
-
-    /*  The error after n iterations is |b - a| / 2^n. Since double has a     *
-     *  52-bit mantissa, if |b - a| ~= 1, then after 52 steps we can halt the *
-     *  program. To allow for |b - a| to be larger, we stop the process after *
-     *  at most 64 iterations.                                                */
-    static const unsigned int maximum_number_of_iterations = 64U;
-
-    /*  We want the function visible outside the class. Declare it public.    */
-    public:
-
-        /*  Computes the root of a function using the bisection method.       */
-        static double root(function f, double a, double b)
-        {
-            /*  The maximum allowed error. This is double precision epsilon.  */
-            const double epsilon = 2.220446049250313E-16;
-
-            /*  Variable for keeping track of the number of iterations.       */
-            unsigned int iters;
-
-            /*  The midpoint for the bisection. This updates as we iterate.   */
-            double midpoint;
-
-            /*  We do not require a < b, nor f(a) < f(b). We need one of      *
-             *  these to evaluate negative under f and one to evaluate to     *
-             *  positive. Call the negative entry left and positive one right.*/
-            double left, right;
-
-            /*  Evaluate f at the endpoints to determine which is positive    *
-             *  and which is negative, transforming [a, b] to [left, right].  */
-            const double a_eval = f(a);
-            const double b_eval = f(b);
-
-            /*  Rare case, f(a) = 0. Return a, no bisection needed.           */
-            if (a_eval == 0.0)
-                return a;
-
-            /*  Similarly, if f(b) = 0, then we found the root. Return b.     */
-            if (b_eval == 0.0)
-                return b;
-
-            /*  Compare the two evaluations and set the left and right values.*/
-            if (a_eval < b_eval)
-            {
-                /*  If both evaluations are negative, or if both are positive,*
-                 *  then the bisection method will not work. Return NaN.      */
-                if (b_eval < 0.0 || a_eval > 0.0)
-                    return (a - a) / (a - a);
-
-                /*  Otherwise, since f(a) < f(b), set left = a and right = b. */
-                left = a;
-                right = b;
-            }
-
-            /*  In this case the function starts positive and goes negative.  */
-            else
-            {
-                /*  Same sanity check as before. We need one evaluation to be *
-                 *  negative and one to be positive. Abort if the signs agree.*/
-                if (a_eval < 0.0 || b_eval > 0.0)
-                    return (a - a) / (a - a);
-
-                /*  Since f(a) > f(b), set left = b and right = a.            */
-                left = b;
-                right = a;
-            }
-
-            /*  Start the bisection method. Compute the midpoint of a and b.  */
-            midpoint = 0.5 * (a + b);
-
-            /*  Iteratively divide the range in half to find the root.        */
-            for (iters = 0; iters < maximum_number_of_iterations; ++iters)
-            {
-                /*  If f(x) is very small, we are close to a root and can     *
-                 *  break out of this for loop. Check for this.               */
-                const double eval = f(midpoint);
-
-                if (std::fabs(eval) <= epsilon)
-                    break;
-
-                /*  Apply bisection to get a better approximation. We have    *
-                 *  f(left) < 0 < f(right). If f(midpoint) < 0, replace the   *
-                 *  interval [left, right] with [midpoint, right]. Set left   *
-                 *  to the midpoint and set midpoint to be closer to right.   */
-                if (eval < 0.0)
-                {
-                    left = midpoint;
-                    midpoint = 0.5 * (midpoint + right);
-                }
-
-                /*  If f(midpoint) > 0, then replace right with the midpoint, *
-                 *  changing [left, right] into [left, midpoint]. We then set *
-                 *  the midpoint to be closer to left.                        */
-                else
-                {
-                    right = midpoint;
-                    midpoint = 0.5 * (left + midpoint);
-                }
-            }
-
-            /*  After n iterations, we are at most |b - a| / 2^n from the     *
-             *  root of the function. 1 / 2^n goes to zero very quickly,      *
-             *  meaning the convergence is very quick.                        */
-            return midpoint;
-        }
-        /*  End of root.                                                      */
-};
-/*  End of Bisection definition.                                              */
+/*  sqrt(2) is a root to the function f(x) = 2 - x^2. This is cheap to        *
+ *  evaluate, so the cost of calling it is a large part of the total.         */
+static double func(double x)
+{
+    return 2.0 - x*x;
+}
+/*  End of func.                                                              */
+
+/*  Finds sqrt(2) many times using brackets [1, b] with b slightly varied,    *
+ *  and prints the average time per root. The same routine is used for the    *
+ *  function pointer and for the lambda.                                      */
+template <typename Function>
+static void benchmark(Function f, const char * const name)
+{
+    /*  The number of roots to compute.                                       */
+    const unsigned int number_of_calls = 200000U;
+
+    /*  Running sum to keep the compiler from discarding the work.            */
+    double sum = 0.0;
+
+    /*  Variable for looping over the calls.                                  */
+    unsigned int index;
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for (index = 0U; index < number_of_calls; ++index)
+        sum += Bisection::root(f, 1.0, 2.0 + 1.0E-6 * index);
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::printf("%-17s %7.2f ns/root (checksum %.6f)\n",
+                name, nanoseconds / number_of_calls, sum / number_of_calls);
+}
+/*  End of benchmark.                                                         */
+
+/*  Compares looping over brackets with the scalar root function against the  *
+ *  batched root function, using the cheap function 2 - x^2.                  */
+static void benchmark_batch(void)
+{
+    /*  The number of brackets, and arrays for the data.                      */
+    const std::size_t number_of_brackets = 200000;
+    static double left_ends[number_of_brackets];
+    static double right_ends[number_of_brackets];
+    static double scalar_roots[number_of_brackets];
+    static double batched_roots[number_of_brackets];
+
+    /*  Variables for looping over the brackets and counting mismatches.      */
+    std::size_t index;
+    std::size_t mismatches = 0;
+
+    /*  The right end is varied so that every bracket is different.           */
+    for (index = 0; index < number_of_brackets; ++index)
+    {
+        left_ends[index] = 1.0;
+        right_ends[index] = 2.0 + 1.0E-6 * static_cast<double>(index);
+    }
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for (index = 0; index < number_of_brackets; ++index)
+        scalar_roots[index] = Bisection::root(
+            [](double x) { return 2.0 - x*x; },
+            left_ends[index], right_ends[index]
+        );
+
+    const std::chrono::steady_clock::time_point middle =
+        std::chrono::steady_clock::now();
+
+    Bisection::root(
+        [](double x) { return 2.0 - x*x; },
+        left_ends, right_ends, batched_roots, number_of_brackets
+    );
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    const double scalar =
+        std::chrono::duration<double, std::nano>(middle - start).count();
+
+    const double batched =
+        std::chrono::duration<double, std::nano>(end - middle).count();
+
+    for (index = 0; index < number_of_brackets; ++index)
+        if (scalar_roots[index] != batched_roots[index])
+            ++mismatches;
+
+    std::printf("%-17s %7.2f ns/root\n",
+                "Scalar loop:", scalar / number_of_brackets);
+    std::printf("%-17s %7.2f ns/root (%lu mismatches)\n",
+                "Batched:", batched / number_of_brackets,
+                static_cast<unsigned long int>(mismatches));
+}
+/*  End of benchmark_batch.                                                   */
 
 /*  Main routine used for testing our implementation of the Bisection method. */
 int main(void)
@@ -156,5 +158,147 @@ int main(void)
     const double pi = Bisection::root(std::sin, a, b);
     std::printf("pi = %.16f\n", pi);
 
+    /*  std::sin is not constexpr, so we can not compute pi at compile time.  *
+     *  Instead, compute the cube root of 2, a root of x^3 - 2, in [1, 2].    *
+     *  The static_assert proves that no work is done at run time.            */
+    constexpr double cbrt_2 = Bisection::constexpr_root(
+        [](double x) { return x*x*x - 2.0; }, 1.0, 2.0
+    );
+
+    static_assert(cbrt_2 > 1.2599 && cbrt_2 < 1.2600,
+                  "The cube root of 2 should be about 1.25992");
+
+    std::printf("cbrt(2) = %.16f\n", cbrt_2);
+
+    /*  The function pointer is read from a volatile variable. Otherwise the  *
+     *  compiler sees which function it points to and inlines it anyway,      *
+     *  which is not what happens when the pointer is stored elsewhere.       */
+    function volatile func_pointer = func;
+
+    /*  Compare the cost of the indirect call with the inlined lambda.        */
+    benchmark(static_cast<function>(func_pointer), "Function pointer:");
+    benchmark([](double x) { return 2.0 - x*x; }, "Lambda:");
+
+    /*  The batched routine should give exactly the same roots as calling     *
+     *  root for every bracket. Find k pi for k = 1, 2, ..., N using the      *
+     *  brackets [k pi - 1, k pi + 1], with a few bad brackets mixed in.      */
+    const std::size_t number_of_brackets = 1000;
+    double left_ends[number_of_brackets];
+    double right_ends[number_of_brackets];
+    double roots[number_of_brackets];
+    std::size_t index;
+    std::size_t mismatches = 0;
+
+    for (index = 0; index < number_of_brackets; ++index)
+    {
+        const double k = static_cast<double>(index + 1);
+        const double center = 3.141592653589793 * k;
+
+        /*  Every 100th bracket has no sign change, the answer is NaN.        */
+        const double width = (index % 100 == 0 ? 0.1 : 1.0);
+        left_ends[index] = center + (index % 100 == 0 ? 0.5 : -width);
+        right_ends[index] = center + width + (index % 100 == 0 ? 0.5 : 0.0);
+    }
+
+    Bisection::root(std::sin, left_ends, right_ends, roots, number_of_brackets);
+
+    /*  NaN is not equal to itself, so NaN's need to be compared separately.  */
+    for (index = 0; index < number_of_brackets; ++index)
+    {
+        const double expected = Bisection::root(
+            std::sin, left_ends[index], right_ends[index]
+        );
+
+        const bool both_nan = (expected != expected) &&
+                              (roots[index] != roots[index]);
+
+        if (expected != roots[index] && !both_nan)
+            ++mismatches;
+    }
+
+    std::printf("Batched mismatches: %lu of %lu\n",
+                static_cast<unsigned long int>(mismatches),
+                static_cast<unsigned long int>(number_of_brackets));
+
+    benchmark_batch();
+
+    /*  The detailed result for pi, and for a bracket with no root.           */
+    const Bisection::Result detailed = Bisection::detailed_root(std::sin, a, b);
+    const Bisection::Result bad = Bisection::detailed_root(std::sin, 1.0, 2.0);
+
+    std::printf("pi: %u iterations, %u evaluations, converged: %d\n",
+                detailed.iterations, detailed.evaluations, detailed.converged);
+
+    std::printf("[1, 2]: %u iterations, %u evaluations, converged: %d\n",
+                bad.iterations, bad.evaluations, bad.converged);
+
+    /*  Callers that only need pi to 8 digits may say so. Asking for the      *
+     *  bracket to be narrower than 10^-8 relative to x halves the work.      */
+    const Bisection::Options loose = {1.0E-08, 64U, Bisection::Relative};
+    const Bisection::Result quick = Bisection::detailed_root(
+        [](double t) { return std::sin(t); }, a, b, loose
+    );
+
+    std::printf("pi to 1E-8: %.16f, %u evaluations\n",
+                quick.root, quick.evaluations);
+
+    /*  The class works for every type of real number. float has 24 bits of   *
+     *  precision, so it stops after far fewer steps than double does, and    *
+     *  the 80-bit long double, where available, goes a little further.       */
+    const BasicBisection<float>::Result pi_float =
+        BasicBisection<float>::detailed_root(
+            [](float t) { return std::sin(t); }, 3.0F, 4.0F
+        );
+
+    const BasicBisection<long double>::Result pi_long =
+        BasicBisection<long double>::detailed_root(
+            [](long double t) { return std::sin(t); }, 3.0L, 4.0L
+        );
+
+    std::printf("float:       %.8f, %u evaluations\n",
+                static_cast<double>(pi_float.root), pi_float.evaluations);
+
+    std::printf("long double: %.19Lf, %u evaluations\n",
+                pi_long.root, pi_long.evaluations);
+
+#if defined(SOLVER_STATISTICS)
+    Bisection::print_statistics();
+#endif
+
     return 0;
 }
+
+/*  We can execute this on GNU, Linux, FreeBSD, macOS, etc., via:             *
+ *      c++ bisection_method.cpp -o main                                      *
+ *      ./main                                                                *
+ *  This will output the following:                                           *
+ *      pi = 3.1415926535897931                                               *
+ *      cbrt(2) = 1.2599210498948732                                          *
+ *  followed by the timings for the function pointer and the lambda. These    *
+ *  depend on the machine, but the lambda is typically much faster. Next is   *
+ *      Batched mismatches: 0 of 1000                                         *
+ *  and the timings for the scalar and batched routines. Last is the detailed *
+ *  result for pi, and for a bracket with no root:                            *
+ *      pi: 47 iterations, 50 evaluations, converged: 1                       *
+ *      [1, 2]: 0 iterations, 2 evaluations, converged: 0                     *
+ *      pi to 1E-8: 3.1415926665067673, 27 evaluations                        *
+ *      float:       3.14159274, 24 evaluations                               *
+ *      long double: 3.1415926535897932385, 64 evaluations                    *
+ *  The long double line depends on the platform. With MSVC, long double is   *
+ *  the same as double.                                                       *
+ *  To enable vector instructions for the batched routine, tell the compiler  *
+ *  what hardware to target. For example:                                     *
+ *      c++ -O2 -march=native bisection_method.cpp -o main                    *
+ *  To count the calls and iterations, and print a histogram at the end, add  *
+ *  -DSOLVER_STATISTICS to the command.                                       *
+ *  To record every iteration, or time every call, add -DSOLVER_TRACING, and  *
+ *  run the program with SOLVER_TRACE set to 1, 2, or 3. This needs C++17,    *
+ *  see solver_tracing.cpp for the details.                                   *
+ *  Lambdas can only be used in constant expressions starting with C++17. Old *
+ *  compilers may need the -std=c++17 option for this.                        *
+ *                                                                            *
+ *  On Windows you will need to install a C++ compiler. Microsoft's MSVC is a *
+ *  common option. Using MSVC, type:                                          *
+ *      cl /std:c++17 bisection_method.cpp /link /out:main.exe                *
+ *      main.exe                                                              *
+ *  This will produce the same output.                                        */
@@ -0,0 +1,1088 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Header-only implementation of the bisection method for finding roots. *
+ *  Notes:                                                                    *
+ *      Provides BasicBisection<Real> and the Bisection typedef. Everything   *
+ *      is a template, so including this file is all that is needed, and the  *
+ *      compiler can inline the function being solved into the solver's loop. *
+ *      bisection_method.cpp shows how it is used.                            *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/30                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_BISECTION_METHOD_HPP
+#define MITX_BISECTION_METHOD_HPP
+
+/*  stdio provides the "printf" function, used for printing text.             */
+#include <cstdio>
+
+/*  Floating-point absolute value function, fabs, provided here.              */
+#include <cmath>
+
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  std::numeric_limits, used for a compile-time NaN, provided here.          */
+#include <limits>
+
+/*  Statistics about every call to root may optionally be kept. This is off   *
+ *  by default, since it costs a little time. Compile with                    *
+ *  -DSOLVER_STATISTICS to turn it on. The counters are atomic, so the solver *
+ *  may still be called from several threads at once.                         */
+#if defined(SOLVER_STATISTICS)
+#include <atomic>
+#endif
+
+/*  Each iteration of root may also be traced, and each call timed. This is   *
+ *  off by default, and compiles to nothing. Compile with -DSOLVER_TRACING to *
+ *  turn it on, see solver_tracing.hpp for the details.                       */
+#if defined(SOLVER_TRACING)
+#include "../solver_tracing/solver_tracing.hpp"
+#endif
+
+/*  Vector intrinsics, used by the batched root finder. We pick the widest    *
+ *  instruction set the compiler is targeting, and fall back to plain scalar  *
+ *  code if none is available.                                                */
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/*  Class providing an implementation of the bisection method. The class is a *
+ *  template over the type of real number, Real, which may be float, double,  *
+ *  or long double. Each step gains one bit, so float needs fewer steps than  *
+ *  double, and the tolerance comes from the precision of Real.               */
+template <typename Real>
+class BasicBisection {
+
+    /*  The error after n iterations is |b - a| / 2^n. Since double has a     *
+     *  52-bit mantissa, if |b - a| ~= 1, then after 52 steps we can halt the *
+     *  program. To allow for |b - a| to be larger, we stop the process after *
+     *  at most 64 iterations. In general we allow 11 more steps than there   *
+     *  are bits of precision in Real, which is 35 for float, 64 for          *
+     *  double, and 75 for the 80-bit long double.                            */
+    static const unsigned int maximum_number_of_iterations =
+        static_cast<unsigned int>(std::numeric_limits<Real>::digits) + 11U;
+
+    /*  std::fabs is not constexpr, so it can not be used when computing      *
+     *  values at compile time. The absolute value is easy to write.          */
+    static constexpr Real absolute_value(Real x)
+    {
+        return (x < 0.0 ? -x : x);
+    }
+    /*  End of absolute_value.                                                */
+
+    /*  The batched root finder works on this many brackets at once. Eight    *
+     *  doubles fill a 512-bit AVX-512 register, two AVX registers, or four   *
+     *  NEON registers, so this suits most hardware.                          */
+    static const std::size_t batch_lanes = 8;
+
+    /*  State for the lanes of the batched root finder. Lane k is bisecting   *
+     *  the bracket with index slot[k], and must stop once the pass counter   *
+     *  reaches deadline[k], which is maximum_number_of_iterations passes     *
+     *  after the lane was given its bracket. The numbers are stored as       *
+     *  arrays, structure-of-arrays style, so they can be loaded straight     *
+     *  into vector registers.                                                */
+    template <typename Number>
+    struct Lanes {
+        Number left[batch_lanes];
+        Number right[batch_lanes];
+        Number midpoint[batch_lanes];
+        std::size_t deadline[batch_lanes];
+        std::size_t slot[batch_lanes];
+    };
+
+    /*  The lanes used by the batched root finder. The update below has       *
+     *  vector instructions for Lanes<double>, and a scalar loop for every    *
+     *  other type.                                                           */
+    typedef Lanes<Real> BatchLanes;
+
+    /*  Gives lane k of the batched root finder a new bracket to work on.     *
+     *  Brackets that need no iterations (f(a) = 0, f(b) = 0, or f(a) and     *
+     *  f(b) have the same sign) are answered right away, exactly like the    *
+     *  root function does, and the next bracket is tried. Returns false if   *
+     *  we ran out of brackets, meaning the lane is now idle.                 */
+    template <typename Function>
+    static bool start_lane(Function f,
+                           const Real * const a,
+                           const Real * const b,
+                           Real * const out,
+                           std::size_t n,
+                           std::size_t &next,
+                           std::size_t pass,
+                           BatchLanes &lanes,
+                           std::size_t k)
+    {
+        /*  Factor for the midpoint, in the precision of Real.                */
+        const Real half = static_cast<Real>(0.5);
+
+        /*  Loop until we find a bracket that needs bisecting.                */
+        while (next < n)
+        {
+            /*  The bracket under consideration.                              */
+            const std::size_t index = next;
+            const Real a_eval = f(a[index]);
+            const Real b_eval = f(b[index]);
+
+            /*  Whatever happens below, this bracket is taken.                */
+            ++next;
+
+            /*  The same special cases as the root function. f(a) = 0 or f(b) *
+             *  = 0 are roots, and mismatched signs give NaN.                 */
+            if (a_eval == 0.0)
+                out[index] = a[index];
+
+            else if (b_eval == 0.0)
+                out[index] = b[index];
+
+            else if (a_eval < b_eval && (b_eval < 0.0 || a_eval > 0.0))
+                out[index] = (a[index] - a[index]) / (a[index] - a[index]);
+
+            else if (!(a_eval < b_eval) && (a_eval < 0.0 || b_eval > 0.0))
+                out[index] = (a[index] - a[index]) / (a[index] - a[index]);
+
+            /*  A genuine bracket. Set up [left, right] with f(left) < 0 and  *
+             *  f(right) > 0, and the first midpoint, as root does.           */
+            else
+            {
+                lanes.left[k] = (a_eval < b_eval ? a[index] : b[index]);
+                lanes.right[k] = (a_eval < b_eval ? b[index] : a[index]);
+                lanes.midpoint[k] = half * (a[index] + b[index]);
+                lanes.deadline[k] = pass + maximum_number_of_iterations;
+                lanes.slot[k] = index;
+                return true;
+            }
+        }
+
+        /*  No brackets left. This lane is now idle.                          */
+        return false;
+    }
+    /*  End of start_lane.                                                    */
+
+    /*  Performs one bisection step on every lane, without branches. Given    *
+     *  eval[k] = f(midpoint[k]), if eval[k] < 0 the midpoint becomes the new *
+     *  left end, otherwise it becomes the new right end. The new midpoint is *
+     *  the average of the two ends. This is the same value the root function *
+     *  computes, since 0.5 * (left + right) is either 0.5 * (midpoint +      *
+     *  right) or 0.5 * (left + midpoint). The old midpoints are saved in     *
+     *  previous. Returns a bit-mask with bit k set if |eval[k]| <= epsilon,  *
+     *  meaning lane k has converged.                                         */
+    static unsigned int update_lanes(const double * const eval,
+                                     Lanes<double> &lanes,
+                                     double * const previous)
+    {
+        /*  The maximum allowed error. This is double precision epsilon.      */
+        const double epsilon = 2.220446049250313E-16;
+
+        /*  Bit-mask of the converged lanes, computed below.                  */
+        unsigned int small = 0U;
+
+#if defined(__AVX512F__)
+
+        /*  All 8 lanes fit in a single AVX-512 register.                     */
+        const __m512d e = _mm512_loadu_pd(eval);
+        const __m512d m = _mm512_loadu_pd(lanes.midpoint);
+        const __m512d half = _mm512_set1_pd(0.5);
+
+        /*  Lanes with f(midpoint) < 0. NaN compares false, so NaN moves the  *
+         *  right end, just like the else branch of the root function.        */
+        const __mmask8 negative = _mm512_cmp_pd_mask(
+            e, _mm512_setzero_pd(), _CMP_LT_OQ
+        );
+
+        const __m512d left = _mm512_mask_blend_pd(
+            negative, _mm512_loadu_pd(lanes.left), m
+        );
+
+        const __m512d right = _mm512_mask_blend_pd(
+            negative, m, _mm512_loadu_pd(lanes.right)
+        );
+
+        _mm512_storeu_pd(previous, m);
+        _mm512_storeu_pd(lanes.left, left);
+        _mm512_storeu_pd(lanes.right, right);
+        _mm512_storeu_pd(
+            lanes.midpoint, _mm512_mul_pd(half, _mm512_add_pd(left, right))
+        );
+
+        small = _mm512_cmp_pd_mask(
+            _mm512_abs_pd(e), _mm512_set1_pd(epsilon), _CMP_LE_OQ
+        );
+
+#elif defined(__AVX__)
+
+        /*  Two AVX registers of 4 lanes each. AVX has no absolute value      *
+         *  instruction, clearing the sign bit with -0.0 does the job.        */
+        const __m256d half = _mm256_set1_pd(0.5);
+        const __m256d sign_bit = _mm256_set1_pd(-0.0);
+        const __m256d tolerance = _mm256_set1_pd(epsilon);
+        std::size_t k;
+
+        for (k = 0; k < batch_lanes; k += 4)
+        {
+            const __m256d e = _mm256_loadu_pd(eval + k);
+            const __m256d m = _mm256_loadu_pd(lanes.midpoint + k);
+
+            /*  Lanes with f(midpoint) < 0. NaN compares false.               */
+            const __m256d negative = _mm256_cmp_pd(
+                e, _mm256_setzero_pd(), _CMP_LT_OQ
+            );
+
+            const __m256d left = _mm256_blendv_pd(
+                _mm256_loadu_pd(lanes.left + k), m, negative
+            );
+
+            const __m256d right = _mm256_blendv_pd(
+                m, _mm256_loadu_pd(lanes.right + k), negative
+            );
+
+            const __m256d done = _mm256_cmp_pd(
+                _mm256_andnot_pd(sign_bit, e), tolerance, _CMP_LE_OQ
+            );
+
+            _mm256_storeu_pd(previous + k, m);
+            _mm256_storeu_pd(lanes.left + k, left);
+            _mm256_storeu_pd(lanes.right + k, right);
+            _mm256_storeu_pd(
+                lanes.midpoint + k,
+                _mm256_mul_pd(half, _mm256_add_pd(left, right))
+            );
+
+            small |= static_cast<unsigned int>(_mm256_movemask_pd(done)) << k;
+        }
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+        /*  Four NEON registers of 2 lanes each.                              */
+        const float64x2_t half = vdupq_n_f64(0.5);
+        const float64x2_t tolerance = vdupq_n_f64(epsilon);
+        std::size_t k;
+
+        for (k = 0; k < batch_lanes; k += 2)
+        {
+            const float64x2_t e = vld1q_f64(eval + k);
+            const float64x2_t m = vld1q_f64(lanes.midpoint + k);
+
+            /*  Lanes with f(midpoint) < 0. NaN compares false.               */
+            const uint64x2_t negative = vcltq_f64(e, vdupq_n_f64(0.0));
+
+            const float64x2_t left = vbslq_f64(
+                negative, m, vld1q_f64(lanes.left + k)
+            );
+
+            const float64x2_t right = vbslq_f64(
+                negative, vld1q_f64(lanes.right + k), m
+            );
+
+            const uint64x2_t done = vcleq_f64(vabsq_f64(e), tolerance);
+
+            vst1q_f64(previous + k, m);
+            vst1q_f64(lanes.left + k, left);
+            vst1q_f64(lanes.right + k, right);
+            vst1q_f64(lanes.midpoint + k,
+                      vmulq_f64(half, vaddq_f64(left, right)));
+
+            small |= static_cast<unsigned int>(vgetq_lane_u64(done, 0) & 1U)
+                  << k;
+            small |= static_cast<unsigned int>(vgetq_lane_u64(done, 1) & 1U)
+                  << (k + 1);
+        }
+
+#else
+
+        /*  No vector instructions. Use the scalar loop below.                */
+        static_cast<void>(epsilon);
+        small = update_lanes<double>(eval, lanes, previous);
+
+#endif
+
+        return small;
+    }
+    /*  End of update_lanes.                                                  */
+
+    /*  The same steps, one lane at a time, for any type of real number. The  *
+     *  ternary operators typically compile to conditional moves.             */
+    template <typename Other>
+    static unsigned int update_lanes(const Other * const eval,
+                                     Lanes<Other> &lanes,
+                                     Other * const previous)
+    {
+        /*  The maximum allowed error, the precision of Other.                */
+        const Other epsilon = std::numeric_limits<Other>::epsilon();
+        const Other half = static_cast<Other>(0.5);
+
+        /*  Bit-mask of the converged lanes, and the lane index.              */
+        unsigned int small = 0U;
+        std::size_t k;
+
+        for (k = 0; k < batch_lanes; ++k)
+        {
+            const bool negative = eval[k] < 0;
+            const Other m = lanes.midpoint[k];
+
+            previous[k] = m;
+            lanes.left[k] = (negative ? m : lanes.left[k]);
+            lanes.right[k] = (negative ? lanes.right[k] : m);
+            lanes.midpoint[k] = half * (lanes.left[k] + lanes.right[k]);
+
+            if (std::fabs(eval[k]) <= epsilon)
+                small |= 1U << k;
+        }
+
+        return small;
+    }
+    /*  End of update_lanes.                                                  */
+
+    /*  Adds a finished call to the statistics. Nothing is done, and the      *
+     *  compiler removes the call entirely, unless statistics are enabled.    *
+     *  Relaxed atomics are enough since the counters are only ever added to, *
+     *  and they are read once all of the work is done.                       */
+    static void record(unsigned int iterations,
+                       unsigned int evaluations,
+                       bool converged)
+    {
+#if defined(SOLVER_STATISTICS)
+
+        /*  A larger cap may be given in the Options. Such calls all go in    *
+         *  the last entry of the histogram.                                  */
+        if (iterations > maximum_number_of_iterations)
+            iterations = maximum_number_of_iterations;
+
+        statistics.histogram[iterations].fetch_add(
+            1UL, std::memory_order_relaxed
+        );
+
+        statistics.evaluations.fetch_add(
+            evaluations, std::memory_order_relaxed
+        );
+
+        if (!converged)
+            statistics.failures.fetch_add(1UL, std::memory_order_relaxed);
+#else
+        static_cast<void>(iterations);
+        static_cast<void>(evaluations);
+        static_cast<void>(converged);
+#endif
+    }
+    /*  End of record.                                                        */
+
+    /*  Passes one iteration to the tracer. As with record, nothing is done,  *
+     *  and the compiler removes the call entirely, unless tracing is         *
+     *  enabled.                                                              */
+    static void trace(unsigned int iteration, Real x, Real residual)
+    {
+#if defined(SOLVER_TRACING)
+        SolverTrace::step("Bisection::root", iteration,
+                          static_cast<double>(x),
+                          static_cast<double>(residual));
+#else
+        static_cast<void>(iteration);
+        static_cast<void>(x);
+        static_cast<void>(residual);
+#endif
+    }
+    /*  End of trace.                                                         */
+
+    /*  We want the function visible outside the class. Declare it public.    */
+    public:
+
+        /*  Function pointer notation is a little confusing. Create a typedef *
+         *  for a pointer to a function of one Real.                          */
+        typedef Real (*pointer)(Real);
+
+        /*  Everything we know about a finished call to detailed_root.        *
+         *  iterations is the number of bisection steps, and evaluations the  *
+         *  number of times f was called, including the two endpoints.        *
+         *  converged is false if the bracket was bad, or if we ran out of    *
+         *  iterations before we were within the tolerance. residual is f at  *
+         *  the last point where f was evaluated. With absolute stopping, if  *
+         *  we converged, this is the root that is returned.                  */
+        struct Result {
+            Real root;
+            unsigned int iterations;
+            unsigned int evaluations;
+            bool converged;
+            Real residual;
+        };
+
+#if defined(SOLVER_STATISTICS)
+
+        /*  Counters for every call to root and detailed_root. histogram[n]   *
+         *  is the number of calls that took n iterations, and failures the   *
+         *  number of calls that did not converge. The last entry also counts *
+         *  calls that took more, if a larger cap was given in the Options.   *
+         *  The total number of calls is the sum of the histogram. The        *
+         *  batched and constexpr routines are not counted.                   */
+        struct Statistics {
+            std::atomic<unsigned long int> evaluations;
+            std::atomic<unsigned long int> failures;
+            std::atomic<unsigned long int>
+                histogram[maximum_number_of_iterations + 1U];
+        };
+
+        /*  The counters themselves, shared by all threads.                   */
+        static Statistics statistics;
+
+        /*  Prints the counters to the screen.                                */
+        static void print_statistics(void)
+        {
+            unsigned long int calls = 0UL;
+            unsigned int n;
+
+            for (n = 0U; n <= maximum_number_of_iterations; ++n)
+                calls += statistics.histogram[n].load();
+
+            std::printf("Bisection::root calls: %lu, evaluations: %lu, "
+                        "failures: %lu\n",
+                        calls, statistics.evaluations.load(),
+                        statistics.failures.load());
+
+            for (n = 0U; n <= maximum_number_of_iterations; ++n)
+                if (statistics.histogram[n].load() != 0UL)
+                    std::printf("    %2u iterations: %lu\n",
+                                n, statistics.histogram[n].load());
+        }
+        /*  End of print_statistics.                                          */
+
+#endif
+
+        /*  When to stop iterating. Absolute stops once |f(x)| is at most the *
+         *  tolerance. Relative stops once the bracket is at most tolerance * *
+         *  |x| wide, meaning x is known to about that relative accuracy, no  *
+         *  matter how f is scaled.                                           */
+        enum Stopping {
+            Absolute,
+            Relative
+        };
+
+        /*  Settings for the bisection method. Each bisection step gains one  *
+         *  bit, so a caller that needs 8 digits instead of 16 saves about    *
+         *  half of the evaluations of f.                                     */
+        struct Options {
+            Real tolerance;
+            unsigned int maximum_number_of_iterations;
+            Stopping stopping;
+        };
+
+        /*  The settings used by root when no Options are given. This is the  *
+         *  precision of Real, compared against |f(x)|, and the usual cap on  *
+         *  the number of iterations. These are constants, so the compiler    *
+         *  folds them into the loop, and the default path costs exactly what *
+         *  it did before there were options.                                 */
+        static constexpr Options default_options(void)
+        {
+            return Options{
+                std::numeric_limits<Real>::epsilon(),
+                maximum_number_of_iterations,
+                Absolute
+            };
+        }
+        /*  End of default_options.                                           */
+
+        /*  Computes the root of a function using the bisection method. Every *
+         *  evaluation of f goes through the function pointer, which is an    *
+         *  indirect call that the compiler can not inline. It is kept for    *
+         *  existing callers, and simply uses the template below.             */
+        static Real root(pointer f, Real a, Real b)
+        {
+            return root<pointer>(f, a, b);
+        }
+        /*  End of root.                                                      */
+
+        /*  Computes the root of a function using the bisection method. The   *
+         *  function may be any callable object: a function pointer, a        *
+         *  lambda, or a class with an operator(). The compiler creates a     *
+         *  copy of this routine for each type, so for lambdas and functors   *
+         *  the body of f is inlined directly into the loop below.            */
+        template <typename Function>
+        static Real root(Function f, Real a, Real b)
+        {
+            return detailed_root(f, a, b).root;
+        }
+        /*  End of root.                                                      */
+
+        /*  Same as above, with a choice of tolerance and iteration cap.      */
+        template <typename Function>
+        static Real
+        root(Function f, Real a, Real b, const Options &options)
+        {
+            return detailed_root(f, a, b, options).root;
+        }
+        /*  End of root.                                                      */
+
+        /*  Computes the root and reports how the computation went. The root  *
+         *  functions above simply return the root from this. The extra       *
+         *  fields cost nothing there, since the compiler sees that they are  *
+         *  unused and removes them.                                          */
+        static Result detailed_root(pointer f, Real a, Real b)
+        {
+            return detailed_root<pointer>(f, a, b);
+        }
+        /*  End of detailed_root.                                             */
+
+        /*  The same, for any callable object.                                */
+        template <typename Function>
+        static Result detailed_root(Function f, Real a, Real b)
+        {
+            return detailed_root(f, a, b, default_options());
+        }
+        /*  End of detailed_root.                                             */
+
+        /*  Same as above, with a choice of tolerance and iteration cap.      */
+        template <typename Function, bool Traced = false>
+        static Result
+        detailed_root(Function f, Real a, Real b, const Options &options)
+        {
+#if defined(SOLVER_TRACING)
+
+            /*  While tracing, the call goes to a copy of this routine with   *
+             *  Traced = true, which has the hooks, out of line, as in        *
+             *  Heron's method. The copy used while tracing is off has no     *
+             *  hooks in its loop at all, and is inlined as before.           */
+            if (!Traced && SolverTrace::mode() != SolverTrace::Off)
+                return traced_root(f, a, b, options);
+#endif
+
+            /*  Variable for keeping track of the number of iterations.       */
+            unsigned int iters;
+
+            /*  The midpoint for the bisection. This updates as we iterate.   */
+            Real midpoint;
+
+            /*  Factor for the midpoint, in the precision of Real.            */
+            const Real half = static_cast<Real>(0.5);
+
+            /*  The last value of f that was computed, and the result.        */
+            Real eval;
+            Result result;
+
+            /*  We do not require a < b, nor f(a) < f(b). We need one of      *
+             *  these to evaluate negative under f and one to evaluate to     *
+             *  positive. Call the negative entry left and positive one right.*/
+            Real left, right;
+
+            /*  Evaluate f at the endpoints to determine which is positive    *
+             *  and which is negative, transforming [a, b] to [left, right].  */
+            const Real a_eval = f(a);
+            const Real b_eval = f(b);
+
+            /*  No matter what happens, f was called for both endpoints.      */
+            result.iterations = 0U;
+            result.evaluations = 2U;
+            result.converged = true;
+            result.residual = 0.0;
+
+            /*  Rare case, f(a) = 0. Return a, no bisection needed.           */
+            if (a_eval == 0.0)
+            {
+                result.root = a;
+                record(result.iterations, result.evaluations, result.converged);
+                return result;
+            }
+
+            /*  Similarly, if f(b) = 0, then we found the root. Return b.     */
+            if (b_eval == 0.0)
+            {
+                result.root = b;
+                record(result.iterations, result.evaluations, result.converged);
+                return result;
+            }
+
+            /*  Compare the two evaluations and set the left and right values.*/
+            if (a_eval < b_eval)
+            {
+                /*  If both evaluations are negative, or if both are positive,*
+                 *  then the bisection method will not work. Return NaN.      */
+                if (b_eval < 0.0 || a_eval > 0.0)
+                {
+                    result.root = result.residual = (a - a) / (a - a);
+                    result.converged = false;
+                    record(
+                        result.iterations, result.evaluations, result.converged
+                    );
+                    return result;
+                }
+
+                /*  Otherwise, since f(a) < f(b), set left = a and right = b. */
+                left = a;
+                right = b;
+            }
+
+            /*  In this case the function starts positive and goes negative.  */
+            else
+            {
+                /*  Same sanity check as before. We need one evaluation to be *
+                 *  negative and one to be positive. Abort if the signs agree.*/
+                if (a_eval < 0.0 || b_eval > 0.0)
+                {
+                    result.root = result.residual = (a - a) / (a - a);
+                    result.converged = false;
+                    record(
+                        result.iterations, result.evaluations, result.converged
+                    );
+                    return result;
+                }
+
+                /*  Since f(a) > f(b), set left = b and right = a.            */
+                left = b;
+                right = a;
+            }
+
+            /*  Start the bisection method. Compute the midpoint of a and b.  */
+            midpoint = half * (a + b);
+
+            /*  Until the loop evaluates f, f(b) was the last evaluation.     */
+            eval = b_eval;
+
+            /*  Iteratively divide the range in half to find the root.        */
+            for (iters = 0; iters < options.maximum_number_of_iterations;
+                 ++iters)
+            {
+                /*  With relative stopping, check the width of the bracket.   *
+                 *  This needs no evaluation of f.                            */
+                if (options.stopping == Relative)
+                    if (std::fabs(right - left) <=
+                        options.tolerance * std::fabs(midpoint))
+                        break;
+
+                /*  If f(x) is very small, we are close to a root and can     *
+                 *  break out of this for loop. Check for this.               */
+                eval = f(midpoint);
+                ++result.evaluations;
+
+                if (Traced)
+                    trace(iters, midpoint, eval);
+
+                if (options.stopping == Absolute)
+                    if (std::fabs(eval) <= options.tolerance)
+                        break;
+
+                /*  Apply bisection to get a better approximation. We have    *
+                 *  f(left) < 0 < f(right). If f(midpoint) < 0, replace the   *
+                 *  interval [left, right] with [midpoint, right]. Set left   *
+                 *  to the midpoint and set midpoint to be closer to right.   */
+                if (eval < 0.0)
+                {
+                    left = midpoint;
+                    midpoint = half * (midpoint + right);
+                }
+
+                /*  If f(midpoint) > 0, then replace right with the midpoint, *
+                 *  changing [left, right] into [left, midpoint]. We then set *
+                 *  the midpoint to be closer to left.                        */
+                else
+                {
+                    right = midpoint;
+                    midpoint = half * (left + midpoint);
+                }
+            }
+
+            /*  After n iterations, we are at most |b - a| / 2^n from the     *
+             *  root of the function. 1 / 2^n goes to zero very quickly,      *
+             *  meaning the convergence is very quick.                        */
+            result.root = midpoint;
+            result.iterations = iters;
+            result.converged = (iters < options.maximum_number_of_iterations);
+            result.residual = eval;
+            record(result.iterations, result.evaluations, result.converged);
+            return result;
+        }
+        /*  End of detailed_root.                                             */
+
+#if defined(SOLVER_TRACING)
+
+    private:
+
+        /*  A traced call. This is out of line, so that the code for tracing  *
+         *  does not take up room where the routine is inlined. The options   *
+         *  are passed by value, see herons_method.hpp.                       */
+        template <typename Function>
+        MITX_TRACE_NOINLINE static Result
+        traced_root(Function f, Real a, Real b, Options options)
+        {
+            const SolverTrace::Scope scope("Bisection::root");
+            return detailed_root<Function, true>(f, a, b, options);
+        }
+        /*  End of traced_root.                                               */
+
+    public:
+#endif
+
+        /*  Roots of a function that changes a little from one call to the    *
+         *  next, such as f(x; t) as t advances in steps of about the same    *
+         *  size. A Tracker is given a bracket [a, b] that holds the root for *
+         *  every t, and remembers the last two roots, r_1 and r_2. Each call *
+         *  first tries a narrow bracket around 2 r_1 - r_2, the root         *
+         *  predicted by the line through them, twice as wide on either side  *
+         *  as the error of the prediction in the last call. If f has the     *
+         *  same sign at both ends, the bracket is made 16 times wider, until *
+         *  the signs differ or it is as wide as [a, b].                      *
+         *                                                                    *
+         *  Each bisection step gains one bit, so narrowing the bracket saves *
+         *  one step for every halving of its width. If the root moves by     *
+         *  about d per call, the prediction is off by about d^2, and for d = *
+         *  10^-6 a root in [0, 1] that took about 50 steps takes about 8,    *
+         *  and 13 evaluations of f. Checking the signs costs two evaluations *
+         *  of f, on top of the two the bisection method makes at the ends of *
+         *  the bracket. Unlike Steffensen's method, the bisection method     *
+         *  gains the same single bit per step however good the start is, so  *
+         *  it can not get down to one or two steps.                          *
+         *                                                                    *
+         *  The first call uses [a, b], and so does any call after one that   *
+         *  did not converge. The second call uses the narrowest bracket      *
+         *  around the first root, since there is no line yet. A Tracker is   *
+         *  meant to be used by one thread.                                   */
+        class Tracker {
+
+            /*  The settings for every call, the largest bracket, and the     *
+             *  last two roots. width is the half-width of the next narrow    *
+             *  bracket, and history the number of roots from calls that      *
+             *  converged in a row, up to two.                                */
+            Options options;
+            Real low, high;
+            Real previous;
+            Real before;
+            Real width;
+            unsigned int history;
+
+            /*  We want the functions visible outside the class. Declare them *
+             *  public.                                                       */
+            public:
+
+                /*  Creates a tracker for roots in the bracket [a, b].        */
+                Tracker(Real a,
+                        Real b,
+                        const Options &settings = default_options())
+                    : options(settings),
+                      low(a < b ? a : b),
+                      high(a < b ? b : a),
+                      previous(a),
+                      before(a),
+                      width(0),
+                      history(0U)
+                {
+                    return;
+                }
+
+                /*  Computes the root of f, in a narrow bracket around the    *
+                 *  predicted root if possible, and reports how the           *
+                 *  computation went.                                         */
+                template <typename Function>
+                Result detailed_root(Function f)
+                {
+                    /*  The predicted root. Extrapolating may take it beyond  *
+                     *  [a, b], and a bracket around it would then be         *
+                     *  reversed, with f evaluated outside of [a, b].         */
+                    const Real predicted = (history < 2U ? previous :
+                                            2 * previous - before);
+
+                    /*  The center of the narrow bracket, the prediction      *
+                     *  moved into [a, b].                                    */
+                    const Real center = (predicted < low ? low :
+                                         (predicted > high ? high :
+                                          predicted));
+
+                    /*  The narrowest half-width tried, a few units in the    *
+                     *  last place of the root, so that a root that did not   *
+                     *  move is found in a few steps.                         */
+                    const Real smallest =
+                        64 * std::numeric_limits<Real>::epsilon() *
+                        (std::fabs(center) + 1);
+
+                    /*  Evaluations made while checking the signs.            */
+                    unsigned int extra = 0U;
+                    Real left = low;
+                    Real right = high;
+                    Real w = (width > smallest ? width : smallest);
+
+                    while (history != 0U)
+                    {
+                        left = (center - w > low ? center - w : low);
+                        right = (center + w < high ? center + w : high);
+
+                        /*  As wide as [a, b], which needs no check.          */
+                        if (left == low && right == high)
+                            break;
+
+                        const Real f_left = f(left);
+                        const Real f_right = f(right);
+                        extra += 2U;
+
+                        if ((f_left <= 0 && f_right >= 0) ||
+                            (f_left >= 0 && f_right <= 0))
+                            break;
+
+                        w *= 16;
+                    }
+
+                    Result result =
+                        BasicBisection::detailed_root(f, left, right, options);
+
+                    result.evaluations += extra;
+
+                    /*  The next bracket is sized by the error of this        *
+                     *  prediction. A cold start predicts nothing, and the    *
+                     *  next call starts from the smallest width.             */
+                    if (result.converged)
+                    {
+                        const Real error = result.root - center;
+                        width = (history != 0U ? 2 * std::fabs(error) : 0);
+                        before = previous;
+                        previous = result.root;
+                        history = (history < 2U ? history + 1U : 2U);
+                    }
+                    else
+                        history = 0U;
+
+                    return result;
+                }
+                /*  End of detailed_root.                                     */
+
+                /*  Same as above, returning only the root.                   */
+                template <typename Function>
+                Real root(Function f)
+                {
+                    return detailed_root(f).root;
+                }
+                /*  End of root.                                              */
+
+                /*  Forgets the last roots, so the next call uses [a, b].     */
+                void reset(void)
+                {
+                    history = 0U;
+                }
+                /*  End of reset.                                             */
+        };
+        /*  End of Tracker definition.                                        */
+
+        /*  Computes the root of a function at compile time. The function is  *
+         *  passed as any callable object, for example a lambda, and must     *
+         *  itself be constexpr. When called with constant arguments the root *
+         *  is computed by the compiler and folded into the program. The      *
+         *  steps are identical to the root function above, so the two return *
+         *  the same value. The only change is how NaN is made for a bad      *
+         *  interval. Dividing by zero is not allowed in a constant           *
+         *  expression, so we use std::numeric_limits instead.                */
+        template <typename Function>
+        static constexpr Real constexpr_root(Function f, Real a, Real b)
+        {
+            /*  The maximum allowed error, and the factor for the midpoint.   */
+            const Real epsilon = std::numeric_limits<Real>::epsilon();
+            const Real half = static_cast<Real>(0.5);
+
+            /*  Evaluate f at the endpoints, as before.                       */
+            const Real a_eval = f(a);
+            const Real b_eval = f(b);
+
+            /*  Variable for keeping track of the number of iterations.       */
+            unsigned int iters = 0U;
+
+            /*  The midpoint and the interval [left, right], as before.       */
+            Real midpoint = 0.0;
+            Real left = a;
+            Real right = b;
+
+            /*  Rare cases, f(a) = 0 or f(b) = 0. No bisection needed.        */
+            if (a_eval == 0.0)
+                return a;
+
+            if (b_eval == 0.0)
+                return b;
+
+            /*  Same sign at both ends, the bisection method will not work.   */
+            if ((a_eval < 0.0) == (b_eval < 0.0))
+                return std::numeric_limits<Real>::quiet_NaN();
+
+            /*  Ensure f(left) < 0 < f(right).                                */
+            if (a_eval > b_eval)
+            {
+                left = b;
+                right = a;
+            }
+
+            /*  Start the bisection method. Compute the midpoint of a and b.  */
+            midpoint = half * (a + b);
+
+            for (iters = 0U; iters < maximum_number_of_iterations; ++iters)
+            {
+                const Real eval = f(midpoint);
+
+                if (absolute_value(eval) <= epsilon)
+                    break;
+
+                if (eval < 0.0)
+                {
+                    left = midpoint;
+                    midpoint = half * (midpoint + right);
+                }
+
+                else
+                {
+                    right = midpoint;
+                    midpoint = half * (left + midpoint);
+                }
+            }
+
+            return midpoint;
+        }
+        /*  End of constexpr_root.                                            */
+
+        /*  Computes out[k] = root(f, a[k], b[k]) for 0 <= k < n. The results *
+         *  are identical to calling root on each bracket, including NaN for  *
+         *  brackets where f(a) and f(b) have the same sign.                  *
+         *                                                                    *
+         *  The scalar loop decides left or right with an if-statement. For   *
+         *  thousands of brackets this branch is unpredictable. Here, several *
+         *  brackets are bisected at once, and the update is done without     *
+         *  branches using vector instructions if the compiler is targeting   *
+         *  AVX, AVX-512, or 64-bit ARM NEON. Each lane tracks its own        *
+         *  convergence with a bit-mask.                                      *
+         *                                                                    *
+         *  When a lane converges it is immediately given the next bracket,   *
+         *  so converged lanes do no extra work. Only at the very end, when   *
+         *  fewer than batch_lanes brackets remain, do idle lanes sit in the  *
+         *  vector, and their results are ignored.                            */
+        template <typename Function>
+        static void root(Function f,
+                         const Real * const a,
+                         const Real * const b,
+                         Real * const out,
+                         std::size_t n)
+        {
+            /*  The state of the lanes, f(midpoint) for each lane, and the    *
+             *  midpoint before the last update. The old midpoint is the      *
+             *  answer for lanes where |f(midpoint)| <= epsilon.              */
+            BatchLanes lanes;
+            Real eval[batch_lanes];
+            Real previous[batch_lanes];
+
+            /*  Bit-mask of the lanes that are working on a bracket, and of   *
+             *  the lanes that converged on the latest pass.                  */
+            unsigned int active = 0U;
+            unsigned int small;
+
+            /*  Index of the next bracket to hand out, the lane index, the    *
+             *  number of passes over the lanes so far, and the smallest      *
+             *  deadline among the active lanes.                              */
+            std::size_t next = 0;
+            std::size_t k;
+            std::size_t pass = 0;
+            std::size_t earliest_deadline = 0;
+
+            /*  Give every lane its first bracket. Idle lanes still run       *
+             *  through the vector update. Give them harmless values so that  *
+             *  f is always evaluated at a finite point.                      */
+            for (k = 0; k < batch_lanes; ++k)
+            {
+                if (start_lane(f, a, b, out, n, next, pass, lanes, k))
+                    active |= 1U << k;
+
+                else
+                {
+                    lanes.left[k] = lanes.right[k] = lanes.midpoint[k] = 0.0;
+                    lanes.deadline[k] = lanes.slot[k] = 0;
+                }
+            }
+
+            earliest_deadline = maximum_number_of_iterations;
+
+            while (active != 0U)
+            {
+                /*  Evaluate f at every midpoint. f is only known to be a     *
+                 *  function of one Real, so this is done lane by lane.       */
+                for (k = 0; k < batch_lanes; ++k)
+                    eval[k] = f(lanes.midpoint[k]);
+
+                /*  The branchless update for all lanes at once. Idle lanes   *
+                 *  are removed from the convergence mask.                    */
+                small = update_lanes(eval, lanes, previous) & active;
+                ++pass;
+
+                /*  Most of the time no lane is done, and we can skip the     *
+                 *  scalar bookkeeping below entirely.                        */
+                if (small == 0U && pass != earliest_deadline)
+                    continue;
+
+                /*  Write out the finished lanes and refill them. A lane is   *
+                 *  finished by the same stopping rule as the scalar loop:    *
+                 *  either |f(midpoint)| <= epsilon, in which case the old    *
+                 *  midpoint is the answer, or the lane has done              *
+                 *  maximum_number_of_iterations updates.                     */
+                for (k = 0; k < batch_lanes; ++k)
+                {
+                    const bool converged = ((small >> k) & 1U) != 0U;
+                    const bool working = ((active >> k) & 1U) != 0U;
+
+                    if (!working || !(converged || lanes.deadline[k] == pass))
+                        continue;
+
+                    if (converged)
+                        out[lanes.slot[k]] = previous[k];
+                    else
+                        out[lanes.slot[k]] = lanes.midpoint[k];
+
+                    /*  Reuse the lane for the next bracket, if any.          */
+                    if (!start_lane(f, a, b, out, n, next, pass, lanes, k))
+                        active &= ~(1U << k);
+                }
+
+                /*  Find the next time a lane will run out of iterations.     */
+                earliest_deadline = pass + maximum_number_of_iterations;
+
+                for (k = 0; k < batch_lanes; ++k)
+                    if (((active >> k) & 1U) != 0U)
+                        if (lanes.deadline[k] < earliest_deadline)
+                            earliest_deadline = lanes.deadline[k];
+            }
+        }
+        /*  End of root.                                                      */
+
+        /*  Batched root finder for function pointers. This allows overloaded *
+         *  functions like std::sin to be passed, just like the scalar root   *
+         *  function. Uses the template above.                                */
+        static void root(pointer f,
+                         const Real * const a,
+                         const Real * const b,
+                         Real * const out,
+                         std::size_t n)
+        {
+            root<pointer>(f, a, b, out, n);
+        }
+        /*  End of root.                                                      */
+};
+/*  End of BasicBisection definition.                                         */
+
+/*  Most code wants double. Bisection::root(f, a, b) is shorter than writing  *
+ *  BasicBisection<double>::root(f, a, b) every time.                         */
+typedef BasicBisection<double> Bisection;
+
+/*  The counters are static members of the class, and need a definition.      *
+ *  Static storage starts out zero, so they all begin at zero.                */
+#if defined(SOLVER_STATISTICS)
+template <typename Real>
+typename BasicBisection<Real>::Statistics BasicBisection<Real>::statistics;
+#endif
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,298 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Caches the results of the bisection method and Heron's method.        *
+ *  Notes:                                                                    *
+ *      The cache is in result_cache.hpp. This file shows how to use it,      *
+ *      times it for inputs that repeat and for inputs that never do, and     *
+ *      checks that it returns the right results while several threads use it *
+ *      at once.                                                              *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/09/13                                                        *
+ ******************************************************************************/
+
+/*  stdio provides the "printf" function, used for printing text.             */
+#include <cstdio>
+
+/*  Floating-point sine function, sin, provided here.                         */
+#include <cmath>
+
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  std::uint64_t, used by the random number generator, is found here.        */
+#include <cstdint>
+
+/*  Timing routines, used for benchmarking.                                   */
+#include <chrono>
+
+/*  std::thread, used to share the cache between threads.                     */
+#include <thread>
+
+/*  std::vector, used for the inputs and the threads.                         */
+#include <vector>
+
+/*  The cache, in BasicResultCache, ResultCache, and BracketCache.            */
+#include "result_cache.hpp"
+
+/*  The solvers whose results are cached.                                     */
+#include "../bisection_method/bisection_method.hpp"
+#include "../../real_numbers/herons_method/herons_method.hpp"
+
+/*  Function pointer notation is a little confusing. Create a typedef for it  *
+ *  so we do not need to explicitly use it later.                             */
+typedef double (*function)(double);
+
+/*  pi is a root of sin(x), and the only one in [3, 4]. std::sin is not used  *
+ *  directly, since the address of a function of the standard library may not *
+ *  be taken.                                                                 */
+static double func(double x)
+{
+    return std::sin(x);
+}
+/*  End of func.                                                              */
+
+/*  Bisection::root, with the results kept in a cache. The key is the         *
+ *  function and the bracket.                                                 */
+static double cached_root(BracketCache &cache, function f, double a, double b)
+{
+    const double inputs[2] = {a, b};
+
+    return cache.get(BracketCache::identity(f), inputs, [=](void) {
+        return Bisection::root(f, a, b);
+    });
+}
+/*  End of cached_root.                                                       */
+
+/*  Heron::sqrt, with the results kept in a cache. Heron::sqrt is a function  *
+ *  of x alone, so the key may be any fixed number. The stateless lambda      *
+ *  gives one that is unique to this routine.                                 */
+static double cached_sqrt(ResultCache &cache, double x)
+{
+    const auto solve = [](double t) { return Heron::sqrt(t); };
+    const double inputs[1] = {x};
+
+    return cache.get(ResultCache::identity(solve), inputs, [=](void) {
+        return solve(x);
+    });
+}
+/*  End of cached_sqrt.                                                       */
+
+/*  A linear congruential generator, returning numbers in [0, 1).             */
+static double random_real(std::uint64_t &state)
+{
+    state = state * 6364136223846793005U + 1442695040888963407U;
+    return static_cast<double>(state >> 11) * 1.1102230246251565E-16;
+}
+/*  End of random_real.                                                       */
+
+/*  Returns n inputs in [1, 2], each one picked at random from a list of      *
+ *  distinct values. If the list is much longer than n, almost every input is *
+ *  different.                                                                */
+static std::vector<double> make_inputs(std::size_t n, std::size_t distinct)
+{
+    std::vector<double> values(distinct);
+    std::vector<double> inputs(n);
+    std::uint64_t state = 1U;
+    std::size_t k;
+
+    for (k = 0; k < distinct; ++k)
+        values[k] = 1.0 + random_real(state);
+
+    for (k = 0; k < n; ++k)
+        inputs[k] = values[static_cast<std::size_t>(random_real(state) *
+                                                    distinct)];
+
+    return inputs;
+}
+/*  End of make_inputs.                                                       */
+
+/*  Times one pass of solve over the inputs, and returns the time per input   *
+ *  in nanoseconds. The sum of the results is added to checksum, so the work  *
+ *  can not be skipped.                                                       */
+template <typename Solve>
+static double time_pass(const std::vector<double> &inputs,
+                        Solve solve,
+                        double &checksum)
+{
+    double sum = 0.0;
+    std::size_t k;
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for (k = 0; k < inputs.size(); ++k)
+        sum += solve(inputs[k]);
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    checksum += sum;
+
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(end - start).count();
+
+    return nanoseconds / static_cast<double>(inputs.size());
+}
+/*  End of time_pass.                                                         */
+
+/*  Compares a solver with and without a cache. The cache is created fresh    *
+ *  for every run, and is large enough to hold 4096 results, so inputs drawn  *
+ *  from 256 values soon all hit, while distinct inputs always miss. The      *
+ *  difference between the uncached pass and the pass with distinct inputs is *
+ *  the cost of a miss: the lookup, and the insert that follows.              */
+template <typename Cache, typename Plain, typename Cached>
+static void compare(const char * const title,
+                    std::size_t n,
+                    Plain plain,
+                    Cached cached)
+{
+    const std::vector<double> repeated = make_inputs(n, 256U);
+    const std::vector<double> distinct = make_inputs(n, 64U * n);
+    double checksum = 0.0;
+
+    Cache repeated_cache(4096U);
+    Cache distinct_cache(4096U);
+
+    const double plain_time = time_pass(distinct, plain, checksum);
+
+    const double miss_time = time_pass(distinct, [&](double x) {
+        return cached(distinct_cache, x);
+    }, checksum);
+
+    const double hit_time = time_pass(repeated, [&](double x) {
+        return cached(repeated_cache, x);
+    }, checksum);
+
+    std::printf("%s (checksum %.3f):\n", title, checksum / n);
+    std::printf("    no cache:            %7.2f ns/call\n", plain_time);
+    std::printf("    distinct inputs:     %7.2f ns/call\n", miss_time);
+    std::printf("    256 repeated inputs: %7.2f ns/call\n", hit_time);
+    std::printf("    ");
+    distinct_cache.print_statistics("distinct inputs");
+    std::printf("    ");
+    repeated_cache.print_statistics("repeated inputs");
+}
+/*  End of compare.                                                           */
+
+/*  Several threads look up the same inputs in one small cache, so that they  *
+ *  keep replacing each other's results, and compare every result with the    *
+ *  uncached one. Returns the number of results that differ, which should be  *
+ *  zero.                                                                     */
+static unsigned long int check_threads(unsigned int number_of_threads)
+{
+    const std::vector<double> inputs = make_inputs(200000U, 1024U);
+    std::vector<std::thread> threads;
+    std::vector<unsigned long int> wrong(number_of_threads, 0UL);
+    ResultCache cache(256U);
+    unsigned long int total = 0UL;
+    unsigned int n;
+
+    for (n = 0U; n < number_of_threads; ++n)
+        threads.push_back(std::thread([&, n](void) {
+            std::size_t k;
+
+            for (k = 0; k < inputs.size(); ++k)
+            {
+                const double x = inputs[(k + 7919U * n) % inputs.size()];
+
+                if (cached_sqrt(cache, x) != Heron::sqrt(x))
+                    ++wrong[n];
+            }
+        }));
+
+    for (n = 0U; n < number_of_threads; ++n)
+    {
+        threads[n].join();
+        total += wrong[n];
+    }
+
+    std::printf("%u threads, ", number_of_threads);
+    cache.print_statistics("shared cache");
+    return total;
+}
+/*  End of check_threads.                                                     */
+
+/*  Main routine used for testing the cache.                                  */
+int main(void)
+{
+    BracketCache brackets(1024U);
+    ResultCache roots(1024U);
+
+    /*  The first call solves the problem, and the second finds it in the     *
+     *  cache. Both give exactly the same number.                             */
+    const double first = cached_root(brackets, func, 3.0, 4.0);
+    const double second = cached_root(brackets, func, 3.0, 4.0);
+
+    std::printf("pi = %.16f, then %.16f\n", first, second);
+    brackets.print_statistics("Bisection cache");
+
+    const double sqrt_2 = cached_sqrt(roots, 2.0);
+    const double sqrt_2_again = cached_sqrt(roots, 2.0);
+    const double sqrt_3 = cached_sqrt(roots, 3.0);
+
+    std::printf("sqrt(2) = %.16f, then %.16f\n", sqrt_2, sqrt_2_again);
+    std::printf("sqrt(3) = %.16f\n", sqrt_3);
+    roots.print_statistics("Heron cache");
+
+    /*  The timings. For the bisection method the inputs x are in [1, 2], and *
+     *  the bracket is [x + 1, 4], so every bracket holds pi.                 */
+    compare<ResultCache>(
+        "Heron::sqrt", 1000000U,
+        [](double x) { return Heron::sqrt(x); },
+        [](ResultCache &cache, double x) { return cached_sqrt(cache, x); }
+    );
+
+    compare<BracketCache>(
+        "Bisection::root", 100000U,
+        [](double x) { return Bisection::root(func, x + 1.0, 4.0); },
+        [](BracketCache &cache, double x) {
+            return cached_root(cache, func, x + 1.0, 4.0);
+        }
+    );
+
+    const unsigned long int wrong = check_threads(4U);
+    std::printf("wrong results: %lu\n", wrong);
+    return 0;
+}
+
+/*  We can execute this on GNU, Linux, FreeBSD, macOS, etc., via:             *
+ *      c++ -O2 -pthread memoized_root_finding.cpp -o main                    *
+ *      ./main                                                                *
+ *  This will output the following:                                           *
+ *      pi = 3.1415926535897931, then 3.1415926535897931                      *
+ *      Bisection cache: 1 hits, 1 misses (50.0% hits)                        *
+ *      sqrt(2) = 1.4142135623730949, then 1.4142135623730949                 *
+ *      sqrt(3) = 1.7320508075688772                                          *
+ *      Heron cache: 1 hits, 2 misses (33.3% hits)                            *
+ *  followed by the timings, which depend on the machine. On one machine a    *
+ *  hit took about 6 ns, against about 35 ns for Heron::sqrt and 1.3 us for   *
+ *  Bisection::root, and a miss added about 8 ns to the uncached call. The    *
+ *  counts of hits and misses may change a little from run to run, since the  *
+ *  address of the function is part of the key, and with it the slots that    *
+ *  keys share. The last line is always                                       *
+ *      wrong results: 0                                                      *
+ *                                                                            *
+ *  On Windows you will need to install a C++ compiler. Microsoft's MSVC is a *
+ *  common option. Using MSVC, type:                                          *
+ *      cl /std:c++17 /O2 memoized_root_finding.cpp /link /out:main.exe       *
+ *      main.exe                                                              *
+ *  This will produce the same output.                                        */
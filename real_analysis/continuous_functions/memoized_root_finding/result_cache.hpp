@@ -0,0 +1,486 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Header-only cache for the results of root finders and other solvers.  *
+ *  Notes:                                                                    *
+ *      Provides BasicResultCache<Real, Inputs>, and the ResultCache and      *
+ *      BracketCache typedefs. The cache is bounded, and safe to use from     *
+ *      many threads at once without locks: a lookup is a few loads and       *
+ *      compares, and an insert a few stores.                                 *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/09/13                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_RESULT_CACHE_HPP
+#define MITX_RESULT_CACHE_HPP
+
+/*  cstdio provides the "printf" function, used for printing text.            */
+#include <cstdio>
+
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  std::uint64_t and std::uintptr_t, used for the keys, are found here.      */
+#include <cstdint>
+
+/*  std::memcpy, used to safely copy the bits of a real number to an integer. */
+#include <cstring>
+
+/*  std::atomic, used for the slots and the counters.                         */
+#include <atomic>
+
+/*  std::unique_ptr, used for the array of slots.                             */
+#include <memory>
+
+/*  std::is_empty, used to check that a function has no state.                */
+#include <type_traits>
+
+/*  Remembers the results of a solver for recent inputs. A key is the         *
+ *  function being solved, and the exact bits of the Inputs real numbers it   *
+ *  was called with, a bracket [a, b] for the bisection method, or x for      *
+ *  Heron's method. Since the bits are compared, 0.0 and -0.0 are different   *
+ *  keys, and the cache never returns a result for inputs that only agree to  *
+ *  some tolerance.                                                           *
+ *                                                                            *
+ *  The table is split into buckets of two slots, and each key may only be    *
+ *  stored in the bucket its hash points to. A new result goes in the first   *
+ *  slot, and whatever was there moves to the second, so the two most recent  *
+ *  keys of a bucket are kept. The memory used is fixed when the cache is     *
+ *  created, and a lookup reads at most two slots next to each other.         *
+ *                                                                            *
+ *  Any number of threads may read and write the cache at once, without       *
+ *  locks. Every word of a slot is atomic, but a slot as a whole is not, and  *
+ *  two threads writing the same slot may leave it with the key of one and    *
+ *  the result of the other. Each slot therefore also stores its result XORed *
+ *  with the hash of its key. A reader checks that the key matches and that   *
+ *  the result XORed with the hash of that key gives the stored check. A torn *
+ *  slot fails this test unless the hashes of two different keys happen to    *
+ *  differ by exactly the XOR of two results, which has a chance of about     *
+ *  2^-64, and the lookup then counts as a miss. This is the lockless hashing *
+ *  used by chess programs for their transposition tables. Locked             *
+ *  instructions, such as a compare-and-swap, cost more than the whole lookup *
+ *  on many machines, and no thread ever waits for another.                   */
+template <typename Real, unsigned int Inputs>
+class BasicResultCache {
+
+    /*  The bits of Real are stored in a 64-bit word. long double has padding *
+     *  bits with unspecified contents on most platforms, so two equal        *
+     *  numbers could have different keys, and it is not allowed.             */
+    static_assert(sizeof(Real) <= sizeof(std::uint64_t),
+                  "BasicResultCache supports float and double");
+
+    static_assert(Inputs > 0U, "BasicResultCache needs at least one input");
+
+    /*  The words of a key: the function, followed by the inputs.             */
+    static const unsigned int key_words = Inputs + 1U;
+
+    /*  The hit and miss counters are split into shards, one for every        *
+     *  thread, so that a thread only ever adds to its own counters. A single *
+     *  pair of counters would be written by every lookup in every thread,    *
+     *  and the cache line holding it would move back and forth between the   *
+     *  cores. Since no other thread writes to its shard, a thread can add    *
+     *  one with a plain load and store, instead of a locked instruction.     *
+     *  Threads started after the first number_of_shards share the last       *
+     *  shard, and use fetch_add.                                             */
+    static const unsigned int number_of_shards = 64U;
+
+    /*  One entry of the table. With one input, a slot is four words, 32      *
+     *  bytes, and a bucket of two fills a single cache line. A slot whose    *
+     *  key is all zeros is empty, and no function has identity zero.         */
+    struct Slot {
+        std::atomic<std::uint64_t> key[key_words];
+        std::atomic<std::uint64_t> value;
+        std::atomic<std::uint64_t> check;
+    };
+
+    /*  Two slots sharing a hash. The bucket starts on a cache line, so       *
+     *  writing one bucket does not disturb readers of its neighbours.        */
+    struct alignas(64) Bucket {
+        Slot slot[2];
+    };
+
+    /*  The counters for one shard, on a cache line of their own.             */
+    struct alignas(64) Shard {
+        std::atomic<unsigned long int> hits;
+        std::atomic<unsigned long int> misses;
+    };
+
+    /*  The table, its number of buckets minus one, and the counters. The     *
+     *  number of buckets is a power of two, so the bucket for a hash is      *
+     *  found with a bitwise and. The extra shard is the shared one.          */
+    std::unique_ptr<Bucket[]> buckets;
+    std::size_t mask;
+    Shard shards[number_of_shards + 1U];
+
+    /*  The bits of a real number, as an integer. memcpy is the portable way  *
+     *  to do this, and compilers turn it into a single move.                 */
+    static std::uint64_t bits(Real x)
+    {
+        std::uint64_t word = 0U;
+        std::memcpy(&word, &x, sizeof(x));
+        return word;
+    }
+    /*  End of bits.                                                          */
+
+    /*  The real number with the given bits, the inverse of the above.        */
+    static Real from_bits(std::uint64_t word)
+    {
+        Real x;
+        std::memcpy(&x, &word, sizeof(x));
+        return x;
+    }
+    /*  End of from_bits.                                                     */
+
+    /*  Hashes a key. Each word is multiplied by a different odd constant,    *
+     *  and these products do not depend on each other, so they are computed  *
+     *  in parallel. The final step is the one from the splitmix64 random     *
+     *  number generator: it mixes the high bits, where the products are      *
+     *  good, into the low bits, which choose the bucket.                     */
+    static std::uint64_t hash(const std::uint64_t *key)
+    {
+        const std::uint64_t constants[3] = {
+            0x9E3779B97F4A7C15U, 0xC2B2AE3D27D4EB4FU, 0x165667B19E3779F9U
+        };
+
+        std::uint64_t h = 0U;
+        unsigned int k;
+
+        for (k = 0U; k < key_words; ++k)
+            h ^= key[k] * constants[k % 3U] + k;
+
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9U;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBU;
+        return h ^ (h >> 31);
+    }
+    /*  End of hash.                                                          */
+
+    /*  Builds the key for a function and its inputs.                         */
+    static void make_key(std::uint64_t function,
+                         const Real (&inputs)[Inputs],
+                         std::uint64_t *key)
+    {
+        unsigned int k;
+
+        key[0] = function;
+
+        for (k = 0U; k < Inputs; ++k)
+            key[k + 1U] = bits(inputs[k]);
+    }
+    /*  End of make_key.                                                      */
+
+    /*  Reads a slot. Returns true, and sets value, if the slot holds key and *
+     *  passes the check.                                                     */
+    static bool read(const Slot &slot,
+                     const std::uint64_t *key,
+                     std::uint64_t h,
+                     std::uint64_t &value)
+    {
+        bool match = true;
+        unsigned int k;
+
+        for (k = 0U; k < key_words; ++k)
+            match &= slot.key[k].load(std::memory_order_relaxed) == key[k];
+
+        value = slot.value.load(std::memory_order_relaxed);
+        match &= slot.check.load(std::memory_order_relaxed) == (value ^ h);
+        return match;
+    }
+    /*  End of read.                                                          */
+
+    /*  Writes a key, its value, and the check to a slot.                     */
+    static void write(Slot &slot,
+                      const std::uint64_t *key,
+                      std::uint64_t h,
+                      std::uint64_t value)
+    {
+        unsigned int k;
+
+        for (k = 0U; k < key_words; ++k)
+            slot.key[k].store(key[k], std::memory_order_relaxed);
+
+        slot.value.store(value, std::memory_order_relaxed);
+        slot.check.store(value ^ h, std::memory_order_relaxed);
+    }
+    /*  End of write.                                                         */
+
+    /*  The shard of the calling thread. Threads are handed the shards in     *
+     *  turn, the first time they use a cache of this type, and the thread    *
+     *  keeps that shard in every cache of the type. The thread_local         *
+     *  variable starts out as a constant, so reading it costs no more than   *
+     *  reading any other variable.                                           */
+    static unsigned int thread_shard(void)
+    {
+        static std::atomic<unsigned int> next(0U);
+        static thread_local unsigned int shard = number_of_shards + 1U;
+
+        if (shard > number_of_shards)
+        {
+            shard = next.fetch_add(1U, std::memory_order_relaxed);
+
+            if (shard > number_of_shards)
+                shard = number_of_shards;
+        }
+
+        return shard;
+    }
+    /*  End of thread_shard.                                                  */
+
+    /*  Adds one to a counter of the calling thread's shard.                  */
+    static void count(std::atomic<unsigned long int> &counter,
+                      unsigned int shard)
+    {
+        if (shard < number_of_shards)
+            counter.store(counter.load(std::memory_order_relaxed) + 1UL,
+                          std::memory_order_relaxed);
+        else
+            counter.fetch_add(1UL, std::memory_order_relaxed);
+    }
+    /*  End of count.                                                         */
+
+    /*  A stateless function is known by its type. Every type gets its own    *
+     *  tag, and the address of the tag is the identity.                      */
+    template <typename Function>
+    static constexpr char tag = 0;
+
+    /*  We want the functions visible outside the class. Declare them public. */
+    public:
+
+        /*  Function pointer notation is a little confusing. Create a typedef *
+         *  for it so we do not need to explicitly use it later.              */
+        typedef Real (*pointer)(Real);
+
+        /*  Creates a cache with room for at least capacity results. The      *
+         *  capacity is rounded up to an even power of two, at least 2, and   *
+         *  every result takes 32 bytes, or more for more than one input.     */
+        explicit BasicResultCache(std::size_t capacity) : mask(1U)
+        {
+            std::size_t k;
+            unsigned int n, way;
+
+            while (2U * mask < capacity)
+                mask <<= 1;
+
+            buckets.reset(new Bucket[mask]);
+
+            for (k = 0; k < mask; ++k)
+            {
+                for (way = 0U; way < 2U; ++way)
+                {
+                    Slot &slot = buckets[k].slot[way];
+
+                    for (n = 0U; n < key_words; ++n)
+                        slot.key[n].store(0U, std::memory_order_relaxed);
+
+                    slot.value.store(0U, std::memory_order_relaxed);
+                    slot.check.store(0U, std::memory_order_relaxed);
+                }
+            }
+
+            for (n = 0U; n <= number_of_shards; ++n)
+            {
+                shards[n].hits.store(0UL, std::memory_order_relaxed);
+                shards[n].misses.store(0UL, std::memory_order_relaxed);
+            }
+
+            mask = mask - 1U;
+        }
+
+        /*  The identity of a function given by a pointer, its address.       */
+        static std::uint64_t identity(pointer f)
+        {
+            return static_cast<std::uint64_t>(
+                reinterpret_cast<std::uintptr_t>(f)
+            );
+        }
+        /*  End of identity.                                                  */
+
+        /*  The identity of a lambda, or a class with an operator(). Only     *
+         *  functions without state are allowed. Two lambdas of the same type *
+         *  that capture different values would otherwise share their         *
+         *  results.                                                          */
+        template <typename Function>
+        static std::uint64_t identity(const Function &)
+        {
+            static_assert(std::is_empty<Function>::value,
+                          "functions with state can not be told apart");
+
+            return static_cast<std::uint64_t>(
+                reinterpret_cast<std::uintptr_t>(&tag<Function>)
+            );
+        }
+        /*  End of identity.                                                  */
+
+        /*  Looks up the result for a function and its inputs. Returns true   *
+         *  and sets result if it is in the cache. Counts a hit or a miss.    */
+        bool find(std::uint64_t function,
+                  const Real (&inputs)[Inputs],
+                  Real &result)
+        {
+            std::uint64_t key[key_words];
+            std::uint64_t value;
+
+            make_key(function, inputs, key);
+
+            const std::uint64_t h = hash(key);
+            const Bucket &bucket = buckets[h & mask];
+            const unsigned int shard = thread_shard();
+
+            if (read(bucket.slot[0], key, h, value) ||
+                read(bucket.slot[1], key, h, value))
+            {
+                count(shards[shard].hits, shard);
+                result = from_bits(value);
+                return true;
+            }
+
+            count(shards[shard].misses, shard);
+            return false;
+        }
+        /*  End of find.                                                      */
+
+        /*  Stores the result for a function and its inputs in the first slot *
+         *  of its bucket, and moves the previous contents to the second      *
+         *  slot. Nothing is moved if the first slot already holds this key,  *
+         *  which happens when two threads missed on the same key at about    *
+         *  the same time.                                                    */
+        void insert(std::uint64_t function,
+                    const Real (&inputs)[Inputs],
+                    Real result)
+        {
+            std::uint64_t key[key_words];
+            std::uint64_t moved[key_words];
+            unsigned int k;
+            bool same = true;
+
+            make_key(function, inputs, key);
+
+            const std::uint64_t h = hash(key);
+            Bucket &bucket = buckets[h & mask];
+            Slot &first = bucket.slot[0];
+
+            for (k = 0U; k < key_words; ++k)
+            {
+                moved[k] = first.key[k].load(std::memory_order_relaxed);
+                same &= moved[k] == key[k];
+            }
+
+            /*  The old check is copied along with the old key and value. If  *
+             *  the first slot was torn, the copy fails its check too.        */
+            if (!same)
+            {
+                Slot &second = bucket.slot[1];
+
+                for (k = 0U; k < key_words; ++k)
+                    second.key[k].store(moved[k], std::memory_order_relaxed);
+
+                second.value.store(first.value.load(std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+                second.check.store(first.check.load(std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+            }
+
+            write(first, key, h, bits(result));
+        }
+        /*  End of insert.                                                    */
+
+        /*  Returns the cached result for a function and its inputs. If it is *
+         *  not in the cache, solve() is called to compute it, and the result *
+         *  is stored. solve is usually a lambda that calls the solver, for   *
+         *  example                                                           *
+         *                                                                    *
+         *              [=](void) { return Bisection::root(f, a, b); }        *
+         *                                                                    *
+         *  The result is stored even if the solver did not converge: the     *
+         *  cache returns what the solver would have returned.                */
+        template <typename Solve>
+        Real get(std::uint64_t function,
+                 const Real (&inputs)[Inputs],
+                 Solve solve)
+        {
+            Real result;
+
+            if (find(function, inputs, result))
+                return result;
+
+            result = solve();
+            insert(function, inputs, result);
+            return result;
+        }
+        /*  End of get.                                                       */
+
+        /*  The number of lookups that found their result, summed over the    *
+         *  shards. Other threads may be adding to the counters while this    *
+         *  runs, so the sum is a snapshot.                                   */
+        unsigned long int hits(void) const
+        {
+            unsigned long int total = 0UL;
+            unsigned int n;
+
+            for (n = 0U; n <= number_of_shards; ++n)
+                total += shards[n].hits.load(std::memory_order_relaxed);
+
+            return total;
+        }
+        /*  End of hits.                                                      */
+
+        /*  The number of lookups that did not find their result.             */
+        unsigned long int misses(void) const
+        {
+            unsigned long int total = 0UL;
+            unsigned int n;
+
+            for (n = 0U; n <= number_of_shards; ++n)
+                total += shards[n].misses.load(std::memory_order_relaxed);
+
+            return total;
+        }
+        /*  End of misses.                                                    */
+
+        /*  The number of results the cache can hold.                         */
+        std::size_t capacity(void) const
+        {
+            return 2U * (mask + 1U);
+        }
+        /*  End of capacity.                                                  */
+
+        /*  Prints the counters to the screen.                                */
+        void print_statistics(const char * const name) const
+        {
+            const unsigned long int found = hits();
+            const unsigned long int missed = misses();
+            const unsigned long int total = found + missed;
+
+            std::printf("%s: %lu hits, %lu misses (%.1f%% hits)\n",
+                        name, found, missed,
+                        total == 0UL ? 0.0 : 100.0 * found / total);
+        }
+        /*  End of print_statistics.                                          */
+};
+/*  End of BasicResultCache definition.                                       */
+
+/*  Almost every root finder in this project takes a bracket [a, b], or one   *
+ *  starting point, so the most common caches are these.                      */
+typedef BasicResultCache<double, 1U> ResultCache;
+typedef BasicResultCache<double, 2U> BracketCache;
+
+#endif
+/*  End of include guard.                                                     */
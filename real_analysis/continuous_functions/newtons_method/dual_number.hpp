@@ -0,0 +1,260 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Forward-mode automatic differentiation with dual numbers.             *
+ *  Notes:                                                                    *
+ *      A dual number is x + x' e, where e is a formal symbol with e^2 = 0.   *
+ *      Evaluating f at x + e gives f(x) + f'(x) e, the value and the         *
+ *      derivative at once, with no hand-written derivative and no finite     *
+ *      differences. Nesting dual numbers gives the second derivative as      *
+ *      well.                                                                 *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/31                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_DUAL_NUMBER_HPP
+#define MITX_DUAL_NUMBER_HPP
+
+/*  sqrt, exp, log, sin, cos, and fabs for the parts are found here.          */
+#include <cmath>
+
+/*  std::enable_if and std::is_arithmetic, used by the constructors.          */
+#include <type_traits>
+
+/*  A dual number, x + x' e, with e^2 = 0. The rules of arithmetic for these  *
+ *  are the rules of differentiation. For example (a + a' e)(b + b' e) = ab + *
+ *  (a'b + ab') e, which is the product rule. Starting from the variable, x + *
+ *  1 e, every operation carries the derivative along with the value, so      *
+ *  evaluating the function at the variable returns f(x) + f'(x) e.           *
+ *                                                                            *
+ *  The class is a template over the type of the parts, Real. This may be     *
+ *  float, double, or long double. It may also be a dual number itself. The   *
+ *  parts of BasicDual<BasicDual<double>> are dual numbers, and evaluating f  *
+ *  at (x + e) + (1 + 0 e) e' gives the first derivative twice and the second *
+ *  derivative in the e e' part. Halley's method uses this.                   *
+ *                                                                            *
+ *  The functions to be differentiated should be written as templates, or as  *
+ *  lambdas with auto parameters, so that the same code works for Real and    *
+ *  for dual numbers. Call sqrt, cos, and so on unqualified, not as std::cos, *
+ *  so that the versions below are found.                                     */
+template <typename Real>
+class BasicDual {
+
+    /*  The value, and the derivative.                                        */
+    Real x, dx;
+
+    public:
+
+        /*  The default constructor gives zero.                               */
+        constexpr BasicDual(void) : x(0), dx(0)
+        {
+            /*  Nothing to do, the parts are set above.                       */
+        }
+
+        /*  Constructor from the value and the derivative. A constant has     *
+         *  derivative zero, so a Real may be used wherever a dual number is  *
+         *  expected.                                                         */
+        constexpr BasicDual(const Real &value,
+                            const Real &derivative = Real(0))
+            : x(value), dx(derivative)
+        {
+            /*  Similarly, nothing to do.                                     */
+        }
+
+        /*  Constructor from a plain number, like 2.0 or 3. This lets 2.0 -   *
+         *  x*x work for nested dual numbers too, where the double has to     *
+         *  become a dual number of dual numbers in one step.                 */
+        template <typename Scalar,
+                  typename = typename std::enable_if<
+                      std::is_arithmetic<Scalar>::value
+                  >::type>
+        constexpr BasicDual(Scalar value) : x(value), dx(0)
+        {
+            /*  Similarly, nothing to do.                                     */
+        }
+
+        /*  The independent variable at the point t, t + 1 e. Evaluating f    *
+         *  here gives f(t) + f'(t) e.                                        */
+        static constexpr BasicDual variable(const Real &t)
+        {
+            return BasicDual(t, Real(1));
+        }
+
+        /*  The value, and the derivative.                                    */
+        constexpr const Real &value(void) const
+        {
+            return x;
+        }
+
+        constexpr const Real &derivative(void) const
+        {
+            return dx;
+        }
+
+        /*  Arithmetic. The sum and difference rules.                         */
+        friend constexpr BasicDual
+        operator + (const BasicDual &a, const BasicDual &b)
+        {
+            return BasicDual(a.x + b.x, a.dx + b.dx);
+        }
+
+        friend constexpr BasicDual
+        operator - (const BasicDual &a, const BasicDual &b)
+        {
+            return BasicDual(a.x - b.x, a.dx - b.dx);
+        }
+
+        friend constexpr BasicDual operator - (const BasicDual &a)
+        {
+            return BasicDual(-a.x, -a.dx);
+        }
+
+        /*  The product rule, (ab)' = a'b + ab'.                              */
+        friend constexpr BasicDual
+        operator * (const BasicDual &a, const BasicDual &b)
+        {
+            return BasicDual(a.x * b.x, a.dx * b.x + a.x * b.dx);
+        }
+
+        /*  The quotient rule, (a/b)' = (a' - (a/b) b') / b. This divides     *
+         *  twice by b, instead of by b^2, which can not overflow when b does *
+         *  not.                                                              */
+        friend constexpr BasicDual
+        operator / (const BasicDual &a, const BasicDual &b)
+        {
+            const Real quotient = a.x / b.x;
+            return BasicDual(quotient, (a.dx - quotient * b.dx) / b.x);
+        }
+
+        /*  The same operations, in place.                                    */
+        constexpr BasicDual &operator += (const BasicDual &b)
+        {
+            return *this = *this + b;
+        }
+
+        constexpr BasicDual &operator -= (const BasicDual &b)
+        {
+            return *this = *this - b;
+        }
+
+        constexpr BasicDual &operator *= (const BasicDual &b)
+        {
+            return *this = *this * b;
+        }
+
+        constexpr BasicDual &operator /= (const BasicDual &b)
+        {
+            return *this = *this / b;
+        }
+
+        /*  Comparisons look at the values only. This lets functions with     *
+         *  branches, like if (x < 0), be differentiated one branch at a      *
+         *  time.                                                             */
+        friend constexpr bool
+        operator < (const BasicDual &a, const BasicDual &b)
+        {
+            return a.x < b.x;
+        }
+
+        friend constexpr bool
+        operator > (const BasicDual &a, const BasicDual &b)
+        {
+            return a.x > b.x;
+        }
+
+        friend constexpr bool
+        operator <= (const BasicDual &a, const BasicDual &b)
+        {
+            return a.x <= b.x;
+        }
+
+        friend constexpr bool
+        operator >= (const BasicDual &a, const BasicDual &b)
+        {
+            return a.x >= b.x;
+        }
+
+        friend constexpr bool
+        operator == (const BasicDual &a, const BasicDual &b)
+        {
+            return a.x == b.x;
+        }
+
+        friend constexpr bool
+        operator != (const BasicDual &a, const BasicDual &b)
+        {
+            return a.x != b.x;
+        }
+
+        /*  The chain rule, h(a)' = h'(a) a', for a few common functions. The *
+         *  using declarations pick std::sqrt and so on for a plain Real, and *
+         *  for nested dual numbers the unqualified calls find these same     *
+         *  functions.                                                        */
+        friend BasicDual sqrt(const BasicDual &a)
+        {
+            using std::sqrt;
+            const Real root = sqrt(a.x);
+            return BasicDual(root, a.dx / (Real(2) * root));
+        }
+
+        friend BasicDual exp(const BasicDual &a)
+        {
+            using std::exp;
+            const Real exp_a = exp(a.x);
+            return BasicDual(exp_a, exp_a * a.dx);
+        }
+
+        friend BasicDual log(const BasicDual &a)
+        {
+            using std::log;
+            return BasicDual(log(a.x), a.dx / a.x);
+        }
+
+        friend BasicDual sin(const BasicDual &a)
+        {
+            using std::sin;
+            using std::cos;
+            return BasicDual(sin(a.x), cos(a.x) * a.dx);
+        }
+
+        friend BasicDual cos(const BasicDual &a)
+        {
+            using std::sin;
+            using std::cos;
+            return BasicDual(cos(a.x), -sin(a.x) * a.dx);
+        }
+
+        /*  The absolute value is not differentiable at zero. We use the      *
+         *  derivative from the right there, like the comparisons above pick  *
+         *  a branch.                                                         */
+        friend constexpr BasicDual fabs(const BasicDual &a)
+        {
+            return (a.x < Real(0) ? -a : a);
+        }
+};
+/*  End of BasicDual definition.                                              */
+
+/*  Most code wants double. Dual is shorter than BasicDual<double>.           */
+typedef BasicDual<double> Dual;
+
+#endif
+/*  End of include guard.                                                     */
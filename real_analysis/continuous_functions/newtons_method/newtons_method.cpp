@@ -0,0 +1,239 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Calculates the root of a function using Newton's method and Halley's  *
+ *      method, with automatic differentiation.                               *
+ *  Notes:                                                                    *
+ *      The solvers are in newtons_method.hpp, and the dual numbers in        *
+ *      dual_number.hpp. This file shows how to use them, and compares them   *
+ *      with Steffensen's method.                                             *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/31                                                        *
+ ******************************************************************************/
+
+/*  cstdio provides the "printf" function, used for printing text.            */
+#include <cstdio>
+
+/*  cos, for the second example function, is found here.                      */
+#include <cmath>
+
+/*  Timing routines, used for benchmarking the three methods.                 */
+#include <chrono>
+
+/*  Newton's method and Halley's method, in Newton and Halley.                */
+#include "newtons_method.hpp"
+
+/*  Steffensen's method, for comparison.                                      */
+#include "../steffensens_method/steffensens_method.hpp"
+
+/*  sqrt(2) is a root to the function f(x) = 2 - x^2. This is written as a    *
+ *  template, so that it may be called with a double, and with the dual       *
+ *  numbers that Newton's method and Halley's method use. No derivative is    *
+ *  written anywhere.                                                         */
+template <typename Real>
+static Real func(Real x)
+{
+    return 2.0 - x*x;
+}
+/*  End of func.                                                              */
+
+/*  The root of cos(x) - x is the Dottie number, 0.739085... The call to cos  *
+ *  is unqualified, so that the dual number version is found for dual         *
+ *  numbers, and std::cos for double.                                         */
+template <typename Real>
+static Real dottie(Real x)
+{
+    using std::cos;
+    return cos(x) - x;
+}
+/*  End of dottie.                                                            */
+
+/*  Prints the iterations and evaluations of the three methods on f, starting *
+ *  at x. Steffensen's method evaluates f twice per step. The other two       *
+ *  evaluate it once per step, at a dual number.                              */
+template <typename Steffensen_Function,
+          typename Newton_Function,
+          typename Halley_Function>
+static void compare(const char * const name,
+                    Steffensen_Function f,
+                    Newton_Function g,
+                    Halley_Function h,
+                    double x)
+{
+    const Steffensen::Result s = Steffensen::detailed_root(f, x);
+    const Newton::Result n = Newton::detailed_root(g, x);
+    const Halley::Result a = Halley::detailed_root(h, x);
+
+    std::printf("%s from x = %.1f:\n", name, x);
+
+    std::printf("    Steffensen: %.16f, %2u iterations, %2u evaluations\n",
+                s.root, s.iterations, s.evaluations);
+
+    std::printf("    Newton:     %.16f, %2u iterations, %2u evaluations\n",
+                n.root, n.iterations, n.evaluations);
+
+    std::printf("    Halley:     %.16f, %2u iterations, %2u evaluations\n",
+                a.root, a.iterations, a.evaluations);
+}
+/*  End of compare.                                                           */
+
+/*  Finds the Dottie number many times using starting points near x = 0.5,    *
+ *  and prints the average time per root. Solver is one of Steffensen,        *
+ *  Newton, or Halley, and f the version of dottie it needs.                  */
+template <typename Solver, typename Function>
+static void benchmark(Function f, const char * const name)
+{
+    /*  The number of roots to compute.                                       */
+    const unsigned int number_of_calls = 200000U;
+
+    /*  Running sum to keep the compiler from discarding the work.            */
+    double sum = 0.0;
+
+    /*  Variable for looping over the calls.                                  */
+    unsigned int index;
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for (index = 0U; index < number_of_calls; ++index)
+        sum += Solver::root(f, 0.5 + 1.0E-6 * index);
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::printf("%-11s %7.2f ns/root (checksum %.6f)\n",
+                name, nanoseconds / number_of_calls, sum / number_of_calls);
+}
+/*  End of benchmark.                                                         */
+
+/*  Main routine used for testing our implementation of the two methods.      */
+int main(void)
+{
+    /*  The initial guess point.                                              */
+    const double x = 2.0;
+
+    /*  Calculate the square root with both methods. The function template is *
+     *  given the type of variable the solver evaluates it at.                */
+    const double newton_sqrt_x = Newton::root(func<Newton::Variable>, x);
+    const double halley_sqrt_x = Halley::root(func<Halley::Variable>, x);
+    std::printf("Newton: sqrt(%.1f) = %.16f\n", x, newton_sqrt_x);
+    std::printf("Halley: sqrt(%.1f) = %.16f\n", x, halley_sqrt_x);
+
+    /*  A dual number may also be used by itself. At x = 2 the derivative of  *
+     *  2 - x^2 is -4.                                                        */
+    const Dual y = func(Dual::variable(x));
+    std::printf("f(2) = %.1f, f'(2) = %.1f\n", y.value(), y.derivative());
+
+    /*  The same computation, but done by the compiler. The lambda takes an   *
+     *  auto parameter, so it works with dual numbers too. The static_assert  *
+     *  proves that no work is done at run time.                              */
+    constexpr double compile_time_sqrt_x = Halley::constexpr_root(
+        [](auto t) { return 2.0 - t*t; }, 2.0
+    );
+
+    static_assert(compile_time_sqrt_x > 1.4142 && compile_time_sqrt_x < 1.4143,
+                  "The square root of 2 should be about 1.41421");
+
+    std::printf("constexpr sqrt(%.1f) = %.16f\n", x, compile_time_sqrt_x);
+
+    /*  Compare the number of steps and calls to f with Steffensen's method.  *
+     *  Starting at x = 10, Steffensen's method runs out of iterations, while *
+     *  Newton's and Halley's methods still converge.                         */
+    compare("2 - x^2", func<double>, func<Newton::Variable>,
+            func<Halley::Variable>, 2.0);
+
+    compare("2 - x^2", func<double>, func<Newton::Variable>,
+            func<Halley::Variable>, 10.0);
+
+    compare("cos(x) - x", dottie<double>, dottie<Newton::Variable>,
+            dottie<Halley::Variable>, 0.5);
+
+    /*  Fewer calls is not the whole story, since a call at a dual number     *
+     *  does more arithmetic. cos is the most expensive part of dottie, and a *
+     *  dual number needs both cos and sin.                                   */
+    benchmark<Steffensen>(dottie<double>, "Steffensen:");
+    benchmark<Newton>(dottie<Newton::Variable>, "Newton:");
+    benchmark<Halley>(dottie<Halley::Variable>, "Halley:");
+
+    /*  The class works for every type of real number.                        */
+    const BasicHouseholder<float, 1U>::Result root_float =
+        BasicHouseholder<float, 1U>::detailed_root(
+            [](auto t) { return 2.0F - t*t; }, 2.0F
+        );
+
+    const BasicHouseholder<long double, 2U>::Result root_long =
+        BasicHouseholder<long double, 2U>::detailed_root(
+            [](auto t) { return 2.0L - t*t; }, 2.0L
+        );
+
+    std::printf("float, Newton:       %.8f, %u iterations\n",
+                static_cast<double>(root_float.root), root_float.iterations);
+
+    std::printf("long double, Halley: %.19Lf, %u iterations\n",
+                root_long.root, root_long.iterations);
+
+#if defined(SOLVER_STATISTICS)
+    Newton::print_statistics();
+    Halley::print_statistics();
+#endif
+
+    return 0;
+}
+
+/*  We can execute this on GNU, Linux, FreeBSD, macOS, etc., via:             *
+ *      c++ -std=c++17 newtons_method.cpp -o main                             *
+ *      ./main                                                                *
+ *  This will output the following:                                           *
+ *      Newton: sqrt(2.0) = 1.4142135623730949                                *
+ *      Halley: sqrt(2.0) = 1.4142135623730951                                *
+ *      f(2) = -2.0, f'(2) = -4.0                                             *
+ *      constexpr sqrt(2.0) = 1.4142135623730951                              *
+ *      2 - x^2 from x = 2.0:                                                 *
+ *          Steffensen: 1.4142135623730951,  7 iterations, 14 evaluations     *
+ *          Newton:     1.4142135623730949,  6 iterations,  6 evaluations     *
+ *          Halley:     1.4142135623730951,  4 iterations,  4 evaluations     *
+ *      2 - x^2 from x = 10.0:                                                *
+ *          Steffensen: 28.1689416934463814, 16 iterations, 32 evaluations    *
+ *          Newton:     1.4142135623730949,  9 iterations,  9 evaluations     *
+ *          Halley:     1.4142135623730949,  6 iterations,  6 evaluations     *
+ *      cos(x) - x from x = 0.5:                                              *
+ *          Steffensen: 0.7390851332151607,  5 iterations,  9 evaluations     *
+ *          Newton:     0.7390851332151607,  5 iterations,  5 evaluations     *
+ *          Halley:     0.7390851332151607,  4 iterations,  4 evaluations     *
+ *  Then come the timings for the three methods on cos(x) - x. These depend   *
+ *  on the machine. Newton's method needs half the calls of Steffensen's      *
+ *  method, but each call computes both cos and sin, so it is only somewhat   *
+ *  faster. Halley's method saves one more step. Last is                      *
+ *      float, Newton:       1.41421354, 5 iterations                         *
+ *      long double, Halley: 1.4142135623730950488, 4 iterations              *
+ *  The long double line depends on the platform. With MSVC, long double is   *
+ *  the same as double.                                                       *
+ *  To count the calls and iterations, and print a histogram at the end, add  *
+ *  -DSOLVER_STATISTICS to the command.                                       *
+ *                                                                            *
+ *  On Windows you will need to install a C++ compiler. Microsoft's MSVC is a *
+ *  common option. Using MSVC, type:                                          *
+ *      cl /std:c++17 newtons_method.cpp /link /out:main.exe                  *
+ *      main.exe                                                              *
+ *  This will produce the same output.                                        */
@@ -0,0 +1,406 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Header-only implementation of Newton's method and Halley's method for *
+ *      finding roots, with the derivatives computed by dual numbers.         *
+ *  Notes:                                                                    *
+ *      Provides BasicHouseholder<Real, Order> and the Newton and Halley      *
+ *      typedefs. Newton's method, order 1, converges quadratically and       *
+ *      Halley's method, order 2, cubically. Both evaluate f once per step,   *
+ *      at a dual number, and get the derivatives they need from that one     *
+ *      call. newtons_method.cpp shows how they are used.                     *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/31                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_NEWTONS_METHOD_HPP
+#define MITX_NEWTONS_METHOD_HPP
+
+/*  cstdio provides the "printf" function, used for printing text.            */
+#include <cstdio>
+
+/*  Floating-point absolute value function, fabs, provided here.              */
+#include <cmath>
+
+/*  std::numeric_limits, used for the precision of each type, found here.     */
+#include <limits>
+
+/*  std::conditional, used to pick the type of the variable, is here.         */
+#include <type_traits>
+
+/*  Dual numbers, which compute f and its derivatives in one call.            */
+#include "dual_number.hpp"
+
+/*  Statistics about every call to root may optionally be kept. This is off   *
+ *  by default, since it costs a little time. Compile with                    *
+ *  -DSOLVER_STATISTICS to turn it on. The counters are atomic, so the solver *
+ *  may still be called from several threads at once.                         */
+#if defined(SOLVER_STATISTICS)
+#include <atomic>
+#endif
+
+/*  Computes the root of a function using one of Householder's methods. Order *
+ *  1 is Newton's method, x_{n+1} = x_n - f / f', and Order 2 is Halley's     *
+ *  method, x_{n+1} = x_n - 2 f f' / (2 f'^2 - f f''). Newton's method gains  *
+ *  about twice as many digits every step, Halley's method three times as     *
+ *  many.                                                                     *
+ *                                                                            *
+ *  The derivatives are not written by hand. f is evaluated once per step at  *
+ *  a dual number, Variable, which returns f and its derivatives together.    *
+ *  The function must therefore be a template, or a lambda with an auto       *
+ *  parameter, so that it accepts a Variable. See dual_number.hpp.            *
+ *                                                                            *
+ *  Compared to Steffensen's method, which calls f twice per step at a Real,  *
+ *  this calls f once per step at a dual number. Each arithmetic operation on *
+ *  a dual number costs a few operations on Real, a product is three          *
+ *  multiplications and an addition, so this pays off when f is much more     *
+ *  expensive to call than to differentiate, or when fewer steps matter more  *
+ *  than cheap ones.                                                          *
+ *                                                                            *
+ *  The class is a template over the type of real number, Real, which may be  *
+ *  float, double, or long double. The tolerance comes from the precision of  *
+ *  Real.                                                                     */
+template <typename Real, unsigned int Order>
+class BasicHouseholder {
+
+    /*  Only the first two methods are provided. Higher orders need higher    *
+     *  derivatives and more nesting, and rarely pay off.                     */
+    static_assert(Order == 1U || Order == 2U,
+                  "Order must be 1 for Newton's method or 2 for Halley's.");
+
+    /*  Both methods converge very quickly near a simple root. Because of     *
+     *  this we may exit the function after a few iterations.                 */
+    static const unsigned int maximum_number_of_iterations = 16U;
+
+    /*  std::fabs is not constexpr, so it can not be used when computing      *
+     *  values at compile time. The absolute value is easy to write.          */
+    static constexpr Real absolute_value(Real x)
+    {
+        return (x < 0.0 ? -x : x);
+    }
+    /*  End of absolute_value.                                                */
+
+    /*  Adds a finished call to the statistics. Nothing is done, and the      *
+     *  compiler removes the call entirely, unless statistics are enabled.    *
+     *  Relaxed atomics are enough since the counters are only ever added to, *
+     *  and they are read once all of the work is done.                       */
+    static void record(unsigned int iterations,
+                       unsigned int evaluations,
+                       bool converged)
+    {
+#if defined(SOLVER_STATISTICS)
+
+        /*  A larger cap may be given in the Options. Such calls all go in    *
+         *  the last entry of the histogram.                                  */
+        if (iterations > maximum_number_of_iterations)
+            iterations = maximum_number_of_iterations;
+
+        statistics.histogram[iterations].fetch_add(
+            1UL, std::memory_order_relaxed
+        );
+
+        statistics.evaluations.fetch_add(
+            evaluations, std::memory_order_relaxed
+        );
+
+        if (!converged)
+            statistics.failures.fetch_add(1UL, std::memory_order_relaxed);
+#else
+        static_cast<void>(iterations);
+        static_cast<void>(evaluations);
+        static_cast<void>(converged);
+#endif
+    }
+    /*  End of record.                                                        */
+
+    /*  We want the types and functions visible outside the class. Declare    *
+     *  them public.                                                          */
+    public:
+
+        /*  The type f is evaluated at. Newton's method needs f', which one   *
+         *  dual number gives. Halley's method also needs f'', which a dual   *
+         *  number of dual numbers gives.                                     */
+        typedef typename std::conditional<
+            Order == 1U, BasicDual<Real>, BasicDual<BasicDual<Real>>
+        >::type Variable;
+
+    private:
+
+        /*  Evaluates f once at x, stores f(x) in f_x, and returns the step,  *
+         *  x_n - x_{n+1}. This is the only place the two methods differ.     *
+         *  There is no safeguard if the denominator is zero, just as for     *
+         *  Steffensen's method, and the step is then infinite or NaN.        */
+        template <typename Function>
+        static constexpr Real step(Function f, Real x, Real &f_x)
+        {
+            const Real one = static_cast<Real>(1);
+
+            if constexpr (Order == 1U)
+            {
+                /*  f(x + e) = f(x) + f'(x) e.                                */
+                const Variable y = f(Variable::variable(x));
+                f_x = y.value();
+                return f_x / y.derivative();
+            }
+
+            else
+            {
+                /*  The variable is (x + e) + (1 + 0 e) e'. The value part of *
+                 *  f at this point is f(x) + f'(x) e, and the e' part is     *
+                 *  f'(x) + f''(x) e.                                         */
+                const Variable y = f(
+                    Variable(BasicDual<Real>(x, one), BasicDual<Real>(one))
+                );
+
+                const Real two = static_cast<Real>(2);
+                const Real df = y.value().derivative();
+                const Real d2f = y.derivative().derivative();
+                f_x = y.value().value();
+                return two * f_x * df / (two * df * df - f_x * d2f);
+            }
+        }
+        /*  End of step.                                                      */
+
+    public:
+
+        /*  Everything we know about a finished call to detailed_root.        *
+         *  iterations is the number of steps, and evaluations the number of  *
+         *  times f was called, one per step, each at a dual number.          *
+         *  converged is false if we ran out of iterations before we were     *
+         *  within the tolerance. residual is f(x_n) for the last x_n that    *
+         *  was checked. The returned root is one step beyond this point, so  *
+         *  its residual is usually much smaller still.                       */
+        struct Result {
+            Real root;
+            unsigned int iterations;
+            unsigned int evaluations;
+            bool converged;
+            Real residual;
+        };
+
+#if defined(SOLVER_STATISTICS)
+
+        /*  Counters for every call to root and detailed_root. histogram[n]   *
+         *  is the number of calls that took n iterations, and failures the   *
+         *  number of calls that did not converge. The last entry also counts *
+         *  calls that took more, if a larger cap was given in the Options.   *
+         *  The total number of calls is the sum of the histogram. The        *
+         *  constexpr routine is not counted.                                 */
+        struct Statistics {
+            std::atomic<unsigned long int> evaluations;
+            std::atomic<unsigned long int> failures;
+            std::atomic<unsigned long int>
+                histogram[maximum_number_of_iterations + 1U];
+        };
+
+        /*  The counters themselves, shared by all threads.                   */
+        static Statistics statistics;
+
+        /*  Prints the counters to the screen.                                */
+        static void print_statistics(void)
+        {
+            unsigned long int calls = 0UL;
+            unsigned int n;
+
+            for (n = 0U; n <= maximum_number_of_iterations; ++n)
+                calls += statistics.histogram[n].load();
+
+            std::printf("%s::root calls: %lu, evaluations: %lu, "
+                        "failures: %lu\n",
+                        (Order == 1U ? "Newton" : "Halley"),
+                        calls, statistics.evaluations.load(),
+                        statistics.failures.load());
+
+            for (n = 0U; n <= maximum_number_of_iterations; ++n)
+                if (statistics.histogram[n].load() != 0UL)
+                    std::printf("    %2u iterations: %lu\n",
+                                n, statistics.histogram[n].load());
+        }
+        /*  End of print_statistics.                                          */
+
+#endif
+
+        /*  When to stop iterating. Absolute stops once |f(x_n)| is below the *
+         *  tolerance. Relative stops once a step changes x_n by at most      *
+         *  tolerance * |x_n|, meaning x_n has settled to about that relative *
+         *  accuracy, no matter how f is scaled.                              */
+        enum Stopping {
+            Absolute,
+            Relative
+        };
+
+        /*  Settings for the solver, the same as for Steffensen's method.     */
+        struct Options {
+            Real tolerance;
+            unsigned int maximum_number_of_iterations;
+            Stopping stopping;
+        };
+
+        /*  The settings used by root when no Options are given. This is 4x   *
+         *  the precision of Real, compared against |f(x_n)|, and the usual   *
+         *  cap on the number of iterations.                                  */
+        static constexpr Options default_options(void)
+        {
+            return Options{
+                4 * std::numeric_limits<Real>::epsilon(),
+                maximum_number_of_iterations,
+                Absolute
+            };
+        }
+        /*  End of default_options.                                           */
+
+        /*  Computes the root of f starting at x. The function may be any     *
+         *  callable object that accepts a Variable: a function template like *
+         *  func<Newton::Variable>, a lambda with an auto parameter, or a     *
+         *  class with a templated operator(). The compiler creates a copy of *
+         *  this routine for each, and inlines the body of f into the loop    *
+         *  below.                                                            */
+        template <typename Function>
+        static Real root(Function f, Real x)
+        {
+            return detailed_root(f, x).root;
+        }
+        /*  End of root.                                                      */
+
+        /*  Same as above, with a choice of tolerance and iteration cap.      */
+        template <typename Function>
+        static Real root(Function f, Real x, const Options &options)
+        {
+            return detailed_root(f, x, options).root;
+        }
+        /*  End of root.                                                      */
+
+        /*  Computes the root and reports how the computation went. The root  *
+         *  functions above simply return the root from this. The extra       *
+         *  fields cost nothing there, since the compiler sees that they are  *
+         *  unused and removes them.                                          */
+        template <typename Function>
+        static Result detailed_root(Function f, Real x)
+        {
+            return detailed_root(f, x, default_options());
+        }
+        /*  End of detailed_root.                                             */
+
+        /*  Same as above, with a choice of tolerance and iteration cap.      */
+        template <typename Function>
+        static Result
+        detailed_root(Function f, Real x, const Options &options)
+        {
+            /*  Variable keeping track of how many iterations we perform.     */
+            unsigned int iters;
+
+            /*  The method starts at the guess point and updates iteratively. */
+            Real xn = x;
+
+            /*  The last value of f(x_n) that was computed, and the result.   */
+            Real f_xn = 0.0;
+            Result result;
+
+            for (iters = 0; iters < options.maximum_number_of_iterations;
+                 ++iters)
+            {
+                /*  The previous point, for the relative stopping rule.       */
+                const Real previous = xn;
+
+                /*  One evaluation of f gives the value and the step.         */
+                xn = xn - step(f, xn, f_xn);
+
+                /*  If f(x) is very small, we are close to a root and can     *
+                 *  break out of this for loop. Check for this.               */
+                if (options.stopping == Absolute)
+                {
+                    if (std::fabs(f_xn) < options.tolerance)
+                        break;
+                }
+
+                /*  Otherwise, check how far the step moved us.               */
+                else if (std::fabs(xn - previous) <=
+                         options.tolerance * std::fabs(xn))
+                    break;
+            }
+
+            result.root = xn;
+            result.converged = (iters < options.maximum_number_of_iterations);
+
+            /*  If we broke out of the loop, the step we broke on counts.     */
+            result.iterations = (result.converged ? iters + 1U : iters);
+            result.evaluations = result.iterations;
+            result.residual = f_xn;
+            record(result.iterations, result.evaluations, result.converged);
+            return result;
+        }
+        /*  End of detailed_root.                                             */
+
+        /*  Computes the root of a function at compile time. The function     *
+         *  must itself be constexpr, for example a lambda using only         *
+         *  arithmetic, since the dual number versions of sin, cos, and so on *
+         *  are not. The steps are identical to the root function above,      *
+         *  except that we stop as soon as f(x_n) is exactly zero, since the  *
+         *  step is then zero too.                                            */
+        template <typename Function>
+        static constexpr Real constexpr_root(Function f, Real x)
+        {
+            /*  Maximum allowed error, 4x the precision of Real.              */
+            const Real epsilon = 4 * std::numeric_limits<Real>::epsilon();
+
+            /*  Variable keeping track of how many iterations we perform.     */
+            unsigned int iters = 0U;
+
+            /*  The method starts at the guess point and updates iteratively. */
+            Real xn = x;
+            Real f_xn = 0.0;
+
+            for (iters = 0U; iters < maximum_number_of_iterations; ++iters)
+            {
+                const Real delta = step(f, xn, f_xn);
+
+                /*  x_n is an exact root, we are done.                        */
+                if (f_xn == 0.0)
+                    break;
+
+                xn = xn - delta;
+
+                if (absolute_value(f_xn) < epsilon)
+                    break;
+            }
+
+            return xn;
+        }
+        /*  End of constexpr_root.                                            */
+};
+/*  End of BasicHouseholder definition.                                       */
+
+/*  Most code wants double. Newton::root(f, x) is shorter than writing        *
+ *  BasicHouseholder<double, 1U>::root(f, x) every time.                      */
+typedef BasicHouseholder<double, 1U> Newton;
+typedef BasicHouseholder<double, 2U> Halley;
+
+/*  The counters are static members of the class, and need a definition.      *
+ *  Static storage starts out zero, so they all begin at zero.                */
+#if defined(SOLVER_STATISTICS)
+template <typename Real, unsigned int Order>
+typename BasicHouseholder<Real, Order>::Statistics
+BasicHouseholder<Real, Order>::statistics;
+#endif
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,560 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Solves many root finding problems at once using several threads.      *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/07/20                                                        *
+ ******************************************************************************/
+
+/*  stdio provides the "printf" function, used for printing text.             */
+#include <cstdio>
+
+/*  The power function, pow, used for the inputs, provided here.              */
+#include <cmath>
+
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  Timing routines, used for benchmarking.                                   */
+#include <chrono>
+
+/*  std::function, used to hold the work handed to the threads.               */
+#include <functional>
+
+/*  std::unique_ptr, used for the array of per-thread work ranges.            */
+#include <memory>
+
+/*  Threads, locks, and condition variables, used by the thread pool.         */
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/*  std::vector, used for storing the threads and for the benchmark data.     */
+#include <vector>
+
+/*  The solvers, Heron::sqrt, Bisection::root, and Steffensen::root. Each     *
+ *  takes the function as a template parameter, so that it may be inlined.    */
+#include "../bisection_method/bisection_method.hpp"
+#include "../steffensens_method/steffensens_method.hpp"
+#include "../../real_numbers/herons_method/herons_method.hpp"
+
+/*  A small thread pool with work stealing. The input is cut into chunks, and *
+ *  every thread starts with an equal, contiguous share of the chunks. A      *
+ *  thread works through its own share from the front. When it runs out, it   *
+ *  picks another thread and steals the back half of whatever that thread has *
+ *  left. Solvers like Steffensen's method take very different numbers of     *
+ *  iterations for different inputs, so some shares finish long before        *
+ *  others. Stealing keeps every thread busy until all of the work is done.   *
+ *                                                                            *
+ *  The thread that calls run takes part in the work as well, so a pool with  *
+ *  N threads starts N - 1 extra threads. They sleep between calls.           */
+class WorkStealingPool {
+
+    /*  The chunks a thread has left to do, [begin, end). The lock is taken   *
+     *  both by the owner, to take a chunk, and by thieves, to steal.         */
+    struct Range {
+        std::mutex lock;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /*  The number of threads, including the calling thread.                  */
+    std::size_t number_of_threads;
+
+    /*  The extra threads, and one range of chunks per thread.                */
+    std::vector<std::thread> threads;
+    std::unique_ptr<Range[]> ranges;
+
+    /*  The work for the current call. job(begin, end) handles the inputs     *
+     *  with index begin <= k < end.                                          */
+    std::function<void(std::size_t, std::size_t)> job;
+    std::size_t chunk_size;
+    std::size_t number_of_inputs;
+
+    /*  If false, threads only do their own share. Used for comparison.       */
+    bool steal;
+
+    /*  Used to wake sleeping threads for a new call, and to tell the calling *
+     *  thread that everyone is finished. generation counts the calls, busy   *
+     *  counts the extra threads still working on one.                        */
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::size_t generation;
+    std::size_t busy;
+    bool stopping;
+
+    /*  Takes the next chunk from thread k's own range. Returns false if the  *
+     *  range is empty.                                                       */
+    bool take(std::size_t k, std::size_t &chunk)
+    {
+        std::lock_guard<std::mutex> guard(ranges[k].lock);
+
+        if (ranges[k].begin == ranges[k].end)
+            return false;
+
+        chunk = ranges[k].begin;
+        ++ranges[k].begin;
+        return true;
+    }
+    /*  End of take.                                                          */
+
+    /*  Thread k steals the back half of another thread's range, and makes it *
+     *  its own. The victims are tried in order, starting with the next       *
+     *  thread. Returns false if every other range is empty.                  */
+    bool steal_work(std::size_t k)
+    {
+        std::size_t offset;
+
+        for (offset = 1; offset < number_of_threads; ++offset)
+        {
+            Range &victim = ranges[(k + offset) % number_of_threads];
+            std::size_t begin, end;
+
+            {
+                std::lock_guard<std::mutex> guard(victim.lock);
+                const std::size_t remaining = victim.end - victim.begin;
+
+                if (remaining == 0)
+                    continue;
+
+                /*  Take the back half, rounded up, so that a single          *
+                 *  remaining chunk can be stolen too.                        */
+                end = victim.end;
+                begin = victim.end - (remaining + 1) / 2;
+                victim.end = begin;
+            }
+
+            /*  Our own range is empty, nobody can steal from it right now.   *
+             *  Store the stolen chunks there.                                */
+            std::lock_guard<std::mutex> guard(ranges[k].lock);
+            ranges[k].begin = begin;
+            ranges[k].end = end;
+            return true;
+        }
+
+        return false;
+    }
+    /*  End of steal_work.                                                    */
+
+    /*  The work loop for thread k. Handle our own chunks, then steal, until  *
+     *  there is nothing left anywhere.                                       */
+    void work(std::size_t k)
+    {
+        std::size_t chunk;
+
+        while (true)
+        {
+            if (take(k, chunk))
+            {
+                const std::size_t begin = chunk * chunk_size;
+                std::size_t end = begin + chunk_size;
+
+                if (end > number_of_inputs)
+                    end = number_of_inputs;
+
+                job(begin, end);
+            }
+
+            else if (!steal || !steal_work(k))
+                break;
+        }
+    }
+    /*  End of work.                                                          */
+
+    /*  The main loop of the extra threads. Sleep until there is a new call   *
+     *  (or the pool is being destroyed), do the work, and report back.       */
+    void thread_loop(std::size_t k)
+    {
+        std::size_t seen = 0;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+
+                while (generation == seen && !stopping)
+                    wake.wait(guard);
+
+                if (stopping)
+                    return;
+
+                seen = generation;
+            }
+
+            work(k);
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                --busy;
+            }
+
+            finished.notify_one();
+        }
+    }
+    /*  End of thread_loop.                                                   */
+
+    /*  Everything below is visible outside the class.                        */
+    public:
+
+        /*  Creates a pool with the given number of threads. Zero means one   *
+         *  thread per core, as reported by the standard library.             */
+        explicit WorkStealingPool(std::size_t threads_to_use = 0)
+            : number_of_threads(threads_to_use),
+              chunk_size(1),
+              number_of_inputs(0),
+              steal(true),
+              generation(0),
+              busy(0),
+              stopping(false)
+        {
+            std::size_t k;
+
+            if (number_of_threads == 0)
+                number_of_threads = std::thread::hardware_concurrency();
+
+            /*  hardware_concurrency may return 0 if it does not know.        */
+            if (number_of_threads == 0)
+                number_of_threads = 1;
+
+            ranges.reset(new Range[number_of_threads]);
+
+            for (k = 0; k < number_of_threads; ++k)
+                ranges[k].begin = ranges[k].end = 0;
+
+            /*  Thread 0 is the thread that calls run. Start the others.      */
+            for (k = 1; k < number_of_threads; ++k)
+                threads.push_back(
+                    std::thread(&WorkStealingPool::thread_loop, this, k)
+                );
+        }
+        /*  End of WorkStealingPool.                                          */
+
+        /*  Wakes the threads up, tells them to stop, and waits for them.     */
+        ~WorkStealingPool(void)
+        {
+            std::size_t k;
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                stopping = true;
+            }
+
+            wake.notify_all();
+
+            for (k = 0; k < threads.size(); ++k)
+                threads[k].join();
+        }
+        /*  End of ~WorkStealingPool.                                         */
+
+        /*  The threads may not be copied.                                    */
+        WorkStealingPool(const WorkStealingPool &) = delete;
+        WorkStealingPool &operator = (const WorkStealingPool &) = delete;
+
+        /*  The number of threads used, including the calling thread.         */
+        std::size_t size(void) const
+        {
+            return number_of_threads;
+        }
+
+        /*  Turns work stealing on or off. With it off, every thread does     *
+         *  exactly its static share. This is only useful for comparison.     */
+        void set_stealing(bool enable)
+        {
+            steal = enable;
+        }
+
+        /*  Calls kernel(begin, end) on chunks of [0, n) using all threads,   *
+         *  and returns once everything is done. Each chunk has chunk inputs, *
+         *  except possibly the last.                                         */
+        void run(std::size_t n,
+                 std::size_t chunk,
+                 const std::function<void(std::size_t, std::size_t)> &kernel)
+        {
+            std::size_t k;
+            std::size_t number_of_chunks;
+
+            if (n == 0)
+                return;
+
+            if (chunk == 0)
+                chunk = 1;
+
+            number_of_chunks = (n + chunk - 1) / chunk;
+
+            job = kernel;
+            chunk_size = chunk;
+            number_of_inputs = n;
+
+            /*  Give every thread an equal, contiguous share of chunks.       */
+            for (k = 0; k < number_of_threads; ++k)
+            {
+                const std::size_t m = number_of_threads;
+                ranges[k].begin = (k * number_of_chunks) / m;
+                ranges[k].end = ((k + 1) * number_of_chunks) / m;
+            }
+
+            /*  Wake the other threads. The lock makes the new ranges and the *
+             *  job visible to them.                                          */
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                busy = number_of_threads - 1;
+                ++generation;
+            }
+
+            wake.notify_all();
+
+            /*  Do our share of the work, then wait for the others.           */
+            work(0);
+
+            std::unique_lock<std::mutex> guard(lock);
+
+            while (busy != 0)
+                finished.wait(guard);
+        }
+        /*  End of run.                                                       */
+};
+/*  End of WorkStealingPool definition.                                       */
+
+/*  Solves many problems in parallel with Heron, Bisection, or Steffensen. A  *
+ *  chunk of 256 inputs is small enough to balance well, and large enough     *
+ *  that taking a chunk is cheap compared to the work in it.                  */
+class ParallelSolver {
+
+    /*  The threads doing the work.                                           */
+    WorkStealingPool &pool;
+
+    /*  The number of inputs handed out at a time.                            */
+    static const std::size_t chunk_size = 256;
+
+    /*  Everything below is visible outside the class.                        */
+    public:
+
+        /*  Creates a solver that runs on the given pool.                     */
+        explicit ParallelSolver(WorkStealingPool &threads) : pool(threads)
+        {
+            /*  Nothing to do, the pool does all of the work.                 */
+        }
+
+        /*  Computes out[k] = Heron::sqrt(in[k]) for 0 <= k < n.              */
+        void sqrt(const double * const in, double * const out, std::size_t n)
+        {
+            pool.run(n, chunk_size, [=](std::size_t begin, std::size_t end) {
+                std::size_t k;
+
+                for (k = begin; k < end; ++k)
+                    out[k] = Heron::sqrt(in[k]);
+            });
+        }
+        /*  End of sqrt.                                                      */
+
+        /*  Computes out[k] = Bisection::root(f, a[k], b[k]) for k < n.       */
+        template <typename Function>
+        void bisection(Function f,
+                       const double * const a,
+                       const double * const b,
+                       double * const out,
+                       std::size_t n)
+        {
+            pool.run(n, chunk_size, [=](std::size_t begin, std::size_t end) {
+                std::size_t k;
+
+                for (k = begin; k < end; ++k)
+                    out[k] = Bisection::root(f, a[k], b[k]);
+            });
+        }
+        /*  End of bisection.                                                 */
+
+        /*  Computes out[k] = Steffensen::root(f, x[k]) for 0 <= k < n.       */
+        template <typename Function>
+        void steffensen(Function f,
+                        const double * const x,
+                        double * const out,
+                        std::size_t n)
+        {
+            pool.run(n, chunk_size, [=](std::size_t begin, std::size_t end) {
+                std::size_t k;
+
+                for (k = begin; k < end; ++k)
+                    out[k] = Steffensen::root(f, x[k]);
+            });
+        }
+        /*  End of steffensen.                                                */
+};
+/*  End of ParallelSolver definition.                                         */
+
+/*  sqrt(2) is a root to the function f(x) = 2 - x^2. Provide this.           */
+static double func(double x)
+{
+    return 2.0 - x*x;
+}
+/*  End of func.                                                              */
+
+/*  Returns the time since start in nanoseconds.                              */
+static double
+elapsed(const std::chrono::steady_clock::time_point &start)
+{
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+/*  End of elapsed.                                                           */
+
+/*  Times the three solvers with the given number of threads, printing the    *
+ *  time per input. sqrt and Steffensen's method are run with and without     *
+ *  work stealing. The inputs are sorted, so the expensive ones (large x for  *
+ *  Heron, starting points far from sqrt(2) for Steffensen) are all in the    *
+ *  last few shares. This is the worst case for static chunking.              */
+static void benchmark(std::size_t number_of_threads,
+                      const std::vector<double> &x,
+                      const std::vector<double> &guesses,
+                      const std::vector<double> &left,
+                      const std::vector<double> &right,
+                      std::vector<double> &out)
+{
+    WorkStealingPool pool(number_of_threads);
+    ParallelSolver solver(pool);
+    const double n = static_cast<double>(x.size());
+    double heron[2], steffensen[2], bisection;
+    int stealing;
+
+    for (stealing = 0; stealing < 2; ++stealing)
+    {
+        pool.set_stealing(stealing == 1);
+
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+
+        solver.sqrt(x.data(), out.data(), x.size());
+        heron[stealing] = elapsed(start) / n;
+
+        start = std::chrono::steady_clock::now();
+        solver.steffensen(func, guesses.data(), out.data(), guesses.size());
+        steffensen[stealing] = elapsed(start) / n;
+    }
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    solver.bisection(
+        [](double t) { return 2.0 - t*t; },
+        left.data(), right.data(), out.data(), left.size()
+    );
+
+    bisection = elapsed(start) / n;
+
+    std::printf("%7lu  %10.2f %10.2f  %10.2f %10.2f  %10.2f\n",
+                static_cast<unsigned long int>(pool.size()),
+                heron[0], heron[1], steffensen[0], steffensen[1], bisection);
+}
+/*  End of benchmark.                                                         */
+
+/*  Main routine used for testing the parallel solvers.                       */
+int main(void)
+{
+    /*  The number of problems to solve for each solver.                      */
+    const std::size_t n = 1U << 20;
+
+    /*  The most threads to try, and the number of cores available.           */
+    const std::size_t maximum_number_of_threads = 64;
+    std::size_t cores = std::thread::hardware_concurrency();
+    std::size_t number_of_threads;
+
+    /*  Inputs for Heron, starting points for Steffensen, brackets for the    *
+     *  bisection method, and the outputs.                                    */
+    std::vector<double> x(n), guesses(n), left(n), right(n), out(n);
+    std::size_t k;
+    std::size_t mismatches = 0;
+
+    for (k = 0; k < n; ++k)
+    {
+        const double t = static_cast<double>(k) / static_cast<double>(n);
+
+        /*  1 <= x < 10^6. Heron's method needs more steps for larger x.      */
+        x[k] = std::pow(10.0, 6.0 * t);
+
+        /*  Steffensen's method needs more steps the further x_0 is from      *
+         *  sqrt(2), up to the maximum of 16 iterations.                      */
+        guesses[k] = 1.5 + 3.5 * t;
+
+        left[k] = 1.0;
+        right[k] = 2.0 + t;
+    }
+
+    if (cores == 0)
+        cores = 1;
+
+    /*  The parallel results should be identical to the serial ones.          */
+    {
+        WorkStealingPool pool;
+        ParallelSolver solver(pool);
+
+        solver.steffensen(func, guesses.data(), out.data(), n);
+
+        for (k = 0; k < n; ++k)
+            if (out[k] != Steffensen::root(func, guesses[k]))
+                ++mismatches;
+
+        std::printf("Threads: %lu, mismatches: %lu of %lu\n",
+                    static_cast<unsigned long int>(pool.size()),
+                    static_cast<unsigned long int>(mismatches),
+                    static_cast<unsigned long int>(n));
+    }
+
+    /*  Time per input, in nanoseconds, for 1, 2, 4, ... threads, up to the   *
+     *  number of cores (at most 64).                                         */
+    std::printf("\n%7s  %10s %10s  %10s %10s  %10s\n",
+                "threads", "Heron", "Heron", "Steffensen", "Steffensen",
+                "Bisection");
+    std::printf("%7s  %10s %10s  %10s %10s  %10s\n",
+                "", "static", "stealing", "static", "stealing", "stealing");
+
+    for (number_of_threads = 1;
+         number_of_threads <= maximum_number_of_threads;
+         number_of_threads *= 2)
+    {
+        if (number_of_threads > cores)
+            break;
+
+        benchmark(number_of_threads, x, guesses, left, right, out);
+    }
+
+    return 0;
+}
+
+/*  We can execute this on GNU, Linux, FreeBSD, macOS, etc., via:             *
+ *      c++ -O2 -pthread parallel_root_finding.cpp -o main                    *
+ *      ./main                                                                *
+ *  This will output the following:                                           *
+ *      Threads: N, mismatches: 0 of 1048576                                  *
+ *  where N is the number of cores, followed by a table of nanoseconds per    *
+ *  input for 1, 2, 4, ... threads, up to the number of cores, or 64,         *
+ *  whichever is smaller. The timings depend on the machine. With static      *
+ *  chunking the run time is set by the slowest share, which holds the most   *
+ *  expensive inputs. With work stealing the threads that finish early help   *
+ *  out, and the time per input keeps dropping as threads are added.          *
+ *                                                                            *
+ *  On Windows you will need to install a C++ compiler. Microsoft's MSVC is a *
+ *  common option. Using MSVC, type:                                          *
+ *      cl /std:c++17 /O2 parallel_root_finding.cpp /link /out:main.exe       *
+ *      main.exe                                                              *
+ *  This will produce the same output.                                        */
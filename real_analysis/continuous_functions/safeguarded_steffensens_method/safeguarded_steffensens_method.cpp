@@ -0,0 +1,403 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Calculates the root of a function using Steffensen's method, with the *
+ *      bisection method as a safeguard.                                      *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/07/24                                                        *
+ ******************************************************************************/
+
+/*  cstdio provides the "printf" function, used for printing text.            */
+#include <cstdio>
+
+/*  Floating-point absolute value function, fabs, provided here.              */
+#include <cmath>
+
+/*  The bisection method, used for comparing the number of evaluations.       */
+#include "../bisection_method/bisection_method.hpp"
+
+/*  The bisection method is robust. As long as f(a) and f(b) have opposite    *
+ *  signs, and f is continuous, it will find a root between a and b. It is    *
+ *  also slow, gaining one bit of accuracy per evaluation of f. Steffensen's  *
+ *  method is fast, roughly doubling the number of correct digits with every  *
+ *  step, but it may wander off, or divide by zero, if the starting point is  *
+ *  poor.                                                                     *
+ *                                                                            *
+ *  The method below, in the spirit of Dekker's and Brent's methods, gets the *
+ *  best of both. We keep a bracket [left, right] with f(left) < 0 and        *
+ *  f(right) > 0, exactly like the bisection method. Every step we try a      *
+ *  Steffensen step from our best point x. If it lands inside the bracket,    *
+ *  and it is making good progress, we take it. Otherwise we bisect. Every    *
+ *  point where f is evaluated is used to shrink the bracket, so the root can *
+ *  never escape, and no step can ever be worse than a bisection step by more *
+ *  than a factor of two.                                                     */
+class SafeguardedSteffensen {
+
+    /*  With the safeguard we never do worse than roughly two bisection steps *
+     *  per iteration. Stop after 64 iterations, like the bisection method    *
+     *  does.                                                                 */
+    static const unsigned int maximum_number_of_iterations = 64U;
+
+    /*  Replaces one end of the bracket with the point t. Since f(left) < 0   *
+     *  and f(right) > 0, the sign of f(t) tells us which end to replace.     */
+    static void
+    shrink(double &left, double &f_left,
+           double &right, double &f_right,
+           double t, double f_t)
+    {
+        if (f_t < 0.0)
+        {
+            left = t;
+            f_left = f_t;
+        }
+
+        else
+        {
+            right = t;
+            f_right = f_t;
+        }
+    }
+    /*  End of shrink.                                                        */
+
+    /*  Checks if t lies strictly between the two ends of the bracket. The    *
+     *  bracket may be oriented either way, left < right or right < left.     */
+    static bool inside(double t, double left, double right)
+    {
+        if (left < right)
+            return left < t && t < right;
+
+        return right < t && t < left;
+    }
+    /*  End of inside.                                                        */
+
+    /*  We want the functions visible outside the class. Declare them public. */
+    public:
+
+        /*  Everything we know about a finished call to detailed_root, the    *
+         *  same as for the bisection method. iterations is the number of     *
+         *  steps, and evaluations the number of times f was called,          *
+         *  including the two endpoints. converged is false if the bracket    *
+         *  was bad, or if we ran out of iterations. residual is f at the     *
+         *  returned root.                                                    */
+        struct Result {
+            double root;
+            unsigned int iterations;
+            unsigned int evaluations;
+            bool converged;
+            double residual;
+        };
+
+        /*  Computes a root of f between a and b. f(a) and f(b) must have     *
+         *  opposite signs, otherwise NaN is returned, just like the          *
+         *  bisection method. The function may be any callable object.        */
+        template <typename Function>
+        static double root(Function f, double a, double b)
+        {
+            return detailed_root(f, a, b).root;
+        }
+        /*  End of root.                                                      */
+
+        /*  Same as root, but returns the number of iterations and            *
+         *  evaluations of f, and whether the method converged, as well.      */
+        template <typename Function>
+        static Result detailed_root(Function f, double a, double b)
+        {
+            /*  The maximum allowed error. This is double precision epsilon,  *
+             *  the same criterion as the bisection method.                   */
+            const double epsilon = 2.220446049250313E-16;
+
+            /*  Variable for keeping track of the number of iterations.       */
+            unsigned int iters;
+
+            /*  The bracket, with f(left) < 0 < f(right), and the values of f *
+             *  at the two ends.                                              */
+            double left, right, f_left, f_right;
+
+            /*  Our best guess for the root, and f at this point. The         *
+             *  previous guess is kept too, for the secant method.            */
+            double x, f_x, x_old, f_old;
+
+            /*  The sizes of the last two steps. A Steffensen step is only    *
+             *  accepted if it is less than half the size of the step taken   *
+             *  two iterations ago. If Steffensen's method is converging, the *
+             *  steps shrink very quickly and this is no restriction at all.  *
+             *  If it is not, we bisect, and the bracket is halved.           */
+            double step, previous_step;
+
+            /*  The result, filled in as we go.                               */
+            Result result;
+
+            /*  Evaluate f at the endpoints.                                  */
+            const double a_eval = f(a);
+            const double b_eval = f(b);
+
+            /*  No matter what happens, f was called for both endpoints.      */
+            result.iterations = 0U;
+            result.evaluations = 2U;
+            result.converged = true;
+            result.residual = 0.0;
+
+            /*  Rare cases, f(a) = 0 or f(b) = 0. No work needed.             */
+            if (a_eval == 0.0)
+            {
+                result.root = a;
+                return result;
+            }
+
+            if (b_eval == 0.0)
+            {
+                result.root = b;
+                return result;
+            }
+
+            /*  Both evaluations need opposite signs, otherwise the bracket   *
+             *  may not contain a root. Return NaN, like Bisection::root.     */
+            if ((a_eval < 0.0) == (b_eval < 0.0))
+            {
+                result.root = result.residual = (a - a) / (a - a);
+                result.converged = false;
+                return result;
+            }
+
+            /*  Set up the bracket so that f(left) < 0 < f(right).            */
+            if (a_eval < 0.0)
+            {
+                left = a;
+                f_left = a_eval;
+                right = b;
+                f_right = b_eval;
+            }
+
+            else
+            {
+                left = b;
+                f_left = b_eval;
+                right = a;
+                f_right = a_eval;
+            }
+
+            /*  Start at whichever end of the bracket has the smaller value   *
+             *  of |f|, the other end is the previous guess. Both step sizes  *
+             *  start as the width of the bracket, so the first step is       *
+             *  accepted if it lands inside.                                  */
+            if (std::fabs(f_left) < std::fabs(f_right))
+            {
+                x = left;
+                f_x = f_left;
+                x_old = right;
+                f_old = f_right;
+            }
+
+            else
+            {
+                x = right;
+                f_x = f_right;
+                x_old = left;
+                f_old = f_left;
+            }
+
+            step = previous_step = std::fabs(right - left);
+
+            for (iters = 0; iters < maximum_number_of_iterations; ++iters)
+            {
+                /*  The next point, and whether we found a good one.          */
+                double next;
+                bool accept = false;
+
+                /*  Steffensen's method evaluates f at x + f(x). This point   *
+                 *  is only useful if it lies inside the bracket. If f is     *
+                 *  large compared to the width of the bracket it will not.   *
+                 *  In that case we try a secant step through the last two    *
+                 *  guesses instead, which costs nothing extra.               */
+                const double z = x + f_x;
+
+                if (inside(z, left, right))
+                {
+                    const double f_z = f(z);
+                    ++result.evaluations;
+
+                    /*  We got lucky and found a root.                        */
+                    if (std::fabs(f_z) <= epsilon)
+                    {
+                        result.root = z;
+                        result.iterations = iters + 1U;
+                        result.residual = f_z;
+                        return result;
+                    }
+
+                    /*  This evaluation shrinks the bracket too.              */
+                    shrink(left, f_left, right, f_right, z, f_z);
+
+                    /*  The Steffensen step, x - f(x)^2 / (f(x + f(x)) -      *
+                     *  f(x)). Avoid dividing by zero.                        */
+                    if (f_z != f_x)
+                    {
+                        next = x - f_x * f_x / (f_z - f_x);
+                        accept = inside(next, left, right);
+                    }
+                }
+
+                /*  The secant step through the last two guesses. Using the   *
+                 *  ends of the bracket instead (regula falsi) is a poor      *
+                 *  choice, for convex f one end never moves and convergence  *
+                 *  is painfully slow.                                        */
+                if (!accept && f_x != f_old)
+                {
+                    next = x - f_x * (x - x_old) / (f_x - f_old);
+                    accept = inside(next, left, right);
+                }
+
+                /*  The safeguard. Reject steps outside the bracket, and      *
+                 *  steps that are not shrinking fast enough. Bisect instead. */
+                if (!accept || std::fabs(next - x) > 0.5 * previous_step)
+                    next = 0.5 * (left + right);
+
+                /*  Near the root the steps become tiny, and f is dominated   *
+                 *  by rounding error. Following Brent, always move by at     *
+                 *  least a few units in the last place, in the direction of  *
+                 *  the step. The new point will usually land on the other    *
+                 *  side of the root, collapsing the bracket.                 */
+                else
+                {
+                    const double tolerance = 2.0 * epsilon * std::fabs(x);
+                    const double nudged =
+                        (next < x ? x - tolerance : x + tolerance);
+
+                    if (std::fabs(next - x) < tolerance)
+                        if (inside(nudged, left, right))
+                            next = nudged;
+                }
+
+                previous_step = step;
+                step = std::fabs(next - x);
+
+                /*  Evaluate f at the new point and shrink the bracket.       */
+                x_old = x;
+                f_old = f_x;
+                x = next;
+                f_x = f(x);
+                ++result.evaluations;
+
+                if (std::fabs(f_x) <= epsilon)
+                    break;
+
+                shrink(left, f_left, right, f_right, x, f_x);
+
+                /*  If f is scaled so that |f| never gets below epsilon, the  *
+                 *  bracket itself can still shrink to a few units in the     *
+                 *  last place. We can not do any better than this.           */
+                if (std::fabs(right - left) <= 4.0 * epsilon * std::fabs(x))
+                    break;
+            }
+
+            /*  If we broke out of the loop, the step we broke on counts.     */
+            result.root = x;
+            result.converged = (iters < maximum_number_of_iterations);
+            result.iterations = (result.converged ? iters + 1U : iters);
+            result.residual = f_x;
+            return result;
+        }
+        /*  End of detailed_root.                                             */
+};
+/*  End of SafeguardedSteffensen definition.                                  */
+
+/*  Finds a root of f in [a, b] with both the bisection method and the        *
+ *  safeguarded Steffensen method, printing both roots and the number of      *
+ *  times f was evaluated.                                                    */
+template <typename Function>
+static void compare(Function f, double a, double b, const char * const name)
+{
+    const Bisection::Result bisection = Bisection::detailed_root(f, a, b);
+
+    const SafeguardedSteffensen::Result safeguarded =
+        SafeguardedSteffensen::detailed_root(f, a, b);
+
+    std::printf("%-14s %.16f %3u    %.16f %3u\n",
+                name,
+                bisection.root, bisection.evaluations,
+                safeguarded.root, safeguarded.evaluations);
+}
+/*  End of compare.                                                           */
+
+/*  Main routine used for testing the safeguarded Steffensen method.          */
+int main(void)
+{
+    std::printf("%-14s %-18s %5s    %-18s %5s\n",
+                "f(x)", "Bisection", "evals", "Safeguarded", "evals");
+
+    /*  sqrt(2), the root of 2 - x^2.                                         */
+    compare([](double x) { return 2.0 - x*x; }, 0.0, 2.0, "2 - x^2");
+
+    /*  pi, the root of sin(x) between 3 and 4.                               */
+    compare([](double x) { return std::sin(x); }, 3.0, 4.0, "sin(x)");
+
+    /*  The fixed point of cos(x), the Dottie number.                         */
+    compare([](double x) { return std::cos(x) - x; }, 0.0, 1.0, "cos(x) - x");
+
+    /*  Wallis' example, the cubic x^3 - 2x - 5.                              */
+    compare(
+        [](double x) { return (x*x - 2.0)*x - 5.0; }, 2.0, 3.0, "x^3 - 2x - 5"
+    );
+
+    /*  ln(10). f is large compared to the bracket, so at first the point x + *
+     *  f(x) lands far outside and the secant step is used.                   */
+    compare(
+        [](double x) { return std::exp(x) - 10.0; }, 0.0, 5.0, "exp(x) - 10"
+    );
+
+    /*  The root of atan. Plain Steffensen's method diverges when started far *
+     *  from zero, but the bracket keeps us safe.                             */
+    compare([](double x) { return std::atan(x); }, -1.0, 10.0, "atan(x)");
+
+    /*  A bracket with no sign change. The result says that it failed.        */
+    const SafeguardedSteffensen::Result bad =
+        SafeguardedSteffensen::detailed_root(
+            [](double x) { return 2.0 - x*x; }, 2.0, 3.0
+        );
+
+    std::printf("2 - x^2 on [2, 3]: %u evaluations, converged: %d\n",
+                bad.evaluations, bad.converged);
+
+    return 0;
+}
+
+/*  We can execute this on GNU, Linux, FreeBSD, macOS, etc., via:             *
+ *      c++ safeguarded_steffensens_method.cpp -o main                        *
+ *      ./main                                                                *
+ *  This will output the following:                                           *
+ *      f(x)           Bisection          evals    Safeguarded        evals   *
+ *      2 - x^2        1.4142135623730949  66    1.4142135623730949  14       *
+ *      sin(x)         3.1415926535897931  50    3.1415926535897931   5       *
+ *      cos(x) - x     0.7390851332151607  54    0.7390851332151607  10       *
+ *      x^3 - 2x - 5   2.0945514815423270  66    2.0945514815423278  18       *
+ *      exp(x) - 10    2.3025850929940459  66    2.3025850929940455  15       *
+ *      atan(x)        0.0000000000000000  57    -0.0000000000000000  10      *
+ *      2 - x^2 on [2, 3]: 2 evaluations, converged: 0                        *
+ *  The bisection method gains one bit per evaluation of f, and needs 50 to   *
+ *  66 evaluations. The safeguarded method needs 4 to 10 times fewer. The     *
+ *  last few digits of the two roots may differ, both are within a few units  *
+ *  in the last place of the true root.                                       *
+ *                                                                            *
+ *  On Windows you will need to install a C++ compiler. Microsoft's MSVC is a *
+ *  common option. Using MSVC, type:                                          *
+ *      cl /std:c++17 safeguarded_steffensens_method.cpp /link /out:main.exe  *
+ *      main.exe                                                              *
+ *  This will produce the same output.                                        */
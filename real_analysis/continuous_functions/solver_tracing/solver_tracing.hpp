@@ -0,0 +1,467 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Header-only tracing and timing of the iterations of the solvers.      *
+ *  Notes:                                                                    *
+ *      Provides SolverTrace, used by Heron's method, the bisection method,   *
+ *      Steffensen's method, and exponentiating by squaring when compiled     *
+ *      with -DSOLVER_TRACING. Every iteration may be kept in a ring buffer   *
+ *      and passed to a callback, and every call timed. Without               *
+ *      -DSOLVER_TRACING this file is not included, and the solvers compile   *
+ *      exactly as before.                                                    *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/10/11                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_SOLVER_TRACING_HPP
+#define MITX_SOLVER_TRACING_HPP
+
+/*  cstdio provides the "printf" function, used for printing text.            */
+#include <cstdio>
+
+/*  std::getenv and std::strtoul, for reading SOLVER_TRACE, are found here.   */
+#include <cstdlib>
+
+/*  std::strcmp, used to find the timer for a solver, provided here.          */
+#include <cstring>
+
+/*  std::atomic, used for the mode and the callback.                          */
+#include <atomic>
+
+/*  Timing routines, used by the timing scopes.                               */
+#include <chrono>
+
+/*  The loops of the solvers make no function calls, even while tracing. A    *
+ *  call overwrites the floating-point registers, and if there is a call      *
+ *  anywhere in a loop, even one that is never made, GCC keeps the values of  *
+ *  the loop in memory instead of in registers. This made Heron's method      *
+ *  three times slower with tracing off. An iteration is recorded with a few  *
+ *  stores, in the loop, and everything else, reading the clock, the timers,  *
+ *  and the callback, is done before or after the loop, in functions of their *
+ *  own. GCC and clang are told these are rarely called, MSVC only that they  *
+ *  should not be inlined.                                                    */
+#if defined(__GNUC__)
+#define MITX_TRACE_COLD __attribute__((noinline, cold))
+#elif defined(_MSC_VER)
+#define MITX_TRACE_COLD __declspec(noinline)
+#else
+#define MITX_TRACE_COLD
+#endif
+
+/*  The traced copies of the solvers are not inlined either, but they are not *
+ *  marked cold, since GCC then also stopped inlining the untraced solvers.   */
+#if defined(__GNUC__)
+#define MITX_TRACE_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define MITX_TRACE_NOINLINE __declspec(noinline)
+#else
+#define MITX_TRACE_NOINLINE
+#endif
+
+/*  Records what the solvers do while the program runs. There are two kinds   *
+ *  of record, and the mode says which are kept. With Iterations, each step   *
+ *  of a solver's loop gives an Entry, the iteration number, the current      *
+ *  point x_n, and the residual there, which is kept in a ring buffer holding *
+ *  the last capacity entries, and passed to the callback, if one is set.     *
+ *  With Timing, every call to a solver is timed, and the number of calls and *
+ *  the total time are kept for each solver.                                  *
+ *                                                                            *
+ *  The mode starts out as the value of the SOLVER_TRACE environment          *
+ *  variable, 0 for Off, 1 for Iterations, 2 for Timing, or 3 for both, so a  *
+ *  program built with -DSOLVER_TRACING may be traced without recompiling it. *
+ *  It may also be changed with set_mode while the program runs. Each solver  *
+ *  reads the mode once per call. While it is Off, the call runs the same     *
+ *  loop as without -DSOLVER_TRACING, and costs one load and one branch that  *
+ *  is always predicted correctly more. Otherwise the call goes to a traced   *
+ *  copy of the solver, out of line, which has the hooks and the Scope.       *
+ *                                                                            *
+ *  The ring buffer and the timers belong to the thread that did the work, so *
+ *  recording an iteration is a few plain stores, with no locks and no atomic *
+ *  instructions, and threads never write to each other's records. They are   *
+ *  read from the same thread, with size, entry, print, and print_timings.    *
+ *  The mode and the callback are shared by every thread.                     */
+class SolverTrace {
+
+    /*  We want the types visible outside the class. Declare them public.     */
+    public:
+
+        /*  Which records are kept. These are bits, and Everything is both.   */
+        enum Mode {
+            Off = 0,
+            Iterations = 1,
+            Timing = 2,
+            Everything = 3
+        };
+
+        /*  One step of a solver. solver names the routine, such as           *
+         *  "Heron::sqrt", and iteration counts from zero in every call. For  *
+         *  the root finders x is x_n and residual the error there: the       *
+         *  relative error (x - a^2) / x for Heron's method, and f(x_n) for   *
+         *  the bisection and Steffensen's methods. For exponentiating by     *
+         *  squaring, x is the part of the exponent that is left, and         *
+         *  residual is the size |w| of the running square w.                 */
+        struct Entry {
+            const char *solver;
+            unsigned int iteration;
+            double x;
+            double residual;
+        };
+
+        /*  Called with every entry, oldest first, in the thread that made    *
+         *  it. So that the loops make no calls, the entries of a call are    *
+         *  passed on when the call returns, when its Scope ends, and the     *
+         *  entries of a Scope of the caller's own when it ends. flush passes *
+         *  on the rest. The callback runs in a destructor, so it must not    *
+         *  throw.                                                            */
+        typedef void (*Callback)(const Entry &entry);
+
+        /*  The number of entries the ring buffer holds. This is a power of   *
+         *  two, so finding the slot for the next entry is a bitwise and.     */
+        static const unsigned int capacity = 256U;
+
+        /*  The number of solvers that may be timed in each thread. There are *
+         *  only four Scopes in the solvers, which leaves room for a few      *
+         *  Scopes of the caller's own.                                       */
+        static const unsigned int number_of_timers = 8U;
+
+    private:
+
+        /*  The last capacity entries of the thread. count is the number of   *
+         *  entries recorded since the last clear, and the next one goes in   *
+         *  slot count mod capacity, overwriting the oldest. The entries      *
+         *  before delivered have been passed to the callback.                */
+        struct Ring {
+            Entry entries[capacity];
+            unsigned long int count;
+            unsigned long int delivered;
+        };
+
+        /*  The calls to one solver, and the total time they took.            */
+        struct Timer {
+            const char *name;
+            unsigned long int calls;
+            double nanoseconds;
+        };
+
+        /*  The mode and the callback, shared by every thread, and the        *
+         *  records of the current thread. These are defined below.           */
+        static std::atomic<unsigned int> flags;
+        static std::atomic<Callback> callback;
+        static thread_local Ring ring;
+        static thread_local Timer timers[number_of_timers];
+
+        /*  The mode given by the SOLVER_TRACE environment variable. Anything *
+         *  that is not a number reads as 0, so tracing is off.               */
+        static unsigned int mode_from_environment(void)
+        {
+            const char *value = std::getenv("SOLVER_TRACE");
+
+            if (value == NULL)
+                return Off;
+
+            return static_cast<unsigned int>(std::strtoul(value, NULL, 10)) &
+                   static_cast<unsigned int>(Everything);
+        }
+        /*  End of mode_from_environment.                                     */
+
+        /*  The current time, for the start of a Scope.                       */
+        MITX_TRACE_COLD static std::chrono::steady_clock::time_point
+        now(void) noexcept
+        {
+            return std::chrono::steady_clock::now();
+        }
+        /*  End of now.                                                       */
+
+        /*  Adds one call that began at start to the timer for a solver,      *
+         *  starting a new timer the first time a solver is seen. The names   *
+         *  are usually the same string literal, and compared by address, but *
+         *  a literal may have a different address in each file, so strcmp    *
+         *  makes sure. If every timer is taken the call is not counted.      */
+        static void
+        add_time(const char *name, std::chrono::steady_clock::time_point start)
+        {
+            const std::chrono::steady_clock::time_point end =
+                std::chrono::steady_clock::now();
+
+            const double nanoseconds =
+                std::chrono::duration<double, std::nano>(end - start).count();
+
+            unsigned int n;
+
+            for (n = 0U; n < number_of_timers; ++n)
+            {
+                Timer &timer = timers[n];
+
+                if (timer.name == NULL)
+                    timer.name = name;
+
+                else if (timer.name != name &&
+                         std::strcmp(timer.name, name) != 0)
+                    continue;
+
+                ++timer.calls;
+                timer.nanoseconds += nanoseconds;
+                return;
+            }
+        }
+        /*  End of add_time.                                                  */
+
+        /*  Passes the entries not yet seen by the callback to it. Entries    *
+         *  that were overwritten before they could be passed on are skipped. *
+         *  Each entry is copied first, and delivered is moved on before the  *
+         *  call, since the callback may call a solver itself.                */
+        static void deliver(Callback f)
+        {
+            while (ring.delivered < ring.count)
+            {
+                if (ring.count - ring.delivered > capacity)
+                    ring.delivered = ring.count - capacity;
+
+                const Entry entry = ring.entries[ring.delivered % capacity];
+                ++ring.delivered;
+                f(entry);
+            }
+        }
+        /*  End of deliver.                                                   */
+
+        /*  The end of a Scope that was started with the given mode.          */
+        MITX_TRACE_COLD static void
+        finish(const char *name,
+               std::chrono::steady_clock::time_point start,
+               unsigned int mode) noexcept
+        {
+            if ((mode & static_cast<unsigned int>(Timing)) != 0U)
+                add_time(name, start);
+
+            flush();
+        }
+        /*  End of finish.                                                    */
+
+    /*  We want the functions visible outside the class. Declare them public. */
+    public:
+
+        /*  Changes the mode, for every thread. Calls already running in      *
+         *  other threads see the change within an iteration or two.          */
+        static void set_mode(Mode mode)
+        {
+            flags.store(static_cast<unsigned int>(mode),
+                        std::memory_order_relaxed);
+        }
+        /*  End of set_mode.                                                  */
+
+        /*  The current mode.                                                 */
+        static Mode mode(void)
+        {
+            return static_cast<Mode>(flags.load(std::memory_order_relaxed));
+        }
+        /*  End of mode.                                                      */
+
+        /*  Whether the records of the given kind are being kept.             */
+        static bool active(Mode kind)
+        {
+            return (flags.load(std::memory_order_relaxed) &
+                    static_cast<unsigned int>(kind)) != 0U;
+        }
+        /*  End of active.                                                    */
+
+        /*  Sets the function called with every entry, shared by every        *
+         *  thread. NULL, the default, calls nothing.                         */
+        static void set_callback(Callback f)
+        {
+            callback.store(f, std::memory_order_relaxed);
+        }
+        /*  End of set_callback.                                              */
+
+        /*  Records one iteration of a solver, if iterations are being kept.  *
+         *  This is the hook the solvers call inside their loops, and it is   *
+         *  only a few stores.                                                */
+        static void step(const char *solver,
+                         unsigned int iteration,
+                         double x,
+                         double residual)
+        {
+            if (!active(Iterations))
+                return;
+
+            Entry &entry = ring.entries[ring.count % capacity];
+            entry.solver = solver;
+            entry.iteration = iteration;
+            entry.x = x;
+            entry.residual = residual;
+            ++ring.count;
+        }
+        /*  End of step.                                                      */
+
+        /*  Passes the entries of this thread that the callback has not seen  *
+         *  yet to it, if there is a callback.                                */
+        static void flush(void)
+        {
+            const Callback f = callback.load(std::memory_order_relaxed);
+
+            if (f != NULL)
+                deliver(f);
+        }
+        /*  End of flush.                                                     */
+
+        /*  The number of entries recorded by this thread since the last      *
+         *  clear, including those that have since been overwritten.          */
+        static unsigned long int recorded(void)
+        {
+            return ring.count;
+        }
+        /*  End of recorded.                                                  */
+
+        /*  The number of entries still held, at most capacity.               */
+        static unsigned int size(void)
+        {
+            if (ring.count < capacity)
+                return static_cast<unsigned int>(ring.count);
+
+            return capacity;
+        }
+        /*  End of size.                                                      */
+
+        /*  The entries still held, oldest first. entry(0) is the oldest, and *
+         *  entry(size() - 1) the one recorded last.                          */
+        static const Entry &entry(unsigned int n)
+        {
+            const unsigned long int first = ring.count - size();
+            return ring.entries[(first + n) % capacity];
+        }
+        /*  End of entry.                                                     */
+
+        /*  Forgets the entries and the timers of this thread.                */
+        static void clear(void)
+        {
+            unsigned int n;
+
+            ring.count = 0UL;
+            ring.delivered = 0UL;
+
+            for (n = 0U; n < number_of_timers; ++n)
+            {
+                timers[n].name = NULL;
+                timers[n].calls = 0UL;
+                timers[n].nanoseconds = 0.0;
+            }
+        }
+        /*  End of clear.                                                     */
+
+        /*  Prints the entries still held by this thread, oldest first, one   *
+         *  per line: the solver, the iteration, x, and the residual.         */
+        static void print(void)
+        {
+            const unsigned int length = size();
+            unsigned int n;
+
+            for (n = 0U; n < length; ++n)
+            {
+                const Entry &e = entry(n);
+
+                std::printf("    %-16s %3u  %+.16E  %+.3E\n",
+                            e.solver, e.iteration, e.x, e.residual);
+            }
+        }
+        /*  End of print.                                                     */
+
+        /*  Prints the number of calls to each solver timed by this thread,   *
+         *  and the average time per call.                                    */
+        static void print_timings(void)
+        {
+            unsigned int n;
+
+            for (n = 0U; n < number_of_timers; ++n)
+            {
+                const Timer &timer = timers[n];
+
+                if (timer.name == NULL)
+                    break;
+
+                std::printf("    %-16s calls: %lu, %.2f ns/call\n",
+                            timer.name, timer.calls,
+                            timer.nanoseconds / timer.calls);
+            }
+        }
+        /*  End of print_timings.                                             */
+
+        /*  Marks one call to a solver. The traced copies of the solvers      *
+         *  create one at the start of each call. When it ends, the call is   *
+         *  added to the timer with the given name, if Timing is on, and the  *
+         *  entries of the call are passed to the callback, if Iterations is  *
+         *  on. The mode is read once, when the Scope starts, so a call is    *
+         *  timed either in full or not at all. Reading the clock twice costs *
+         *  more than a call to Heron::sqrt, about 90 ns on one machine, so   *
+         *  timing is best left off unless the times are wanted. A Scope may  *
+         *  also be used to time any other stretch of code, such as a loop of *
+         *  calls to a solver.                                                */
+        class Scope {
+
+            /*  The name of the timer, the time the scope began, if it is     *
+             *  being timed, and the mode when it began.                      */
+            const char *name;
+            std::chrono::steady_clock::time_point start;
+            unsigned int mode;
+
+            public:
+
+                /*  Starts timing, if Timing is on.                           */
+                explicit Scope(const char *label)
+                    : name(label),
+                      start(),
+                      mode(flags.load(std::memory_order_relaxed))
+                {
+                    if ((mode & static_cast<unsigned int>(Timing)) != 0U)
+                        start = now();
+                }
+                /*  End of Scope.                                             */
+
+                /*  Stops timing, and passes the entries to the callback.     */
+                ~Scope()
+                {
+                    if (mode != 0U)
+                        finish(name, start, mode);
+                }
+                /*  End of ~Scope.                                            */
+
+                /*  A scope marks one stretch of code, so it is not copied.   */
+                Scope(const Scope &) = delete;
+                Scope &operator = (const Scope &) = delete;
+        };
+        /*  End of Scope.                                                     */
+};
+/*  End of SolverTrace definition.                                            */
+
+/*  The static members need a definition. These are inline variables (C++17), *
+ *  so every file that includes this header shares the same ones. Static      *
+ *  storage starts out zero, so the ring buffers and timers begin empty. The  *
+ *  mode is read from the environment when the program starts.                */
+inline std::atomic<unsigned int>
+SolverTrace::flags(SolverTrace::mode_from_environment());
+
+inline std::atomic<SolverTrace::Callback> SolverTrace::callback(NULL);
+inline thread_local SolverTrace::Ring SolverTrace::ring;
+
+inline thread_local SolverTrace::Timer
+SolverTrace::timers[SolverTrace::number_of_timers];
+
+#endif
+/*  End of include guard.                                                     */
@@ -19,6 +19,9 @@
  ******************************************************************************
  *  Purpose:                                                                  *
  *      Calculates the root of a function using Steffensen's method.          *
+ *  Notes:                                                                    *
+ *      The solver is in steffensens_method.hpp. This file shows how to use   *
+ *      it, and benchmarks it.                                                *
  ******************************************************************************
  *  Author: Ryan Maguire                                                      *
  *  Date:   2025/05/22                                                        *
@@ -27,62 +30,16 @@
 /*  cstdio provides the "printf" function, used for printing text.            */
 #include <cstdio>
 
-/*  Floating-point absolute value function, fabs, provided here.              */
-#include <cmath>
+/*  Timing routines, used for benchmarking the two versions of root.          */
+#include <chrono>
+
+/*  Steffensen's method itself, in BasicSteffensen and Steffensen.            */
+#include "steffensens_method.hpp"
 
 /*  Function pointer notation is a little confusing. Create a typedef for it  *
  *  so we do not need to explicitly use it later.                             */
 typedef double (*function)(double);
 
-/*  Computes the root of a function using Steffensen's method.                */
-class Steffensen {
-
-    /*  Steffensen's method is iterative and converges very quickly.          *
-     *  Because of this we may exit the function after a few iterations.      */
-    static const unsigned int maximum_number_of_iterations = 16U;
-
-    /*  We want the function visible outside the class. Declare it public.    */
-    public:
-
-        /*  Computes the root of a function using Steffensen's method.        */
-        static double root(function f, double x)
-        {
-            /*  Maximum allowed error. This is 4x double precision epsilon.   */
-            const double epsilon = 8.881784197001252E-16;
-
-            /*  Variable keeping track of how many iterations we perform.     */
-            unsigned int iters;
-
-            /*  The method starts at the guess point and updates iteratively. */
-            double xn = x;
-
-            /*  Iteratively apply Steffensen's method to find the root.       */
-            for (iters = 0; iters < maximum_number_of_iterations; ++iters)
-            {
-                /*  Steffensen's method needs both f(x) and f(x + f(x)),      *
-                 *  in particular the denominator is f(x + f(x)) / f(x) - 1.  */
-                double f_xn = f(xn);
-                double g_xn = f(xn + f_xn) / f_xn - 1.0;
-
-                /*  Like Newton's method the new point is obtained by         *
-                 *  subtracting the ratio. g(x) = f(x + f(x))/f(x) - 1 acts   *
-                 *  as the derivative of f, but we do not explicitly need to  *
-                 *  calculate f'(x).                                          */
-                xn = xn - f_xn / g_xn;
-
-                /*  If f(x) is very small, we are close to a root and can     *
-                 *  break out of this for loop. Check for this.               */
-                if (std::fabs(f_xn) < epsilon)
-                    break;
-            }
-
-            /*  Like Newton's method and Heron's method, the convergence is   *
-             *  quadratic. After a few iterations we will be close a root.    */
-            return xn;
-        }
-        /*  End of root.                                                      */
-};
-
 /*  sqrt(2) is a root to the function f(x) = 2 - x^2. Provide this.           */
 static double func(double x)
 {
@@ -90,6 +47,38 @@ static double func(double x)
 }
 /*  End of func.                                                              */
 
+/*  Finds sqrt(2) many times using starting points near x = 2, and prints the *
+ *  average time per root. The same routine is used for the function pointer  *
+ *  and for the lambda.                                                       */
+template <typename Function>
+static void benchmark(Function f, const char * const name)
+{
+    /*  The number of roots to compute.                                       */
+    const unsigned int number_of_calls = 1000000U;
+
+    /*  Running sum to keep the compiler from discarding the work.            */
+    double sum = 0.0;
+
+    /*  Variable for looping over the calls.                                  */
+    unsigned int index;
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for (index = 0U; index < number_of_calls; ++index)
+        sum += Steffensen::root(f, 2.0 + 1.0E-7 * index);
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::printf("%-17s %7.2f ns/root (checksum %.6f)\n",
+                name, nanoseconds / number_of_calls, sum / number_of_calls);
+}
+/*  End of benchmark.                                                         */
+
 /*  Main routine used for testing our implementation of Steffensen's method.  */
 int main(void)
 {
@@ -101,5 +90,106 @@ int main(void)
     const double sqrt_x = Steffensen::root(func, x);
     std::printf("sqrt(%.1f) = %.16f\n", x, sqrt_x);
 
+    /*  The same computation, but done by the compiler. The function is given *
+     *  as a lambda since func is not constexpr. The static_assert proves     *
+     *  that no work is done at run time.                                     */
+    constexpr double compile_time_sqrt_x = Steffensen::constexpr_root(
+        [](double t) { return 2.0 - t*t; }, 2.0
+    );
+
+    static_assert(compile_time_sqrt_x > 1.4142 && compile_time_sqrt_x < 1.4143,
+                  "The square root of 2 should be about 1.41421");
+
+    std::printf("constexpr sqrt(%.1f) = %.16f\n", x, compile_time_sqrt_x);
+
+    /*  The function pointer is read from a volatile variable. Otherwise the  *
+     *  compiler sees which function it points to and inlines it anyway,      *
+     *  which is not what happens when the pointer is stored elsewhere.       */
+    function volatile func_pointer = func;
+
+    /*  Compare the cost of the indirect call with the inlined lambda.        */
+    benchmark(static_cast<function>(func_pointer), "Function pointer:");
+    benchmark([](double t) { return 2.0 - t*t; }, "Lambda:");
+
+    /*  The detailed result starting at x = 2, and at x = 10. The second is   *
+     *  too far away, and Steffensen's method runs out of iterations.         */
+    const Steffensen::Result detailed = Steffensen::detailed_root(func, x);
+    const Steffensen::Result far = Steffensen::detailed_root(func, 10.0);
+
+    std::printf("x0 = 2: %u iterations, %u evaluations, converged: %d\n",
+                detailed.iterations, detailed.evaluations, detailed.converged);
+
+    std::printf("x0 = 10: %u iterations, %u evaluations, converged: %d\n",
+                far.iterations, far.evaluations, far.converged);
+
+    /*  A caller that only needs 8 digits may ask for a looser tolerance,     *
+     *  either on |f| or on the size of the steps. More iterations would not  *
+     *  help the start at x = 10, Steffensen's method wanders off from there. *
+     *  The safeguarded_steffensens_method example handles this.              */
+    const Steffensen::Options loose = {1.0E-08, 16U, Steffensen::Absolute};
+    const Steffensen::Options steps = {1.0E-08, 16U, Steffensen::Relative};
+    const Steffensen::Result quick = Steffensen::detailed_root(func, x, loose);
+    const Steffensen::Result short_steps =
+        Steffensen::detailed_root(func, x, steps);
+
+    std::printf("|f| < 1E-8: %.16f, %u iterations\n",
+                quick.root, quick.iterations);
+
+    std::printf("steps < 1E-8: %.16f, %u iterations\n",
+                short_steps.root, short_steps.iterations);
+
+    /*  The class works for every type of real number. float has 24 bits of   *
+     *  precision, so it reaches its tolerance in fewer steps than double.    */
+    const BasicSteffensen<float>::Result root_float =
+        BasicSteffensen<float>::detailed_root(
+            [](float t) { return 2.0F - t*t; }, 2.0F
+        );
+
+    const BasicSteffensen<long double>::Result root_long =
+        BasicSteffensen<long double>::detailed_root(
+            [](long double t) { return 2.0L - t*t; }, 2.0L
+        );
+
+    std::printf("float:       %.8f, %u iterations\n",
+                static_cast<double>(root_float.root), root_float.iterations);
+
+    std::printf("long double: %.19Lf, %u iterations\n",
+                root_long.root, root_long.iterations);
+
+#if defined(SOLVER_STATISTICS)
+    Steffensen::print_statistics();
+#endif
+
     return 0;
 }
+
+/*  We can execute this on GNU, Linux, FreeBSD, macOS, etc., via:             *
+ *      c++ steffensens_method.cpp -o main                                    *
+ *      ./main                                                                *
+ *  This will output the following:                                           *
+ *      sqrt(2.0) = 1.4142135623730951                                        *
+ *      constexpr sqrt(2.0) = 1.4142135623730951                              *
+ *  followed by the timings for the function pointer and the lambda. These    *
+ *  depend on the machine, but the lambda is typically faster. Last is        *
+ *      x0 = 2: 7 iterations, 14 evaluations, converged: 1                    *
+ *      x0 = 10: 16 iterations, 32 evaluations, converged: 0                  *
+ *      |f| < 1E-8: 1.4142135623730949, 6 iterations                          *
+ *      steps < 1E-8: 1.4142135623730949, 6 iterations                        *
+ *      float:       1.41421354, 6 iterations                                 *
+ *      long double: 1.4142135623730950488, 7 iterations                      *
+ *  The long double line depends on the platform. With MSVC, long double is   *
+ *  the same as double.                                                       *
+ *  To count the calls and iterations, and print a histogram at the end, add  *
+ *  -DSOLVER_STATISTICS to the command.                                       *
+ *  To record every iteration, or time every call, add -DSOLVER_TRACING, and  *
+ *  run the program with SOLVER_TRACE set to 1, 2, or 3. This needs C++17,    *
+ *  see solver_tracing.cpp for the details.                                   *
+ *                                                                            *
+ *  Lambdas can only be used in constant expressions starting with C++17. Old *
+ *  compilers may need the -std=c++17 option for this.                        *
+ *                                                                            *
+ *  On Windows you will need to install a C++ compiler. Microsoft's MSVC is a *
+ *  common option. Using MSVC, type:                                          *
+ *      cl /std:c++17 steffensens_method.cpp /link /out:main.exe              *
+ *      main.exe                                                              *
+ *  This will produce the same output.                                        */
@@ -0,0 +1,536 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Header-only implementation of Steffensen's method for finding roots.  *
+ *  Notes:                                                                    *
+ *      Provides BasicSteffensen<Real> and the Steffensen typedef. Everything *
+ *      is a template, so including this file is all that is needed, and the  *
+ *      compiler can inline the function being solved into the solver's loop. *
+ *      steffensens_method.cpp shows how it is used.                          *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/30                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_STEFFENSENS_METHOD_HPP
+#define MITX_STEFFENSENS_METHOD_HPP
+
+/*  cstdio provides the "printf" function, used for printing text.            */
+#include <cstdio>
+
+/*  Floating-point absolute value function, fabs, provided here.              */
+#include <cmath>
+
+/*  std::numeric_limits, used for the precision of each type, found here.     */
+#include <limits>
+
+/*  Statistics about every call to root may optionally be kept. This is off   *
+ *  by default, since it costs a little time. Compile with                    *
+ *  -DSOLVER_STATISTICS to turn it on. The counters are atomic, so the solver *
+ *  may still be called from several threads at once.                         */
+#if defined(SOLVER_STATISTICS)
+#include <atomic>
+#endif
+
+/*  Each iteration of root may also be traced, and each call timed. This is   *
+ *  off by default, and compiles to nothing. Compile with -DSOLVER_TRACING to *
+ *  turn it on, see solver_tracing.hpp for the details.                       */
+#if defined(SOLVER_TRACING)
+#include "../solver_tracing/solver_tracing.hpp"
+#endif
+
+/*  Computes the root of a function using Steffensen's method. The class is a *
+ *  template over the type of real number, Real, which may be float, double,  *
+ *  or long double. The tolerance comes from the precision of Real.           */
+template <typename Real>
+class BasicSteffensen {
+
+    /*  Steffensen's method is iterative and converges very quickly.          *
+     *  Because of this we may exit the function after a few iterations.      */
+    static const unsigned int maximum_number_of_iterations = 16U;
+
+    /*  std::fabs is not constexpr, so it can not be used when computing      *
+     *  values at compile time. The absolute value is easy to write.          */
+    static constexpr Real absolute_value(Real x)
+    {
+        return (x < 0.0 ? -x : x);
+    }
+    /*  End of absolute_value.                                                */
+
+    /*  Adds a finished call to the statistics. Nothing is done, and the      *
+     *  compiler removes the call entirely, unless statistics are enabled.    *
+     *  Relaxed atomics are enough since the counters are only ever added to, *
+     *  and they are read once all of the work is done.                       */
+    static void record(unsigned int iterations,
+                       unsigned int evaluations,
+                       bool converged)
+    {
+#if defined(SOLVER_STATISTICS)
+
+        /*  A larger cap may be given in the Options. Such calls all go in    *
+         *  the last entry of the histogram.                                  */
+        if (iterations > maximum_number_of_iterations)
+            iterations = maximum_number_of_iterations;
+
+        statistics.histogram[iterations].fetch_add(
+            1UL, std::memory_order_relaxed
+        );
+
+        statistics.evaluations.fetch_add(
+            evaluations, std::memory_order_relaxed
+        );
+
+        if (!converged)
+            statistics.failures.fetch_add(1UL, std::memory_order_relaxed);
+#else
+        static_cast<void>(iterations);
+        static_cast<void>(evaluations);
+        static_cast<void>(converged);
+#endif
+    }
+    /*  End of record.                                                        */
+
+    /*  Passes one iteration to the tracer. As with record, nothing is done,  *
+     *  and the compiler removes the call entirely, unless tracing is         *
+     *  enabled.                                                              */
+    static void trace(unsigned int iteration, Real x, Real residual)
+    {
+#if defined(SOLVER_TRACING)
+        SolverTrace::step("Steffensen::root", iteration,
+                          static_cast<double>(x),
+                          static_cast<double>(residual));
+#else
+        static_cast<void>(iteration);
+        static_cast<void>(x);
+        static_cast<void>(residual);
+#endif
+    }
+    /*  End of trace.                                                         */
+
+    /*  We want the function visible outside the class. Declare it public.    */
+    public:
+
+        /*  Function pointer notation is a little confusing. Create a typedef *
+         *  for a pointer to a function of one Real.                          */
+        typedef Real (*pointer)(Real);
+
+        /*  Everything we know about a finished call to detailed_root.        *
+         *  iterations is the number of Steffensen steps, and evaluations the *
+         *  number of times f was called, two per step, except for a last     *
+         *  step that lands exactly on a root, where f(x_n) = 0 and f is      *
+         *  called once. converged is false if we ran out of iterations       *
+         *  before we were within the tolerance. residual is f(x_n) for the   *
+         *  last x_n that was checked. The returned root is one step beyond   *
+         *  this point, so its residual is usually much smaller still, unless *
+         *  f(x_n) was zero, in which case the root is x_n itself.            */
+        struct Result {
+            Real root;
+            unsigned int iterations;
+            unsigned int evaluations;
+            bool converged;
+            Real residual;
+        };
+
+#if defined(SOLVER_STATISTICS)
+
+        /*  Counters for every call to root and detailed_root. histogram[n]   *
+         *  is the number of calls that took n iterations, and failures the   *
+         *  number of calls that did not converge. The last entry also counts *
+         *  calls that took more, if a larger cap was given in the Options.   *
+         *  The total number of calls is the sum of the histogram. The        *
+         *  constexpr routine is not counted.                                 */
+        struct Statistics {
+            std::atomic<unsigned long int> evaluations;
+            std::atomic<unsigned long int> failures;
+            std::atomic<unsigned long int>
+                histogram[maximum_number_of_iterations + 1U];
+        };
+
+        /*  The counters themselves, shared by all threads.                   */
+        static Statistics statistics;
+
+        /*  Prints the counters to the screen.                                */
+        static void print_statistics(void)
+        {
+            unsigned long int calls = 0UL;
+            unsigned int n;
+
+            for (n = 0U; n <= maximum_number_of_iterations; ++n)
+                calls += statistics.histogram[n].load();
+
+            std::printf("Steffensen::root calls: %lu, evaluations: %lu, "
+                        "failures: %lu\n",
+                        calls, statistics.evaluations.load(),
+                        statistics.failures.load());
+
+            for (n = 0U; n <= maximum_number_of_iterations; ++n)
+                if (statistics.histogram[n].load() != 0UL)
+                    std::printf("    %2u iterations: %lu\n",
+                                n, statistics.histogram[n].load());
+        }
+        /*  End of print_statistics.                                          */
+
+#endif
+
+        /*  When to stop iterating. Absolute stops once |f(x_n)| is below the *
+         *  tolerance. Relative stops once a step changes x_n by at most      *
+         *  tolerance * |x_n|, meaning x_n has settled to about that relative *
+         *  accuracy, no matter how f is scaled.                              */
+        enum Stopping {
+            Absolute,
+            Relative
+        };
+
+        /*  Settings for Steffensen's method. Since the convergence is        *
+         *  quadratic, a caller that needs 8 digits instead of 16 usually     *
+         *  saves one step, two evaluations of f.                             */
+        struct Options {
+            Real tolerance;
+            unsigned int maximum_number_of_iterations;
+            Stopping stopping;
+        };
+
+        /*  The settings used by root when no Options are given. This is 4x   *
+         *  the precision of Real, compared against |f(x_n)|, and the usual   *
+         *  cap on the number of iterations. These are constants, so the      *
+         *  compiler folds them into the loop, and the default path costs     *
+         *  exactly what it did before there were options.                    */
+        static constexpr Options default_options(void)
+        {
+            return Options{
+                4 * std::numeric_limits<Real>::epsilon(),
+                maximum_number_of_iterations,
+                Absolute
+            };
+        }
+        /*  End of default_options.                                           */
+
+        /*  Computes the root of a function using Steffensen's method. Every  *
+         *  evaluation of f goes through the function pointer, which is an    *
+         *  indirect call that the compiler can not inline. It is kept for    *
+         *  existing callers, and simply uses the template below.             */
+        static Real root(pointer f, Real x)
+        {
+            return root<pointer>(f, x);
+        }
+        /*  End of root.                                                      */
+
+        /*  Computes the root of a function using Steffensen's method. The    *
+         *  function may be any callable object: a function pointer, a        *
+         *  lambda, or a class with an operator(). The compiler creates a     *
+         *  copy of this routine for each type, so for lambdas and functors   *
+         *  the body of f is inlined directly into the loop below.            */
+        template <typename Function>
+        static Real root(Function f, Real x)
+        {
+            return detailed_root(f, x).root;
+        }
+        /*  End of root.                                                      */
+
+        /*  Same as above, with a choice of tolerance and iteration cap.      */
+        template <typename Function>
+        static Real root(Function f, Real x, const Options &options)
+        {
+            return detailed_root(f, x, options).root;
+        }
+        /*  End of root.                                                      */
+
+        /*  Computes the root and reports how the computation went. The root  *
+         *  functions above simply return the root from this. The extra       *
+         *  fields cost nothing there, since the compiler sees that they are  *
+         *  unused and removes them.                                          */
+        template <typename Function>
+        static Result detailed_root(Function f, Real x)
+        {
+            return detailed_root(f, x, default_options());
+        }
+        /*  End of detailed_root.                                             */
+
+        /*  Same as above, with a choice of tolerance and iteration cap.      */
+        template <typename Function, bool Traced = false>
+        static Result
+        detailed_root(Function f, Real x, const Options &options)
+        {
+#if defined(SOLVER_TRACING)
+
+            /*  While tracing, the call goes to a copy of this routine with   *
+             *  Traced = true, which has the hooks, out of line, as in        *
+             *  Heron's method. The copy used while tracing is off has no     *
+             *  hooks in its loop at all, and is inlined as before.           */
+            if (!Traced && SolverTrace::mode() != SolverTrace::Off)
+                return traced_root(f, x, options);
+#endif
+
+            /*  Variables keeping track of how many iterations we perform,    *
+             *  and how many times f is evaluated.                            */
+            unsigned int iters;
+            unsigned int evaluations = 0U;
+
+            /*  The method starts at the guess point and updates iteratively. */
+            Real xn = x;
+
+            /*  The last value of f(x_n) that was computed, and the result.   */
+            Real f_xn = 0.0;
+            Result result;
+
+            /*  The 1 in the denominator, in the precision of Real.           */
+            const Real one = static_cast<Real>(1);
+
+            /*  Iteratively apply Steffensen's method to find the root.       */
+            for (iters = 0; iters < options.maximum_number_of_iterations;
+                 ++iters)
+            {
+                /*  The previous point, for the relative stopping rule.       */
+                const Real previous = xn;
+
+                /*  Steffensen's method needs both f(x) and f(x + f(x)),      *
+                 *  in particular the denominator is f(x + f(x)) / f(x) - 1.  */
+                f_xn = f(xn);
+                ++evaluations;
+
+                if (Traced)
+                    trace(iters, xn, f_xn);
+
+                /*  x_n is an exact root. Dividing by f(x_n) below would give *
+                 *  0 / 0, which is NaN, so we stop here instead. This step   *
+                 *  evaluated f only once.                                    */
+                if (f_xn == 0.0)
+                    break;
+
+                const Real g_xn = f(xn + f_xn) / f_xn - one;
+                ++evaluations;
+
+                /*  Like Newton's method the new point is obtained by         *
+                 *  subtracting the ratio. g(x) = f(x + f(x))/f(x) - 1 acts   *
+                 *  as the derivative of f, but we do not explicitly need to  *
+                 *  calculate f'(x).                                          */
+                xn = xn - f_xn / g_xn;
+
+                /*  If f(x) is very small, we are close to a root and can     *
+                 *  break out of this for loop. Check for this.               */
+                if (options.stopping == Absolute)
+                {
+                    if (std::fabs(f_xn) < options.tolerance)
+                        break;
+                }
+
+                /*  Otherwise, check how far the step moved us.               */
+                else if (std::fabs(xn - previous) <=
+                         options.tolerance * std::fabs(xn))
+                    break;
+            }
+
+            /*  Like Newton's method and Heron's method, the convergence is   *
+             *  quadratic. After a few iterations we will be close a root.    */
+            result.root = xn;
+            result.converged = (iters < options.maximum_number_of_iterations);
+
+            /*  If we broke out of the loop, the step we broke on counts.     */
+            result.iterations = (result.converged ? iters + 1U : iters);
+            result.evaluations = evaluations;
+            result.residual = f_xn;
+            record(result.iterations, result.evaluations, result.converged);
+            return result;
+        }
+        /*  End of detailed_root.                                             */
+
+#if defined(SOLVER_TRACING)
+
+    private:
+
+        /*  A traced call. This is out of line, so that the code for tracing  *
+         *  does not take up room where the routine is inlined. The options   *
+         *  are passed by value, see herons_method.hpp.                       */
+        template <typename Function>
+        MITX_TRACE_NOINLINE static Result
+        traced_root(Function f, Real x, Options options)
+        {
+            const SolverTrace::Scope scope("Steffensen::root");
+            return detailed_root<Function, true>(f, x, options);
+        }
+        /*  End of traced_root.                                               */
+
+    public:
+#endif
+
+        /*  Roots of a function that changes a little from one call to the    *
+         *  next, such as f(x; t) as t advances in steps of about the same    *
+         *  size. A Tracker remembers the last two roots, r_1 and r_2, and    *
+         *  starts Steffensen's method at 2 r_1 - r_2, the root predicted by  *
+         *  the line through them. If the root moves by about d per call,     *
+         *  this start is off by only about d^2, and Steffensen's method      *
+         *  squares the error again in its first step. For d = 10^-6 one step *
+         *  reaches the tolerance, and the one after it only confirms it.     *
+         *                                                                    *
+         *  The first call starts at the point given when the tracker was     *
+         *  created, and so does any call after one that did not converge.    *
+         *  The second call starts at the first root, since there is no line  *
+         *  yet. If a warm start does not converge, the call is repeated from *
+         *  the cold start, and the evaluations of both attempts are counted. *
+         *  Starting near the last root finds the root nearest to it, which   *
+         *  is the one being followed. A Tracker is meant to be used by one   *
+         *  thread.                                                           */
+        class Tracker {
+
+            /*  The settings for every call, the cold starting point, and the *
+             *  last two roots. history is the number of roots from calls     *
+             *  that converged in a row, up to two.                           */
+            Options options;
+            Real start;
+            Real previous;
+            Real before;
+            unsigned int history;
+
+            /*  We want the functions visible outside the class. Declare them *
+             *  public.                                                       */
+            public:
+
+                /*  Creates a tracker that starts cold at x.                  */
+                explicit Tracker(Real x,
+                                 const Options &settings = default_options())
+                    : options(settings),
+                      start(x),
+                      previous(x),
+                      before(x),
+                      history(0U)
+                {
+                    return;
+                }
+
+                /*  Computes a root of f, starting near the last root if      *
+                 *  possible, and reports how the computation went.           */
+                template <typename Function>
+                Result detailed_root(Function f)
+                {
+                    const bool warm = (history != 0U);
+                    Result result;
+
+                    if (warm)
+                    {
+                        const Real guess = (history == 1U ? previous :
+                                            2 * previous - before);
+
+                        result = BasicSteffensen::detailed_root(
+                            f, guess, options
+                        );
+                    }
+
+                    /*  Start cold, counting the evaluations of a failed warm *
+                     *  start along with those of the cold one.               */
+                    if (!warm || !result.converged)
+                    {
+                        const unsigned int wasted =
+                            (warm ? result.evaluations : 0U);
+
+                        result = BasicSteffensen::detailed_root(
+                            f, start, options
+                        );
+
+                        result.evaluations += wasted;
+                        history = 0U;
+                    }
+
+                    if (result.converged)
+                    {
+                        before = previous;
+                        previous = result.root;
+                        history = (history < 2U ? history + 1U : 2U);
+                    }
+                    else
+                        history = 0U;
+
+                    return result;
+                }
+                /*  End of detailed_root.                                     */
+
+                /*  Same as above, returning only the root.                   */
+                template <typename Function>
+                Real root(Function f)
+                {
+                    return detailed_root(f).root;
+                }
+                /*  End of root.                                              */
+
+                /*  Forgets the last roots, so the next call starts cold.     */
+                void reset(void)
+                {
+                    history = 0U;
+                }
+                /*  End of reset.                                             */
+        };
+        /*  End of Tracker definition.                                        */
+
+        /*  Computes the root of a function at compile time. The function is  *
+         *  passed as any callable object, for example a lambda, and must     *
+         *  itself be constexpr. When called with constant arguments the root *
+         *  is computed by the compiler and folded into the program. The      *
+         *  steps are identical to the root function above, including         *
+         *  stopping when f(x_n) is exactly zero, since dividing by zero is   *
+         *  not allowed in a constant expression either.                      */
+        template <typename Function>
+        static constexpr Real constexpr_root(Function f, Real x)
+        {
+            /*  Maximum allowed error, 4x the precision of Real, and the 1 in *
+             *  the denominator.                                              */
+            const Real epsilon = 4 * std::numeric_limits<Real>::epsilon();
+            const Real one = static_cast<Real>(1);
+
+            /*  Variable keeping track of how many iterations we perform.     */
+            unsigned int iters = 0U;
+
+            /*  The method starts at the guess point and updates iteratively. */
+            Real xn = x;
+
+            for (iters = 0U; iters < maximum_number_of_iterations; ++iters)
+            {
+                const Real f_xn = f(xn);
+
+                /*  x_n is an exact root, we are done.                        */
+                if (f_xn == 0.0)
+                    break;
+
+                /*  Same update as in the root function.                      */
+                const Real g_xn = f(xn + f_xn) / f_xn - one;
+                xn = xn - f_xn / g_xn;
+
+                if (absolute_value(f_xn) < epsilon)
+                    break;
+            }
+
+            return xn;
+        }
+        /*  End of constexpr_root.                                            */
+};
+/*  End of BasicSteffensen definition.                                        */
+
+/*  Most code wants double. Steffensen::root(f, x) is shorter than writing    *
+ *  BasicSteffensen<double>::root(f, x) every time.                           */
+typedef BasicSteffensen<double> Steffensen;
+
+/*  The counters are static members of the class, and need a definition.      *
+ *  Static storage starts out zero, so they all begin at zero.                */
+#if defined(SOLVER_STATISTICS)
+template <typename Real>
+typename BasicSteffensen<Real>::Statistics BasicSteffensen<Real>::statistics;
+#endif
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,218 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Follows the roots of functions that change slowly, starting each      *
+ *      solve at the last root.                                               *
+ *  Notes:                                                                    *
+ *      The Tracker classes are in herons_method.hpp, steffensens_method.hpp, *
+ *      and bisection_method.hpp. This file compares them with solving every  *
+ *      problem from scratch.                                                 *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/09/20                                                        *
+ ******************************************************************************/
+
+/*  stdio provides the "printf" function, used for printing text.             */
+#include <cstdio>
+
+/*  Floating-point cosine and absolute value, cos and fabs, provided here.    */
+#include <cmath>
+
+/*  Timing routines, used for benchmarking.                                   */
+#include <chrono>
+
+/*  std::vector, used for storing the roots.                                  */
+#include <vector>
+
+/*  The solvers, and their Tracker classes.                                   */
+#include "../bisection_method/bisection_method.hpp"
+#include "../steffensens_method/steffensens_method.hpp"
+#include "../../real_numbers/herons_method/herons_method.hpp"
+
+/*  The number of steps of the parameter, and its change per step.            */
+static const unsigned int number_of_steps = 100000U;
+static const double step = 1.0E-6;
+
+/*  Totals over every step of a run.                                          */
+struct Totals {
+    unsigned long int iterations;
+    unsigned long int evaluations;
+    unsigned long int failures;
+    double largest_difference;
+    double nanoseconds;
+};
+
+/*  Runs solve(t) for t = 1, 1 + step, 1 + 2 step, and so on, and adds up the *
+ *  iterations and evaluations of the results. The roots are then compared    *
+ *  with exact(t), a root computed from scratch. This is done afterwards, so  *
+ *  that it is not part of the time.                                          */
+template <typename Solve, typename Exact>
+static Totals run(Solve solve, Exact exact)
+{
+    Totals totals = {0UL, 0UL, 0UL, 0.0, 0.0};
+    std::vector<double> roots(number_of_steps);
+    unsigned int k;
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for (k = 0U; k < number_of_steps; ++k)
+    {
+        const auto result = solve(1.0 + step * k);
+
+        totals.iterations += result.iterations;
+        totals.evaluations += result.evaluations;
+        totals.failures += (result.converged ? 0UL : 1UL);
+        roots[k] = result.root;
+    }
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    totals.nanoseconds =
+        std::chrono::duration<double, std::nano>(end - start).count();
+
+    for (k = 0U; k < number_of_steps; ++k)
+    {
+        const double difference = std::fabs(roots[k] - exact(1.0 + step * k));
+
+        if (difference > totals.largest_difference)
+            totals.largest_difference = difference;
+    }
+
+    return totals;
+}
+/*  End of run.                                                               */
+
+/*  Prints the averages of a run.                                             */
+static void print(const char * const name, const Totals &totals)
+{
+    std::printf("    %s:\n", name);
+
+    std::printf("        %5.2f iterations, %5.2f evaluations, failures: %lu\n",
+                static_cast<double>(totals.iterations) / number_of_steps,
+                static_cast<double>(totals.evaluations) / number_of_steps,
+                totals.failures);
+
+    std::printf("        largest difference: %.1E\n",
+                totals.largest_difference);
+
+    std::printf("        %.2f ns per call\n",
+                totals.nanoseconds / number_of_steps);
+}
+/*  End of print.                                                             */
+
+/*  Main routine used for comparing the trackers with solving from scratch.   */
+int main(void)
+{
+    /*  The square root of 2 t, a value that drifts by 2 10^-6 per step. The  *
+     *  differences are measured against std::sqrt.                           */
+    const auto sqrt_exact = [](double t) { return std::sqrt(2.0 * t); };
+    Heron::Tracker heron;
+
+    std::printf("sqrt(2 t):\n");
+
+    print("Heron, input seed", run([](double t) {
+        return Heron::detailed_sqrt(2.0 * t);
+    }, sqrt_exact));
+
+    print("Heron, exponent seed", run([](double t) {
+        return Heron::detailed_sqrt(2.0 * t, Heron::ExponentSeed);
+    }, sqrt_exact));
+
+    print("Heron::Tracker", run([&](double t) {
+        return heron.detailed_sqrt(2.0 * t);
+    }, sqrt_exact));
+
+    /*  The root of f(x; t) = cos(x) - t x, near 0.739 for t = 1, which moves *
+     *  by about 3 10^-7 per step. The differences are measured against the   *
+     *  bisection method from scratch.                                        */
+    const auto f = [](double t) {
+        return [t](double x) { return std::cos(x) - t * x; };
+    };
+
+    const auto root_exact = [&](double t) {
+        return Bisection::root(f(t), 0.0, 1.0);
+    };
+
+    Steffensen::Tracker steffensen(1.0);
+    Bisection::Tracker bisection(0.0, 1.0);
+
+    std::printf("cos(x) - t x:\n");
+
+    print("Steffensen, x0 = 1", run([&](double t) {
+        return Steffensen::detailed_root(f(t), 1.0);
+    }, root_exact));
+
+    print("Steffensen::Tracker", run([&](double t) {
+        return steffensen.detailed_root(f(t));
+    }, root_exact));
+
+    print("Bisection, [0, 1]", run([&](double t) {
+        return Bisection::detailed_root(f(t), 0.0, 1.0);
+    }, root_exact));
+
+    print("Bisection::Tracker", run([&](double t) {
+        return bisection.detailed_root(f(t));
+    }, root_exact));
+
+    return 0;
+}
+
+/*  We can execute this on GNU, Linux, FreeBSD, macOS, etc., via:             *
+ *      c++ -O2 tracking_roots.cpp -o main                                    *
+ *      ./main                                                                *
+ *  This will output the following, with the time per call after every        *
+ *  method, which depends on the machine:                                     *
+ *      sqrt(2 t):                                                            *
+ *          Heron, input seed:                                                *
+ *               5.00 iterations,  6.00 evaluations, failures: 0              *
+ *              largest difference: 2.2E-16                                   *
+ *          Heron, exponent seed:                                             *
+ *               2.00 iterations,  3.00 evaluations, failures: 0              *
+ *              largest difference: 6.7E-16                                   *
+ *          Heron::Tracker:                                                   *
+ *               0.00 iterations,  1.00 evaluations, failures: 0              *
+ *              largest difference: 4.4E-16                                   *
+ *      cos(x) - t x:                                                         *
+ *          Steffensen, x0 = 1:                                               *
+ *               5.00 iterations,  9.47 evaluations, failures: 0              *
+ *              largest difference: 2.2E-16                                   *
+ *          Steffensen::Tracker:                                              *
+ *               2.00 iterations,  3.47 evaluations, failures: 0              *
+ *              largest difference: 2.2E-16                                   *
+ *          Bisection, [0, 1]:                                                *
+ *              49.53 iterations, 52.53 evaluations, failures: 0              *
+ *              largest difference: 0.0E+00                                   *
+ *          Bisection::Tracker:                                               *
+ *               8.01 iterations, 13.01 evaluations, failures: 0              *
+ *              largest difference: 3.3E-16                                   *
+ *  The trackers need far fewer evaluations. For the square root this does    *
+ *  not make them faster, since Heron::sqrt is so cheap, and every call of a  *
+ *  tracker has to wait for the root of the one before it, while the calls    *
+ *  from scratch do not depend on each other and the processor overlaps them. *
+ *  For cos(x) - t x, Steffensen::Tracker and Bisection::Tracker took 2.4 and *
+ *  10 times less time than solving from scratch on one machine.              *
+ *                                                                            *
+ *  On Windows you will need to install a C++ compiler. Microsoft's MSVC is a *
+ *  common option. Using MSVC, type:                                          *
+ *      cl /std:c++17 /O2 tracking_roots.cpp /link /out:main.exe              *
+ *      main.exe                                                              *
+ *  This will produce the same output.                                        */
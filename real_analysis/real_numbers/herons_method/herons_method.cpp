@@ -19,6 +19,9 @@
  ******************************************************************************
  *  Purpose:                                                                  *
  *      Calculates square roots using Heron's method.                         *
+ *  Notes:                                                                    *
+ *      The solver is in herons_method.hpp. This file shows how to use it,    *
+ *      and benchmarks it.                                                    *
  ******************************************************************************
  *  Author: Ryan Maguire                                                      *
  *  Date:   2025/03/08                                                        *
@@ -27,65 +30,149 @@
 /*  stdio provides the "printf" function, used for printing text.             */
 #include <cstdio>
 
-/*  Floating-point absolute value function, fabs, provided here.              */
+/*  sqrt and ldexp, used for the benchmark, are provided here.                */
 #include <cmath>
 
-/*  Class providing an implementation of sqrt using Heron's method.           */
-class Heron {
-
-    /*  Heron's method is iterative and the convergence is quadratic. This    *
-     *  means that if a_{n} has N correct decimals, then a_{n+1} will have    *
-     *  2N correct decimals. A standard 64-bit double can fit about 16        *
-     *  decimals of precision (the exact value is 2^-52 ~= 2.22x10^-16).      *
-     *  Because of this we may exit the function after a few iterations.      *
-     *                                                                        *
-     *  Note:                                                                 *
-     *      We are declaring the following integer as "unsigned" meaning      *
-     *      non-negative. The "U" after the number is the suffix for unsigned *
-     *      constants in C++. It simply means unsigned.                       */
-    static const unsigned int maximum_number_of_iterations = 16U;
-
-    /*  We want the function visible outside the class. Declare it public.    */
-    public:
-
-        /*  Computes square roots of positive real numbers via Heron's method.*
-         *  We are declaring this inside of the Heron class, so there should  *
-         *  be no naming conflict with std::sqrt, the standard square root.   */
-        static double sqrt(double x)
-        {
-            /*  Maximum allowed error. This is 4x double precision epsilon.   */
-            const double epsilon = 8.881784197001252E-16;
-
-            /*  Variable for keeping track of the number of iterations.       */
-            unsigned int iters;
-
-            /*  Set the initial guess to the input. Provided x is positive,   *
-             *  Heron's method will indeed converge.                          */
-            double approximate_root = x;
-
-            /*  Iteratively loop through and obtain better approximations.    */
-            for (iters = 0; iters < maximum_number_of_iterations; ++iters)
-            {
-                /*  If we are within epsilon of the correct value we may      *
-                 *  break out of this for-loop. Check the relative error.     */
-                const double error = (x - approximate_root*approximate_root)/x;
-
-                if (std::fabs(error) <= epsilon)
-                    break;
-
-                /*  Apply Heron's method to get a better approximation.       */
-                approximate_root = 0.5*(approximate_root + x/approximate_root);
-            }
-
-            /*  As long as x is positive and not very large, we should have a *
-             *  very good approximation for sqrt(x). Heron's method will      *
-             *  still work for very large x, but we must increase the value   *
-             *  of maximum_number_of_iterations.                              */
-            return approximate_root;
-        }
-        /*  End of sqrt.                                                      */
-};
-/*  End of Heron definition.                                                  */
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  std::uint64_t, used by the random number generator, is found here.        */
+#include <cstdint>
+
+/*  Timing routines, used for benchmarking the two initial guesses.           */
+#include <chrono>
+
+/*  std::numeric_limits, the largest double and float, is found here.         */
+#include <limits>
+
+/*  Heron's method itself, in BasicHeron and Heron.                           */
+#include "herons_method.hpp"
+
+/*  Times Heron's method over inputs spread across the entire range of        *
+ *  positive doubles, and prints the time per call together with the worst    *
+ *  relative error compared to std::sqrt, and the number of inputs for which  *
+ *  the iteration did not converge.                                           */
+static void benchmark(Heron::Seed seed, const char * const name)
+{
+    /*  The number of inputs, and the number of passes over them.             */
+    const std::size_t number_of_values = 4096;
+    const std::size_t number_of_passes = 256;
+
+    /*  The inputs, a running sum to keep the compiler from discarding the    *
+     *  work, and the worst relative error found.                             */
+    static double inputs[number_of_values];
+    double sum = 0.0;
+    double worst_error = 0.0;
+    std::size_t failures = 0;
+
+    /*  Variables for looping, and a simple linear congruential generator     *
+     *  used to pick pseudo-random mantissas.                                 */
+    std::size_t index, pass;
+    std::uint64_t state = 1U;
+
+    /*  Exponents from -1074 (the smallest subnormal) up to 1023.             */
+    for (index = 0; index < number_of_values; ++index)
+    {
+        const int exponent = -1074 + static_cast<int>(
+            (2097U * index) / number_of_values
+        );
+
+        state = state * 6364136223846793005U + 1442695040888963407U;
+        const double mantissa = 1.0 + static_cast<double>(state >> 11) *
+                                      1.1102230246251565E-16;
+
+        inputs[index] = std::ldexp(mantissa, exponent);
+    }
+
+    /*  The very top of the range, where a^2 overflows if it is not scaled.   */
+    inputs[number_of_values - 1] = std::numeric_limits<double>::max();
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for (pass = 0; pass < number_of_passes; ++pass)
+        for (index = 0; index < number_of_values; ++index)
+            sum += Heron::sqrt(inputs[index], seed);
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    /*  Compare with the standard library, which is correctly rounded.        */
+    for (index = 0; index < number_of_values; ++index)
+    {
+        const double expected = std::sqrt(inputs[index]);
+        const Heron::Result result = Heron::detailed_sqrt(inputs[index], seed);
+        const double error = std::fabs((result.root - expected) / expected);
+
+        if (!(error <= worst_error))
+            worst_error = error;
+
+        if (!result.converged)
+            ++failures;
+    }
+
+    const double calls = static_cast<double>(number_of_values) *
+                         static_cast<double>(number_of_passes);
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::printf(
+        "%-13s %7.2f ns/call, max relative error %.3E, %lu not converged "
+        "(checksum %.3E)\n", name, nanoseconds / calls, worst_error,
+        static_cast<unsigned long int>(failures), sum
+    );
+}
+/*  End of benchmark.                                                         */
+
+/*  Times the batched routine for the type Real on the values 1, 2, ..., N,   *
+ *  and prints the time per value. Also checks that the batched results match *
+ *  the scalar routine exactly.                                               */
+template <typename Real>
+static void benchmark_batch(const char * const name)
+{
+    /*  The number of inputs, and the number of passes over them.             */
+    const std::size_t number_of_values = 1024;
+    const std::size_t number_of_passes = 2048;
+
+    /*  The inputs, outputs, and a running sum to keep the compiler from      *
+     *  discarding the work.                                                  */
+    static Real inputs[number_of_values];
+    static Real outputs[number_of_values];
+    double sum = 0.0;
+
+    /*  Variables for looping, and for counting mismatches.                   */
+    std::size_t index, pass;
+    std::size_t mismatches = 0;
+
+    for (index = 0; index < number_of_values; ++index)
+        inputs[index] = static_cast<Real>(index + 1);
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for (pass = 0; pass < number_of_passes; ++pass)
+    {
+        BasicHeron<Real>::sqrt(inputs, outputs, number_of_values);
+        sum += static_cast<double>(outputs[pass % number_of_values]);
+    }
+
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    for (index = 0; index < number_of_values; ++index)
+        if (outputs[index] != BasicHeron<Real>::sqrt(inputs[index]))
+            ++mismatches;
+
+    const double values = static_cast<double>(number_of_values) *
+                          static_cast<double>(number_of_passes);
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::printf("%-13s %7.2f ns/value, %lu mismatches (checksum %.3E)\n",
+                name, nanoseconds / values,
+                static_cast<unsigned long int>(mismatches), sum);
+}
+/*  End of benchmark_batch.                                                   */
 
 /*  Main routine used for testing our implementation of Heron's method.       */
 int main(void)
@@ -99,6 +186,124 @@ int main(void)
     const double sqrt_x = Heron::sqrt(x);
     std::printf("sqrt(%.1f) = %.16f\n", x, sqrt_x);
 
+    /*  The same value, but computed by the compiler. The static_assert       *
+     *  proves that no work is done at run time.                              */
+    constexpr double compile_time_sqrt_x = Heron::constexpr_sqrt(2.0);
+    static_assert(compile_time_sqrt_x > 1.4142 && compile_time_sqrt_x < 1.4143,
+                  "constexpr_sqrt(2) should be about 1.41421");
+    std::printf("constexpr sqrt(%.1f) = %.16f\n", x, compile_time_sqrt_x);
+
+    /*  The detailed result for sqrt(2), and for 10^300. Starting at the      *
+     *  input, 16 iterations are not nearly enough for such a large number,   *
+     *  and the result says so.                                               */
+    const Heron::Result detailed = Heron::detailed_sqrt(x);
+    const Heron::Result large = Heron::detailed_sqrt(1.0E+300);
+
+    std::printf("sqrt(%.1f): %u iterations, converged: %d, residual: %.3E\n",
+                x, detailed.iterations, detailed.converged, detailed.residual);
+
+    std::printf("sqrt(1E300): %u iterations, converged: %d, residual: %.3E\n",
+                large.iterations, large.converged, large.residual);
+
+    /*  Starting at the exponent, even the largest double and float converge, *
+     *  since such large inputs are scaled down before a^2 can overflow.      */
+    const Heron::Result largest = Heron::detailed_sqrt(
+        std::numeric_limits<double>::max(), Heron::ExponentSeed
+    );
+
+    const BasicHeron<float>::Result largest_float =
+        BasicHeron<float>::detailed_sqrt(
+            std::numeric_limits<float>::max(), BasicHeron<float>::ExponentSeed
+        );
+
+    std::printf("sqrt(DBL_MAX): %.16E, %u iterations, converged: %d\n",
+                largest.root, largest.iterations, largest.converged);
+
+    std::printf("sqrt(FLT_MAX): %.8E, %u iterations, converged: %d\n",
+                static_cast<double>(largest_float.root),
+                largest_float.iterations, largest_float.converged);
+
+    /*  Callers that only need 8 digits may say so, and save iterations.      *
+     *  Starting at the input, 10^300 needs about 500 iterations, since each  *
+     *  one roughly halves the guess until it gets close. Raising the cap     *
+     *  lets it finish.                                                       */
+    const Heron::Options loose = {1.0E-08, 16U, Heron::Relative};
+    const Heron::Options patient = {
+        8.881784197001252E-16, 600U, Heron::Relative
+    };
+
+    const Heron::Result quick =
+        Heron::detailed_sqrt(x, Heron::InputSeed, loose);
+
+    const Heron::Result slow =
+        Heron::detailed_sqrt(1.0E+300, Heron::InputSeed, patient);
+
+    std::printf("sqrt(%.1f) to 1E-8:  %.16f, %u iterations\n",
+                x, quick.root, quick.iterations);
+
+    std::printf("sqrt(1E300), cap 600: %.16E, %u iterations\n",
+                slow.root, slow.iterations);
+
+    /*  Test the batched routine on the values 1, 2, ..., N, and a few extra  *
+     *  values that do not fill a whole vector.                               */
+    const std::size_t number_of_values = 1003;
+    double inputs[number_of_values];
+    double outputs[number_of_values];
+
+    /*  Variables for looping over the arrays and counting mismatches.        */
+    std::size_t index;
+    std::size_t mismatches = 0;
+
+    for (index = 0; index < number_of_values; ++index)
+        inputs[index] = static_cast<double>(index + 1);
+
+    Heron::sqrt(inputs, outputs, number_of_values);
+
+    /*  Compare against the scalar routine, element-by-element.               */
+    for (index = 0; index < number_of_values; ++index)
+        if (outputs[index] != Heron::sqrt(inputs[index]))
+            ++mismatches;
+
+    std::printf("Batched mismatches: %lu of %lu\n",
+                static_cast<unsigned long int>(mismatches),
+                static_cast<unsigned long int>(number_of_values));
+
+    /*  The same routine works for float and long double. The tolerance is    *
+     *  set by the precision of the type, so starting at the exponent seed    *
+     *  float needs one iteration, double two, and long double three.         */
+    const BasicHeron<float>::Result single = BasicHeron<float>::detailed_sqrt(
+        2.0F, BasicHeron<float>::ExponentSeed
+    );
+
+    const Heron::Result twice = Heron::detailed_sqrt(x, Heron::ExponentSeed);
+
+    const BasicHeron<long double>::Result extended =
+        BasicHeron<long double>::detailed_sqrt(
+            2.0L, BasicHeron<long double>::ExponentSeed
+        );
+
+    std::printf("float:       %.8f, %u iterations\n",
+                static_cast<double>(single.root), single.iterations);
+
+    std::printf("double:      %.16f, %u iterations\n",
+                twice.root, twice.iterations);
+
+    std::printf("long double: %.19Lf, %u iterations\n",
+                extended.root, extended.iterations);
+
+    /*  Twice as many floats fit in a vector register, and float converges    *
+     *  sooner, so the batched routine is much faster for float.              */
+    benchmark_batch<float>("Batch float:");
+    benchmark_batch<double>("Batch double:");
+
+    /*  Compare the two initial guesses across the full range of doubles.     */
+    benchmark(Heron::InputSeed, "InputSeed:");
+    benchmark(Heron::ExponentSeed, "ExponentSeed:");
+
+#if defined(SOLVER_STATISTICS)
+    Heron::print_statistics();
+#endif
+
     return 0;
 }
 
@@ -107,7 +312,46 @@ int main(void)
  *      ./main                                                                *
  *  This will output the following:                                           *
  *      sqrt(2.0) = 1.4142135623730949                                        *
- *  This has a relative error of 1.570092458683775E-16.                       *
+ *      constexpr sqrt(2.0) = 1.4142135623730949                              *
+ *      sqrt(2.0): 5 iterations, converged: 1, residual: 2.220E-16            *
+ *      sqrt(1E300): 16 iterations, converged: 0, residual: -INF              *
+ *      sqrt(DBL_MAX): 1.3407807929942597E+154, 2 iterations, converged: 1    *
+ *      sqrt(FLT_MAX): 1.84467441E+19, 1 iterations, converged: 1             *
+ *      sqrt(2.0) to 1E-8:  1.4142135623746899, 4 iterations                  *
+ *      sqrt(1E300), cap 600: 9.9999999999999998E+149, 503 iterations         *
+ *      Batched mismatches: 0 of 1003                                         *
+ *      float:       1.41421354, 1 iterations                                 *
+ *      double:      1.4142135623730949, 2 iterations                         *
+ *      long double: 1.4142135623730950488, 3 iterations                      *
+ *  The double result has a relative error of 1.570092458683775E-16.          *
+ *                                                                            *
+ *  The long double line depends on the platform. MSVC uses 64-bit long       *
+ *  double and prints the double result, x86 compilers usually use the        *
+ *  80-bit extended format shown above.                                       *
+ *                                                                            *
+ *  It then prints the benchmark. The timings depend on the machine, but the  *
+ *  errors should look like:                                                  *
+ *      InputSeed:    ... max relative error 6.865E+156, 4012 not converged   *
+ *      ExponentSeed: ... max relative error 2.447E-16, 0 not converged       *
+ *  and the batched routine reports 0 mismatches for both float and double.   *
+ *  Starting at x only converges for moderately sized inputs, the exponent    *
+ *  seed converges everywhere, and is several times faster.                   *
+ *                                                                            *
+ *  To enable the vector instructions for the batched routine, tell the       *
+ *  compiler what hardware to target. For example:                            *
+ *      c++ -O2 -march=native -ffp-contract=off herons_method.cpp -o main     *
+ *  A vector register holds twice as many floats as doubles, so the float     *
+ *  batch is roughly twice as fast (often more, since float division is       *
+ *  cheaper too).                                                             *
+ *                                                                            *
+ *  To count the calls and iterations, and print a histogram at the end, add  *
+ *  -DSOLVER_STATISTICS to the command.                                       *
+ *  To record every iteration, or time every call, add -DSOLVER_TRACING, and  *
+ *  run the program with SOLVER_TRACE set to 1, 2, or 3. This needs C++17,    *
+ *  see solver_tracing.cpp for the details.                                   *
+ *                                                                            *
+ *  The constexpr routine needs C++14 or later. Old compilers may need the    *
+ *  -std=c++14 option for this.                                               *
  *                                                                            *
  *  On Windows you will need to install a C++ compiler. Microsoft's MSVC is a *
  *  common option. Using MSVC, type:                                          *
@@ -0,0 +1,1335 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of mitx_mathematics_programming_examples.               *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is free software: you can           *
+ *  redistribute it and/or modify it under the terms of the GNU General       *
+ *  Public License as published by the Free Software Foundation, either       *
+ *  version 3 of the License, or (at your option) any later version.          *
+ *                                                                            *
+ *  mitx_mathematics_programming_examples is distributed in the hope that     *
+ *  it will be useful but WITHOUT ANY WARRANTY; without even the implied      *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.          *
+ *  See the GNU General Public License for more details.                      *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with mitx_mathematics_programming_examples. If not, see             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Header-only implementation of Heron's method for square roots.        *
+ *  Notes:                                                                    *
+ *      Provides BasicHeron<Real> and the Heron typedef. Everything is a      *
+ *      template, so including this file is all that is needed, and the       *
+ *      compiler can inline calls to Heron::sqrt into the caller's loops.     *
+ *      herons_method.cpp shows how it is used.                               *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2025/08/30                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef MITX_HERONS_METHOD_HPP
+#define MITX_HERONS_METHOD_HPP
+
+/*  stdio provides the "printf" function, used for printing text.             */
+#include <cstdio>
+
+/*  Floating-point absolute value function, fabs, provided here.              */
+#include <cmath>
+
+/*  The std::size_t data type, used for indexing arrays, is found here.       */
+#include <cstddef>
+
+/*  Fixed-width integers, std::uint64_t, provided here. We use these to look  *
+ *  at the bits of a double.                                                  */
+#include <cstdint>
+
+/*  std::memcpy, used to safely copy the bits of a double to an integer.      */
+#include <cstring>
+
+/*  std::numeric_limits, used for a compile-time NaN, provided here.          */
+#include <limits>
+
+/*  Statistics about every call to sqrt may optionally be kept. This is off   *
+ *  by default, since it costs a little time. Compile with                    *
+ *  -DSOLVER_STATISTICS to turn it on. The counters are atomic, so the solver *
+ *  may still be called from several threads at once.                         */
+#if defined(SOLVER_STATISTICS)
+#include <atomic>
+#endif
+
+/*  Each iteration of sqrt may also be traced, and each call timed. This is   *
+ *  off by default, and compiles to nothing. Compile with -DSOLVER_TRACING to *
+ *  turn it on, see solver_tracing.hpp for the details.                       */
+#if defined(SOLVER_TRACING)
+#include "../../continuous_functions/solver_tracing/solver_tracing.hpp"
+#endif
+
+/*  Vector intrinsics. These allow us to run Heron's method on several inputs *
+ *  at once. We pick the widest instruction set the compiler is targeting,    *
+ *  and fall back to the plain scalar loop if none is available.              */
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/*  Class providing an implementation of sqrt using Heron's method. The class *
+ *  is a template over the type of real number, Real, which may be float,     *
+ *  double, or long double. The tolerance comes from the precision of Real,   *
+ *  so float stops after fewer iterations than double does, and twice as many *
+ *  floats fit in a vector register for the batched routine.                  */
+template <typename Real>
+class BasicHeron {
+
+    /*  Heron's method is iterative and the convergence is quadratic. This    *
+     *  means that if a_{n} has N correct decimals, then a_{n+1} will have    *
+     *  2N correct decimals. A standard 64-bit double can fit about 16        *
+     *  decimals of precision (the exact value is 2^-52 ~= 2.22x10^-16).      *
+     *  Because of this we may exit the function after a few iterations.      *
+     *                                                                        *
+     *  Note:                                                                 *
+     *      We are declaring the following integer as "unsigned" meaning      *
+     *      non-negative. The "U" after the number is the suffix for unsigned *
+     *      constants in C++. It simply means unsigned.                       */
+    static const unsigned int maximum_number_of_iterations = 16U;
+
+    /*  The batched routine below works on "lanes." Each lane of a vector     *
+     *  register holds one input and runs the exact same arithmetic as the    *
+     *  scalar sqrt function. The only difference is the early exit. The      *
+     *  scalar loop breaks when the error is small, but the lanes of a vector *
+     *  can not break individually. Instead, we keep a mask of the lanes that *
+     *  have not yet converged, and only update those. A lane that has        *
+     *  converged is frozen, which is the same as it having broken out of the *
+     *  for-loop. The vector loop itself stops once every lane is frozen, or  *
+     *  after maximum_number_of_iterations, whichever comes first. Lanes      *
+     *  above largest / 4 are scaled down by 2^-54 first (2^-26 for float),   *
+     *  and their roots up by 2^27 (2^13), exactly as in detailed_sqrt, so    *
+     *  that the square in the error check does not overflow.                 */
+#if defined(__AVX512F__)
+
+    /*  Number of doubles that fit in a 512-bit register.                     */
+    static const std::size_t double_lanes = 8;
+
+    /*  Number of floats that fit in a 512-bit register.                      */
+    static const std::size_t float_lanes = 16;
+
+    /*  Runs Heron's method on 8 values at once using AVX-512.                */
+    static void sqrt_lanes(const double * const in, double * const out)
+    {
+        /*  Same tolerance as the scalar routine, one copy per lane.          */
+        const __m512d epsilon = _mm512_set1_pd(8.881784197001252E-16);
+        const __m512d half = _mm512_set1_pd(0.5);
+
+        /*  The inputs, and the lanes that are scaled, largest / 4 < x <=     *
+         *  largest. NaN and infinity compare false and are left alone.       */
+        const __m512d input = _mm512_loadu_pd(in);
+        const __mmask8 large = _mm512_cmp_pd_mask(
+            input, _mm512_set1_pd(0.25 * std::numeric_limits<double>::max()),
+            _CMP_GT_OQ
+        ) & _mm512_cmp_pd_mask(
+            input, _mm512_set1_pd(std::numeric_limits<double>::max()),
+            _CMP_LE_OQ
+        );
+
+        /*  The scaled inputs, and the initial guesses, which are the inputs. */
+        const __m512d x = _mm512_mask_mul_pd(
+            input, large, input, _mm512_set1_pd(5.551115123125783E-17)
+        );
+
+        __m512d approximate_root = x;
+
+        /*  Bit-mask of the lanes that are still iterating. All 8 to start.   */
+        __mmask8 active = 0xFF;
+
+        /*  Variable for keeping track of the number of iterations.           */
+        unsigned int iters;
+
+        for (iters = 0; iters < maximum_number_of_iterations; ++iters)
+        {
+            /*  Relative error, computed exactly as in the scalar loop. The   *
+             *  multiply and subtract are kept separate (no fused             *
+             *  multiply-add) so that the rounding matches.                   */
+            const __m512d square = _mm512_mul_pd(approximate_root,
+                                                 approximate_root);
+            const __m512d difference = _mm512_sub_pd(x, square);
+            const __m512d error = _mm512_div_pd(difference, x);
+
+            /*  Lanes with |error| <= epsilon are done. Remove them from the  *
+             *  mask. NaN compares false, so NaN lanes keep going, just like  *
+             *  the scalar code.                                              */
+            active &= ~_mm512_cmp_pd_mask(
+                _mm512_abs_pd(error), epsilon, _CMP_LE_OQ
+            );
+
+            /*  Every lane has converged, we may break out of the loop.       */
+            if (active == 0)
+                break;
+
+            /*  Heron's update, written back only to the active lanes.        */
+            approximate_root = _mm512_mask_mul_pd(
+                approximate_root, active, half,
+                _mm512_add_pd(approximate_root,
+                              _mm512_div_pd(x, approximate_root))
+            );
+        }
+
+        /*  Undo the scaling of the large lanes.                              */
+        approximate_root = _mm512_mask_mul_pd(
+            approximate_root, large, approximate_root,
+            _mm512_set1_pd(134217728.0)
+        );
+
+        _mm512_storeu_pd(out, approximate_root);
+    }
+    /*  End of sqrt_lanes.                                                    */
+
+    /*  The same, for 16 floats at once. The tolerance is 4x single precision *
+     *  epsilon, matching the scalar routine for float.                       */
+    static void sqrt_lanes(const float * const in, float * const out)
+    {
+        const __m512 epsilon = _mm512_set1_ps(4.76837158203125E-07F);
+        const __m512 half = _mm512_set1_ps(0.5F);
+        const __m512 input = _mm512_loadu_ps(in);
+        const __mmask16 large = _mm512_cmp_ps_mask(
+            input, _mm512_set1_ps(0.25F * std::numeric_limits<float>::max()),
+            _CMP_GT_OQ
+        ) & _mm512_cmp_ps_mask(
+            input, _mm512_set1_ps(std::numeric_limits<float>::max()),
+            _CMP_LE_OQ
+        );
+        const __m512 x = _mm512_mask_mul_ps(
+            input, large, input, _mm512_set1_ps(1.4901161193847656E-08F)
+        );
+        __m512 approximate_root = x;
+        __mmask16 active = 0xFFFF;
+        unsigned int iters;
+
+        for (iters = 0; iters < maximum_number_of_iterations; ++iters)
+        {
+            const __m512 square = _mm512_mul_ps(approximate_root,
+                                                approximate_root);
+            const __m512 difference = _mm512_sub_ps(x, square);
+            const __m512 error = _mm512_div_ps(difference, x);
+
+            active &= ~_mm512_cmp_ps_mask(
+                _mm512_abs_ps(error), epsilon, _CMP_LE_OQ
+            );
+
+            if (active == 0)
+                break;
+
+            approximate_root = _mm512_mask_mul_ps(
+                approximate_root, active, half,
+                _mm512_add_ps(approximate_root,
+                              _mm512_div_ps(x, approximate_root))
+            );
+        }
+
+        approximate_root = _mm512_mask_mul_ps(
+            approximate_root, large, approximate_root, _mm512_set1_ps(8192.0F)
+        );
+
+        _mm512_storeu_ps(out, approximate_root);
+    }
+    /*  End of sqrt_lanes.                                                    */
+
+#elif defined(__AVX__)
+
+    /*  Number of doubles that fit in a 256-bit register.                     */
+    static const std::size_t double_lanes = 4;
+
+    /*  Number of floats that fit in a 256-bit register.                      */
+    static const std::size_t float_lanes = 8;
+
+    /*  Runs Heron's method on 4 values at once using AVX / AVX2.             */
+    static void sqrt_lanes(const double * const in, double * const out)
+    {
+        /*  Same tolerance as the scalar routine, one copy per lane.          */
+        const __m256d epsilon = _mm256_set1_pd(8.881784197001252E-16);
+        const __m256d half = _mm256_set1_pd(0.5);
+
+        /*  AVX has no absolute value instruction. Clearing the sign bit,     *
+         *  which is the same as and-not'ing with -0.0, does the job.         */
+        const __m256d sign_bit = _mm256_set1_pd(-0.0);
+
+        /*  The inputs, and the lanes that are scaled, largest / 4 < x <=     *
+         *  largest. NaN and infinity compare false and are left alone.       */
+        const __m256d input = _mm256_loadu_pd(in);
+        const __m256d large = _mm256_and_pd(
+            _mm256_cmp_pd(
+                input,
+                _mm256_set1_pd(0.25 * std::numeric_limits<double>::max()),
+                _CMP_GT_OQ
+            ),
+            _mm256_cmp_pd(
+                input, _mm256_set1_pd(std::numeric_limits<double>::max()),
+                _CMP_LE_OQ
+            )
+        );
+
+        /*  The scaled inputs, and the initial guesses, which are the inputs. */
+        const __m256d x = _mm256_blendv_pd(
+            input,
+            _mm256_mul_pd(input, _mm256_set1_pd(5.551115123125783E-17)),
+            large
+        );
+
+        __m256d approximate_root = x;
+
+        /*  Lanes still iterating. All bits set means the lane is active.     */
+        __m256d active = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+        /*  Variable for keeping track of the number of iterations.           */
+        unsigned int iters;
+
+        for (iters = 0; iters < maximum_number_of_iterations; ++iters)
+        {
+            /*  Relative error, computed exactly as in the scalar loop.       */
+            const __m256d square = _mm256_mul_pd(approximate_root,
+                                                 approximate_root);
+            const __m256d difference = _mm256_sub_pd(x, square);
+            const __m256d error = _mm256_div_pd(difference, x);
+            const __m256d abs_error = _mm256_andnot_pd(sign_bit, error);
+
+            /*  Lanes with |error| <= epsilon are done. NaN compares false so *
+             *  NaN lanes keep going, just like the scalar code.              */
+            const __m256d done = _mm256_cmp_pd(abs_error, epsilon, _CMP_LE_OQ);
+            active = _mm256_andnot_pd(done, active);
+
+            /*  Every lane has converged, we may break out of the loop.       */
+            if (_mm256_movemask_pd(active) == 0)
+                break;
+
+            /*  Heron's update, written back only to the active lanes.        */
+            approximate_root = _mm256_blendv_pd(
+                approximate_root,
+                _mm256_mul_pd(
+                    half,
+                    _mm256_add_pd(approximate_root,
+                                  _mm256_div_pd(x, approximate_root))
+                ),
+                active
+            );
+        }
+
+        /*  Undo the scaling of the large lanes.                              */
+        approximate_root = _mm256_blendv_pd(
+            approximate_root,
+            _mm256_mul_pd(approximate_root, _mm256_set1_pd(134217728.0)),
+            large
+        );
+
+        _mm256_storeu_pd(out, approximate_root);
+    }
+    /*  End of sqrt_lanes.                                                    */
+
+    /*  The same, for 8 floats at once. The tolerance is 4x single precision  *
+     *  epsilon, matching the scalar routine for float.                       */
+    static void sqrt_lanes(const float * const in, float * const out)
+    {
+        const __m256 epsilon = _mm256_set1_ps(4.76837158203125E-07F);
+        const __m256 half = _mm256_set1_ps(0.5F);
+        const __m256 sign_bit = _mm256_set1_ps(-0.0F);
+        const __m256 input = _mm256_loadu_ps(in);
+        const __m256 large = _mm256_and_ps(
+            _mm256_cmp_ps(
+                input,
+                _mm256_set1_ps(0.25F * std::numeric_limits<float>::max()),
+                _CMP_GT_OQ
+            ),
+            _mm256_cmp_ps(
+                input, _mm256_set1_ps(std::numeric_limits<float>::max()),
+                _CMP_LE_OQ
+            )
+        );
+        const __m256 x = _mm256_blendv_ps(
+            input,
+            _mm256_mul_ps(input, _mm256_set1_ps(1.4901161193847656E-08F)),
+            large
+        );
+        __m256 approximate_root = x;
+        __m256 active = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        unsigned int iters;
+
+        for (iters = 0; iters < maximum_number_of_iterations; ++iters)
+        {
+            const __m256 square = _mm256_mul_ps(approximate_root,
+                                                approximate_root);
+            const __m256 difference = _mm256_sub_ps(x, square);
+            const __m256 error = _mm256_div_ps(difference, x);
+            const __m256 abs_error = _mm256_andnot_ps(sign_bit, error);
+            const __m256 done = _mm256_cmp_ps(abs_error, epsilon, _CMP_LE_OQ);
+            active = _mm256_andnot_ps(done, active);
+
+            if (_mm256_movemask_ps(active) == 0)
+                break;
+
+            approximate_root = _mm256_blendv_ps(
+                approximate_root,
+                _mm256_mul_ps(
+                    half,
+                    _mm256_add_ps(approximate_root,
+                                  _mm256_div_ps(x, approximate_root))
+                ),
+                active
+            );
+        }
+
+        approximate_root = _mm256_blendv_ps(
+            approximate_root,
+            _mm256_mul_ps(approximate_root, _mm256_set1_ps(8192.0F)),
+            large
+        );
+
+        _mm256_storeu_ps(out, approximate_root);
+    }
+    /*  End of sqrt_lanes.                                                    */
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+    /*  Number of doubles that fit in a 128-bit NEON register.                */
+    static const std::size_t double_lanes = 2;
+
+    /*  Number of floats that fit in a 128-bit NEON register.                 */
+    static const std::size_t float_lanes = 4;
+
+    /*  Runs Heron's method on 2 values at once using NEON.                   */
+    static void sqrt_lanes(const double * const in, double * const out)
+    {
+        /*  Same tolerance as the scalar routine, one copy per lane.          */
+        const float64x2_t epsilon = vdupq_n_f64(8.881784197001252E-16);
+        const float64x2_t half = vdupq_n_f64(0.5);
+
+        /*  The inputs, and the lanes that are scaled, largest / 4 < x <=     *
+         *  largest. NaN and infinity compare false and are left alone.       */
+        const float64x2_t input = vld1q_f64(in);
+        const uint64x2_t large = vandq_u64(
+            vcgtq_f64(
+                input, vdupq_n_f64(0.25 * std::numeric_limits<double>::max())
+            ),
+            vcleq_f64(input, vdupq_n_f64(std::numeric_limits<double>::max()))
+        );
+
+        /*  The scaled inputs, and the initial guesses, which are the inputs. */
+        const float64x2_t x = vbslq_f64(
+            large, vmulq_f64(input, vdupq_n_f64(5.551115123125783E-17)), input
+        );
+
+        float64x2_t approximate_root = x;
+
+        /*  Lanes still iterating. All bits set means the lane is active.     */
+        uint64x2_t active = vdupq_n_u64(~0ULL);
+
+        /*  Variable for keeping track of the number of iterations.           */
+        unsigned int iters;
+
+        for (iters = 0; iters < maximum_number_of_iterations; ++iters)
+        {
+            /*  Relative error, computed exactly as in the scalar loop.       */
+            const float64x2_t square = vmulq_f64(approximate_root,
+                                                 approximate_root);
+            const float64x2_t difference = vsubq_f64(x, square);
+            const float64x2_t error = vdivq_f64(difference, x);
+
+            /*  Lanes with |error| <= epsilon are done. NaN compares false so *
+             *  NaN lanes keep going, just like the scalar code.              */
+            active = vbicq_u64(active, vcleq_f64(vabsq_f64(error), epsilon));
+
+            /*  Every lane has converged, we may break out of the loop.       */
+            if ((vgetq_lane_u64(active, 0) | vgetq_lane_u64(active, 1)) == 0)
+                break;
+
+            /*  Heron's update, written back only to the active lanes.        */
+            approximate_root = vbslq_f64(
+                active,
+                vmulq_f64(
+                    half,
+                    vaddq_f64(approximate_root,
+                              vdivq_f64(x, approximate_root))
+                ),
+                approximate_root
+            );
+        }
+
+        /*  Undo the scaling of the large lanes.                              */
+        approximate_root = vbslq_f64(
+            large,
+            vmulq_f64(approximate_root, vdupq_n_f64(134217728.0)),
+            approximate_root
+        );
+
+        vst1q_f64(out, approximate_root);
+    }
+    /*  End of sqrt_lanes.                                                    */
+
+    /*  The same, for 4 floats at once. The tolerance is 4x single precision  *
+     *  epsilon, matching the scalar routine for float.                       */
+    static void sqrt_lanes(const float * const in, float * const out)
+    {
+        const float32x4_t epsilon = vdupq_n_f32(4.76837158203125E-07F);
+        const float32x4_t half = vdupq_n_f32(0.5F);
+        const float32x4_t input = vld1q_f32(in);
+        const uint32x4_t large = vandq_u32(
+            vcgtq_f32(
+                input, vdupq_n_f32(0.25F * std::numeric_limits<float>::max())
+            ),
+            vcleq_f32(input, vdupq_n_f32(std::numeric_limits<float>::max()))
+        );
+        const float32x4_t x = vbslq_f32(
+            large, vmulq_f32(input, vdupq_n_f32(1.4901161193847656E-08F)),
+            input
+        );
+        float32x4_t approximate_root = x;
+        uint32x4_t active = vdupq_n_u32(~0U);
+        unsigned int iters;
+
+        for (iters = 0; iters < maximum_number_of_iterations; ++iters)
+        {
+            const float32x4_t square = vmulq_f32(approximate_root,
+                                                 approximate_root);
+            const float32x4_t difference = vsubq_f32(x, square);
+            const float32x4_t error = vdivq_f32(difference, x);
+
+            active = vbicq_u32(active, vcleq_f32(vabsq_f32(error), epsilon));
+
+            if (vmaxvq_u32(active) == 0)
+                break;
+
+            approximate_root = vbslq_f32(
+                active,
+                vmulq_f32(
+                    half,
+                    vaddq_f32(approximate_root,
+                              vdivq_f32(x, approximate_root))
+                ),
+                approximate_root
+            );
+        }
+
+        approximate_root = vbslq_f32(
+            large,
+            vmulq_f32(approximate_root, vdupq_n_f32(8192.0F)),
+            approximate_root
+        );
+
+        vst1q_f32(out, approximate_root);
+    }
+    /*  End of sqrt_lanes.                                                    */
+
+#else
+
+    /*  No vector instructions available, the batch loop is purely scalar.    */
+    static const std::size_t double_lanes = 0;
+    static const std::size_t float_lanes = 0;
+
+#endif
+
+    /*  Runs the vector routine on as many full vectors of in as possible,    *
+     *  and returns the number of values that were handled. The rest is left  *
+     *  for the scalar routine. There are versions for double and for float.  *
+     *  Other types, like long double, have no vector instructions, and the   *
+     *  template below simply returns zero.                                   */
+    static std::size_t
+    vector_sqrt(const double * const in, double * const out, std::size_t n)
+    {
+        std::size_t index = 0;
+
+#if defined(__AVX512F__) || defined(__AVX__) || \
+    (defined(__ARM_NEON) && defined(__aarch64__))
+
+        const std::size_t end = n - n % double_lanes;
+
+        for (; index < end; index += double_lanes)
+            sqrt_lanes(in + index, out + index);
+
+#else
+        static_cast<void>(in);
+        static_cast<void>(out);
+        static_cast<void>(n);
+#endif
+
+        return index;
+    }
+    /*  End of vector_sqrt.                                                   */
+
+    /*  The same for float, with twice as many values per vector.             */
+    static std::size_t
+    vector_sqrt(const float * const in, float * const out, std::size_t n)
+    {
+        std::size_t index = 0;
+
+#if defined(__AVX512F__) || defined(__AVX__) || \
+    (defined(__ARM_NEON) && defined(__aarch64__))
+
+        const std::size_t end = n - n % float_lanes;
+
+        for (; index < end; index += float_lanes)
+            sqrt_lanes(in + index, out + index);
+
+#else
+        static_cast<void>(in);
+        static_cast<void>(out);
+        static_cast<void>(n);
+#endif
+
+        return index;
+    }
+    /*  End of vector_sqrt.                                                   */
+
+    /*  Every other type is handled entirely by the scalar routine.           */
+    template <typename Other>
+    static std::size_t vector_sqrt(const Other *, Other *, std::size_t)
+    {
+        return 0;
+    }
+    /*  End of vector_sqrt.                                                   */
+
+    /*  Computes an initial guess for sqrt(x) from the bits of x. A positive  *
+     *  normal double is stored as x = m * 2^e with 1 <= m < 2. If e = 2k is  *
+     *  even, sqrt(x) = sqrt(m) * 2^k, and if e = 2k + 1 is odd we have       *
+     *  sqrt(x) = sqrt(2) * sqrt(m) * 2^k. So we only need sqrt on [1, 2),    *
+     *  which we approximate with a cubic polynomial. The exponent is simply  *
+     *  halved. The relative error of the guess is below 7x10^-5, so two      *
+     *  iterations of Heron's method give full double precision.              */
+    static double exponent_seed(double x)
+    {
+        /*  Minimax coefficients for sqrt(m), 1 <= m < 2, relative error.     */
+        const double a0 = 3.6995638959508337E-01;
+        const double a1 = 7.8792323343276450E-01;
+        const double a2 = -1.8274763507828742E-01;
+        const double a3 = 2.4937426664236362E-02;
+
+        /*  sqrt(2), used for odd exponents.                                  */
+        const double sqrt_two = 1.4142135623730951E+00;
+
+        /*  Variables for the bits of x, and the exponent and mantissa.       */
+        std::uint64_t bits;
+        double mantissa, scale, guess;
+        int exponent, parity;
+
+        /*  Copying the bytes is the portable way to get at the bits.         */
+        std::memcpy(&bits, &x, sizeof(bits));
+
+        /*  The upper bit is the sign. The next 11 are the biased exponent.   */
+        exponent = static_cast<int>((bits >> 52) & 0x7FFU);
+
+        /*  Negative numbers, infinity, and NaN. There is no sensible guess,  *
+         *  keep the old behavior and start at the input.                     */
+        if ((bits >> 63) != 0U || exponent == 0x7FF)
+            return x;
+
+        /*  Zero and subnormal numbers have a zero exponent field. The sqrt   *
+         *  routine scales subnormals up before calling this function, so     *
+         *  only zero gets here. Start at the input.                          */
+        if (exponent == 0)
+            return x;
+
+        /*  Remove the bias of 1023 and split e = 2k + parity.                */
+        exponent -= 1023;
+        parity = exponent & 1;
+        exponent = (exponent - parity) / 2;
+
+        /*  Setting the exponent field to 1023 gives us 1 <= m < 2.           */
+        bits = (bits & 0x000FFFFFFFFFFFFFU) | 0x3FF0000000000000U;
+        std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+        /*  Evaluate the polynomial using Horner's method.                    */
+        guess = a0 + mantissa * (a1 + mantissa * (a2 + mantissa * a3));
+
+        if (parity)
+            guess *= sqrt_two;
+
+        /*  Build 2^k directly from its exponent bits and scale by it.        */
+        bits = static_cast<std::uint64_t>(exponent + 1023) << 52;
+        std::memcpy(&scale, &bits, sizeof(scale));
+        return guess * scale;
+    }
+    /*  End of exponent_seed.                                                 */
+
+    /*  The same for float. A float has 1 sign bit, 8 exponent bits with a    *
+     *  bias of 127, and 23 mantissa bits. The guess is already as good as    *
+     *  for double, so a single iteration gives full single precision.        */
+    static float exponent_seed(float x)
+    {
+        const float a0 = 3.6995638959508337E-01F;
+        const float a1 = 7.8792323343276450E-01F;
+        const float a2 = -1.8274763507828742E-01F;
+        const float a3 = 2.4937426664236362E-02F;
+        const float sqrt_two = 1.4142135623730951E+00F;
+
+        std::uint32_t bits;
+        float mantissa, scale, guess;
+        int exponent, parity;
+
+        std::memcpy(&bits, &x, sizeof(bits));
+        exponent = static_cast<int>((bits >> 23) & 0xFFU);
+
+        /*  Negative numbers, infinity, NaN, zero, and subnormals, exactly as *
+         *  in the double version.                                            */
+        if ((bits >> 31) != 0U || exponent == 0xFF || exponent == 0)
+            return x;
+
+        exponent -= 127;
+        parity = exponent & 1;
+        exponent = (exponent - parity) / 2;
+
+        bits = (bits & 0x007FFFFFU) | 0x3F800000U;
+        std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+        guess = a0 + mantissa * (a1 + mantissa * (a2 + mantissa * a3));
+
+        if (parity)
+            guess *= sqrt_two;
+
+        bits = static_cast<std::uint32_t>(exponent + 127) << 23;
+        std::memcpy(&scale, &bits, sizeof(scale));
+        return guess * scale;
+    }
+    /*  End of exponent_seed.                                                 */
+
+    /*  The same for other types, like long double, whose bit layout differs  *
+     *  between platforms. std::frexp and std::ldexp split x into its         *
+     *  mantissa and exponent for us, which is a little slower.               */
+    template <typename Other>
+    static Other exponent_seed(Other x)
+    {
+        const Other a0 = static_cast<Other>(3.6995638959508337E-01);
+        const Other a1 = static_cast<Other>(7.8792323343276450E-01);
+        const Other a2 = static_cast<Other>(-1.8274763507828742E-01);
+        const Other a3 = static_cast<Other>(2.4937426664236362E-02);
+        const Other sqrt_two = static_cast<Other>(1.4142135623730951E+00);
+
+        Other mantissa, guess;
+        int exponent, parity;
+
+        /*  Negative numbers, infinity, NaN, and zero start at the input.     */
+        if (!(x > 0) || x > std::numeric_limits<Other>::max())
+            return x;
+
+        /*  frexp gives 1/2 <= m < 1, double it to get 1 <= m < 2.            */
+        mantissa = 2 * std::frexp(x, &exponent);
+        exponent -= 1;
+
+        parity = exponent & 1;
+        exponent = (exponent - parity) / 2;
+
+        guess = a0 + mantissa * (a1 + mantissa * (a2 + mantissa * a3));
+
+        if (parity)
+            guess *= sqrt_two;
+
+        return std::ldexp(guess, exponent);
+    }
+    /*  End of exponent_seed.                                                 */
+
+    /*  std::fabs is not constexpr, so it can not be used when computing      *
+     *  values at compile time. The absolute value is easy to write.          */
+    static constexpr Real absolute_value(Real x)
+    {
+        return (x < 0 ? -x : x);
+    }
+    /*  End of absolute_value.                                                */
+
+    /*  Adds a finished call to the statistics. Nothing is done, and the      *
+     *  compiler removes the call entirely, unless statistics are enabled.    *
+     *  Relaxed atomics are enough since the counters are only ever added to, *
+     *  and they are read once all of the work is done.                       */
+    static void record(unsigned int iterations,
+                       unsigned int evaluations,
+                       bool converged)
+    {
+#if defined(SOLVER_STATISTICS)
+
+        /*  A larger cap may be given in the Options. Such calls all go in    *
+         *  the last entry of the histogram.                                  */
+        if (iterations > maximum_number_of_iterations)
+            iterations = maximum_number_of_iterations;
+
+        statistics.histogram[iterations].fetch_add(
+            1UL, std::memory_order_relaxed
+        );
+
+        statistics.evaluations.fetch_add(
+            evaluations, std::memory_order_relaxed
+        );
+
+        if (!converged)
+            statistics.failures.fetch_add(1UL, std::memory_order_relaxed);
+#else
+        static_cast<void>(iterations);
+        static_cast<void>(evaluations);
+        static_cast<void>(converged);
+#endif
+    }
+    /*  End of record.                                                        */
+
+    /*  Passes one iteration to the tracer. As with record, nothing is done,  *
+     *  and the compiler removes the call entirely, unless tracing is         *
+     *  enabled.                                                              */
+    static void trace(unsigned int iteration, Real x, Real residual)
+    {
+#if defined(SOLVER_TRACING)
+        SolverTrace::step("Heron::sqrt", iteration,
+                          static_cast<double>(x),
+                          static_cast<double>(residual));
+#else
+        static_cast<void>(iteration);
+        static_cast<void>(x);
+        static_cast<void>(residual);
+#endif
+    }
+    /*  End of trace.                                                         */
+
+    /*  We want the function visible outside the class. Declare it public.    */
+    public:
+
+        /*  Everything we know about a finished call to detailed_sqrt.        *
+         *  iterations is the number of times Heron's update was applied, and *
+         *  evaluations the number of times the error x - a^2 was computed.   *
+         *  converged is false if we ran out of iterations before the error   *
+         *  dropped below the tolerance, and residual is the final relative   *
+         *  error (x - a^2) / x.                                              */
+        struct Result {
+            Real root;
+            unsigned int iterations;
+            unsigned int evaluations;
+            bool converged;
+            Real residual;
+        };
+
+#if defined(SOLVER_STATISTICS)
+
+        /*  Counters for every call to sqrt and detailed_sqrt. histogram[n]   *
+         *  is the number of calls that took n iterations, and failures the   *
+         *  number of calls that did not converge. The last entry also counts *
+         *  calls that took more, if a larger cap was given in the Options.   *
+         *  The total number of calls is the sum of the histogram.            */
+        struct Statistics {
+            std::atomic<unsigned long int> evaluations;
+            std::atomic<unsigned long int> failures;
+            std::atomic<unsigned long int>
+                histogram[maximum_number_of_iterations + 1U];
+        };
+
+        /*  The counters themselves, shared by all threads.                   */
+        static Statistics statistics;
+
+        /*  Prints the counters to the screen.                                */
+        static void print_statistics(void)
+        {
+            unsigned long int calls = 0UL;
+            unsigned int n;
+
+            for (n = 0U; n <= maximum_number_of_iterations; ++n)
+                calls += statistics.histogram[n].load();
+
+            std::printf("Heron::sqrt calls: %lu, evaluations: %lu, "
+                        "failures: %lu\n",
+                        calls, statistics.evaluations.load(),
+                        statistics.failures.load());
+
+            for (n = 0U; n <= maximum_number_of_iterations; ++n)
+                if (statistics.histogram[n].load() != 0UL)
+                    std::printf("    %2u iterations: %lu\n",
+                                n, statistics.histogram[n].load());
+        }
+        /*  End of print_statistics.                                          */
+
+#endif
+
+        /*  The initial guess used for Heron's method. InputSeed starts at x  *
+         *  itself, which is simple but slow for very large or very small x.  *
+         *  ExponentSeed computes a guess from the bits of x.                 */
+        enum Seed {
+            InputSeed,
+            ExponentSeed
+        };
+
+        /*  When to stop iterating. Relative stops once |x - a^2| is at most  *
+         *  tolerance * x, which gives the same number of correct digits no   *
+         *  matter how big or small x is. Absolute stops once |x - a^2| is at *
+         *  most the tolerance itself.                                        */
+        enum Stopping {
+            Relative,
+            Absolute
+        };
+
+        /*  Settings for Heron's method. Callers who only need a few digits   *
+         *  may raise the tolerance, and save a few iterations.               */
+        struct Options {
+            Real tolerance;
+            unsigned int maximum_number_of_iterations;
+            Stopping stopping;
+        };
+
+        /*  The settings used by sqrt when no Options are given. This is 4x   *
+         *  the epsilon of Real, relative to x, and the usual cap on the      *
+         *  number of iterations. For double the tolerance is 8.88x10^-16,    *
+         *  for float it is 4.77x10^-7. These are constants, so the compiler  *
+         *  folds them into the loop, and the default path costs exactly what *
+         *  it did before there were options.                                 */
+        static constexpr Options default_options(void)
+        {
+            return Options{
+                4 * std::numeric_limits<Real>::epsilon(),
+                maximum_number_of_iterations,
+                Relative
+            };
+        }
+        /*  End of default_options.                                           */
+
+        /*  Computes square roots of positive real numbers via Heron's method.*
+         *  We are declaring this inside of the Heron class, so there should  *
+         *  be no naming conflict with std::sqrt, the standard square root.   */
+        static Real sqrt(Real x)
+        {
+            return sqrt(x, InputSeed);
+        }
+        /*  End of sqrt.                                                      */
+
+        /*  Same as above, but with a choice of initial guess.                */
+        static Real sqrt(Real x, Seed seed)
+        {
+            return detailed_sqrt(x, seed).root;
+        }
+        /*  End of sqrt.                                                      */
+
+        /*  Same as above, with a choice of tolerance and iteration cap.      */
+        static Real sqrt(Real x, Seed seed, const Options &options)
+        {
+            return detailed_sqrt(x, seed, options).root;
+        }
+        /*  End of sqrt.                                                      */
+
+        /*  Computes the square root and reports how the computation went.    *
+         *  The sqrt functions above simply return the root from this. The    *
+         *  extra fields cost nothing there, since the compiler sees that     *
+         *  they are unused and removes them.                                 */
+        static Result detailed_sqrt(Real x, Seed seed = InputSeed)
+        {
+            return detailed_sqrt(x, seed, default_options());
+        }
+        /*  End of detailed_sqrt.                                             */
+
+        /*  Same as above, with a choice of tolerance and iteration cap.      */
+        template <bool Traced = false>
+        static Result
+        detailed_sqrt(Real x, Seed seed, const Options &options)
+        {
+#if defined(SOLVER_TRACING)
+
+            /*  While tracing, the call goes to a copy of this routine with   *
+             *  Traced = true, which has the hooks, out of line. The copy     *
+             *  used while tracing is off has no hooks in its loop at all. A  *
+             *  hook in the loop, even one that is skipped, made the routine  *
+             *  too big for the compiler to inline, and Heron's method then   *
+             *  cost twice as much with tracing off.                          */
+            if (!Traced && SolverTrace::mode() != SolverTrace::Off)
+                return traced_sqrt(x, seed, options);
+#endif
+
+            /*  The smallest positive normal number, 2^-1022 for double, and  *
+             *  the largest finite number.                                    */
+            const Real smallest_normal = std::numeric_limits<Real>::min();
+            const Real largest = std::numeric_limits<Real>::max();
+
+            /*  x is scaled by 2^(2k) below, where 2k is the number of bits   *
+             *  in the mantissa, rounded up to an even number. This is 2^54   *
+             *  for double, and the same rule gives 2^26 for float.           */
+            const int shift = (std::numeric_limits<Real>::digits + 2) / 2;
+
+            /*  Initial guess for the square root, set below.                 */
+            Real approximate_root;
+
+            /*  For subnormal x the square a_n^2 used in the error check      *
+             *  below underflows and loses precision. Scale x up by 2^54,     *
+             *  which is exact, and scale the root back down by 2^27. The     *
+             *  input seed keeps the original behavior and skips this.        */
+            if (seed == ExponentSeed && 0 < x && x < smallest_normal)
+            {
+                const Real up = std::ldexp(static_cast<Real>(1), 2 * shift);
+                const Real down = std::ldexp(static_cast<Real>(1), -shift);
+
+                /*  An absolute tolerance is scaled along with x.             */
+                Options scaled = options;
+
+                if (options.stopping == Absolute)
+                    scaled.tolerance *= up;
+
+                Result result = detailed_sqrt<Traced>(up * x, seed, scaled);
+                result.root *= down;
+                return result;
+            }
+
+            /*  Near the largest number it is the other way around. a_n^2     *
+             *  overflows to infinity, the error check can never pass, and    *
+             *  every iteration is used. Scale x down by 2^-54 and the root   *
+             *  up by 2^27. Below largest / 4 the square of a guess close to  *
+             *  the root is always finite, so only the top two binades are    *
+             *  scaled. Scaling by a power of two is exact, and so are the    *
+             *  roundings of Heron's method, so the result only changes where *
+             *  the square overflowed. Both seeds are scaled, and the batched *
+             *  routine does the same, so that it still agrees with sqrt.     */
+            if (largest / 4 < x && x <= largest)
+            {
+                const Real down = std::ldexp(static_cast<Real>(1), -2 * shift);
+                const Real up = std::ldexp(static_cast<Real>(1), shift);
+                Options scaled = options;
+
+                if (options.stopping == Absolute)
+                    scaled.tolerance *= down;
+
+                Result result = detailed_sqrt<Traced>(down * x, seed, scaled);
+                result.root *= up;
+                return result;
+            }
+
+            /*  Set the initial guess. Provided x is positive, Heron's method *
+             *  will converge for both choices. The exponent seed is already  *
+             *  correct to about 4 decimals, so it needs very few iterations. */
+            if (seed == ExponentSeed)
+                approximate_root = exponent_seed(x);
+            else
+                approximate_root = x;
+
+            return iterate<Traced>(x, approximate_root, options);
+        }
+        /*  End of detailed_sqrt.                                             */
+
+        /*  Same as above, but Heron's method starts at guess, which should   *
+         *  be positive, instead of at a seed computed from x. This is for    *
+         *  callers that already know a good approximation, such as the       *
+         *  Tracker below. Subnormal and very large x are not scaled here,    *
+         *  so their squares underflow or overflow in the error check, and    *
+         *  they should use detailed_sqrt instead.                            */
+        static Result
+        detailed_sqrt_from(Real x, Real guess, const Options &options)
+        {
+#if defined(SOLVER_TRACING)
+
+            /*  See detailed_sqrt for the traced copy.                        */
+            if (SolverTrace::mode() != SolverTrace::Off)
+                return traced_sqrt_from(x, guess, options);
+#endif
+
+            return iterate<false>(x, guess, options);
+        }
+        /*  End of detailed_sqrt_from.                                        */
+
+    private:
+
+        /*  Heron's method, starting at guess, for both routines above. The   *
+         *  hooks for tracing are only in the copy with Traced = true.        */
+        template <bool Traced>
+        static Result iterate(Real x, Real guess, const Options &options)
+        {
+            /*  Heron's update multiplies by one half. Writing 0.5 would make *
+             *  float computations happen in double.                          */
+            const Real half = static_cast<Real>(0.5);
+
+            /*  Variable for keeping track of the number of iterations.       */
+            unsigned int iters;
+
+            /*  The current approximation, starting at the guess.             */
+            Real approximate_root = guess;
+
+            /*  The relative error of the current guess, and the result.      */
+            Real error = 0;
+            Result result;
+
+            /*  Iteratively loop through and obtain better approximations.    */
+            for (iters = 0; iters < options.maximum_number_of_iterations;
+                 ++iters)
+            {
+                /*  If we are within the tolerance of the correct value we    *
+                 *  may break out of this for-loop. By default we check the   *
+                 *  relative error.                                           */
+                const Real difference = x - approximate_root*approximate_root;
+                error = difference / x;
+
+                if (Traced)
+                    trace(iters, approximate_root, error);
+
+                if (options.stopping == Relative)
+                {
+                    if (std::fabs(error) <= options.tolerance)
+                        break;
+                }
+
+                else if (std::fabs(difference) <= options.tolerance)
+                    break;
+
+                /*  Apply Heron's method to get a better approximation.       */
+                approximate_root = half*(approximate_root + x/approximate_root);
+            }
+
+            /*  As long as x is positive and not very large, we should have a *
+             *  very good approximation for sqrt(x). Heron's method will      *
+             *  still work for very large x, but we must increase the value   *
+             *  of maximum_number_of_iterations, or use the exponent seed.    */
+            result.root = approximate_root;
+            result.iterations = iters;
+            result.converged = (iters < options.maximum_number_of_iterations);
+
+            /*  If we ran out of iterations, the error of the last guess was  *
+             *  never computed. Compute it now.                               */
+            if (!result.converged)
+                error = (x - approximate_root*approximate_root) / x;
+
+            result.evaluations = iters + 1U;
+            result.residual = error;
+            record(result.iterations, result.evaluations, result.converged);
+            return result;
+        }
+        /*  End of iterate.                                                   */
+
+#if defined(SOLVER_TRACING)
+
+        /*  The traced calls. These are out of line, so that the code for     *
+         *  tracing does not take up room where the routines are inlined.     *
+         *  The options are passed by value, since a reference would keep the *
+         *  compiler from folding the default options into the inlined copy.  */
+        MITX_TRACE_NOINLINE static Result
+        traced_sqrt(Real x, Seed seed, Options options)
+        {
+            const SolverTrace::Scope scope("Heron::sqrt");
+            return detailed_sqrt<true>(x, seed, options);
+        }
+        /*  End of traced_sqrt.                                               */
+
+        MITX_TRACE_NOINLINE static Result
+        traced_sqrt_from(Real x, Real guess, Options options)
+        {
+            const SolverTrace::Scope scope("Heron::sqrt");
+            return iterate<true>(x, guess, options);
+        }
+        /*  End of traced_sqrt_from.                                          */
+#endif
+
+    public:
+
+        /*  Square roots of a value that changes a little from one call to    *
+         *  the next. A Tracker remembers the last root r, and computes its   *
+         *  guess for sqrt(x) from it, instead of a seed computed from x      *
+         *  alone. With u = (x - r^2) / r^2, the relative change of x,        *
+         *                                                                    *
+         *              sqrt(x) = r sqrt(1 + u) = r (1 + u/2 - u^2/8 + ...),  *
+         *                                                                    *
+         *  and the first three terms are off by about u^3 / 16. For u =      *
+         *  10^-6 this is already below the tolerance, and Heron's method     *
+         *  only has to check it. For u = 10^-4 one step is needed. The       *
+         *  series is only used for |u| <= 1/2, and otherwise the guess is r  *
+         *  itself.                                                           *
+         *                                                                    *
+         *  The first call starts cold, with the exponent seed, and so does   *
+         *  any call for a subnormal, zero, negative, infinite, or NaN x, and *
+         *  any call after one that did not converge. If a warm start runs    *
+         *  out of iterations, because x jumped by many orders of magnitude,  *
+         *  the call is repeated cold, and the evaluations of both attempts   *
+         *  are counted. A Tracker is meant to be used by one thread.         */
+        class Tracker {
+
+            /*  The settings for every call, the last root, and whether the   *
+             *  last call converged, so that its root can be used.            */
+            Options options;
+            Real previous;
+            bool warm;
+
+            /*  We want the functions visible outside the class. Declare them *
+             *  public.                                                       */
+            public:
+
+                /*  Creates a tracker with no previous root.                  */
+                explicit Tracker(const Options &settings = default_options())
+                    : options(settings), previous(0), warm(false)
+                {
+                    return;
+                }
+
+                /*  Computes sqrt(x), starting near the last root if          *
+                 *  possible, and reports how the computation went.           */
+                Result detailed_sqrt(Real x)
+                {
+                    const Real smallest_normal =
+                        std::numeric_limits<Real>::min();
+                    const Real largest = std::numeric_limits<Real>::max();
+
+                    /*  Whether the last root may be used as the guess for x. */
+                    const bool usable =
+                        warm && smallest_normal <= x && x <= largest;
+
+                    Result result;
+
+                    if (usable)
+                    {
+                        const Real square = previous * previous;
+                        const Real u = (x - square) / square;
+                        const Real half = static_cast<Real>(0.5);
+                        const Real eighth = static_cast<Real>(0.125);
+                        Real guess = previous;
+
+                        if (std::fabs(u) <= half)
+                            guess = previous * (1 + u * (half - eighth * u));
+
+                        result = detailed_sqrt_from(x, guess, options);
+                    }
+
+                    /*  Start cold, counting the evaluations of a failed warm *
+                     *  start along with those of the cold one.               */
+                    if (!usable || !result.converged)
+                    {
+                        const unsigned int wasted =
+                            (usable ? result.evaluations : 0U);
+
+                        result = BasicHeron::detailed_sqrt(
+                            x, ExponentSeed, options
+                        );
+
+                        result.evaluations += wasted;
+                    }
+
+                    /*  Only a positive root is a usable starting point.      */
+                    warm = result.converged && result.root > 0;
+                    previous = result.root;
+                    return result;
+                }
+                /*  End of detailed_sqrt.                                     */
+
+                /*  Same as above, returning only the root.                   */
+                Real sqrt(Real x)
+                {
+                    return detailed_sqrt(x).root;
+                }
+                /*  End of sqrt.                                              */
+
+                /*  Forgets the last root, so the next call starts cold.      */
+                void reset(void)
+                {
+                    warm = false;
+                }
+                /*  End of reset.                                             */
+        };
+        /*  End of Tracker definition.                                        */
+
+        /*  Computes out[k] = sqrt(in[k]) for 0 <= k < n. The inputs are      *
+         *  processed several at a time using vector instructions, if the     *
+         *  compiler is targeting AVX, AVX-512, or 64-bit ARM NEON. Whatever  *
+         *  does not fill a whole vector is handled by the scalar routine.    *
+         *  Vectors hold twice as many floats as doubles, and other types are *
+         *  always handled by the scalar routine.                             *
+         *                                                                    *
+         *  Accuracy:                                                         *
+         *      Each lane performs the same IEEE-754 operations, in the same  *
+         *      order, as the scalar sqrt function, and stops on the same     *
+         *      iteration. The results are bit-for-bit identical, provided    *
+         *      the scalar function is not compiled with fused multiply-adds  *
+         *      (GCC does this with -march=native unless -ffp-contract=off is *
+         *      given). If it is, the stopping test may fire one iteration    *
+         *      apart, and the two results differ by at most one ULP since    *
+         *      Heron's method is at its fixed point by then.                 */
+        static void sqrt(const Real * const in,
+                         Real * const out,
+                         std::size_t n)
+        {
+            /*  Handle all of the full blocks of vector-sized data. Index is  *
+             *  where the vector routine stopped.                             */
+            std::size_t index = vector_sqrt(in, out, n);
+
+            /*  Whatever remains is handled one value at a time.              */
+            for (; index < n; ++index)
+                out[index] = sqrt(in[index]);
+        }
+        /*  End of sqrt.                                                      */
+
+        /*  Computes square roots at compile time. When called with a         *
+         *  constant the result is computed by the compiler and folded into   *
+         *  the program, costing nothing at run time. It can still be called  *
+         *  with run-time values, where it acts as an ordinary function. Bit  *
+         *  tricks (memcpy) are not allowed in constant expressions, so we    *
+         *  can not use the exponent seed. Instead, x is multiplied by powers *
+         *  of 4 until 1 <= x < 4. This is exact, and the simple input seed   *
+         *  converges quickly on this interval. The root is then multiplied   *
+         *  by the matching power of 2, which is also exact.                  */
+        static constexpr Real constexpr_sqrt(Real x)
+        {
+            /*  Maximum allowed error. This is 4x the epsilon of Real.        */
+            const Real epsilon = 4 * std::numeric_limits<Real>::epsilon();
+
+            /*  The largest finite value. Anything bigger is infinity.        */
+            const Real largest = std::numeric_limits<Real>::max();
+
+            /*  Constants used below, written in Real so that float does not  *
+             *  get promoted to double.                                       */
+            const Real one = 1;
+            const Real four = 4;
+            const Real quarter = static_cast<Real>(0.25);
+            const Real half = static_cast<Real>(0.5);
+
+            /*  The reduced input, 1 <= y < 4, and the power of two that      *
+             *  undoes the reduction, sqrt(x) = scale * sqrt(y).              */
+            Real y = x;
+            Real scale = one;
+
+            /*  Variable for keeping track of the number of iterations.       */
+            unsigned int iters = 0U;
+
+            /*  Initial guess for sqrt(y), set after reducing x.              */
+            Real approximate_root = 0;
+
+            /*  NaN, zero, and infinity are their own square roots.           */
+            if (x != x || x == 0 || x > largest)
+                return x;
+
+            /*  Negative numbers have no real square root. Return NaN.        */
+            if (x < 0)
+                return std::numeric_limits<Real>::quiet_NaN();
+
+            /*  Reduce to 1 <= y < 4. sqrt(4y) = 2 sqrt(y), so each factor of *
+             *  4 taken from y is a factor of 2 given to the scale.           */
+            while (y >= four)
+            {
+                y *= quarter;
+                scale *= 2;
+            }
+
+            while (y < one)
+            {
+                y *= four;
+                scale *= half;
+            }
+
+            /*  Same iteration as the sqrt function, now on y.                */
+            approximate_root = y;
+
+            for (iters = 0U; iters < maximum_number_of_iterations; ++iters)
+            {
+                const Real error = (y - approximate_root*approximate_root) / y;
+
+                if (absolute_value(error) <= epsilon)
+                    break;
+
+                approximate_root = half*(approximate_root + y/approximate_root);
+            }
+
+            return scale * approximate_root;
+        }
+        /*  End of constexpr_sqrt.                                            */
+};
+/*  End of BasicHeron definition.                                             */
+
+/*  Most code wants double. Heron::sqrt(x) is shorter than writing            *
+ *  BasicHeron<double>::sqrt(x) every time.                                   */
+typedef BasicHeron<double> Heron;
+
+/*  The counters are static members of the class, and need a definition.      *
+ *  Static storage starts out zero, so they all begin at zero.                */
+#if defined(SOLVER_STATISTICS)
+template <typename Real>
+typename BasicHeron<Real>::Statistics BasicHeron<Real>::statistics;
+#endif
+
+#endif
+/*  End of include guard.                                                     */